@@ -0,0 +1,41 @@
+//
+//  RNFSTurboBuffer.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <jsi/jsi.h>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+using namespace facebook;
+
+// Native memory handed to JS as an ArrayBuffer without an extra copy
+class RNFSTurboBuffer : public jsi::MutableBuffer {
+public:
+  explicit RNFSTurboBuffer(size_t size) : buffer(size) {}
+  explicit RNFSTurboBuffer(std::vector<uint8_t>&& data) : buffer(std::move(data)) {}
+
+  size_t size() const override {
+    return buffer.size();
+  }
+
+  uint8_t* data() override {
+    return buffer.data();
+  }
+
+  template <typename T>
+  T* as() {
+    return reinterpret_cast<T*>(buffer.data());
+  }
+
+private:
+  std::vector<uint8_t> buffer;
+};
+
+}
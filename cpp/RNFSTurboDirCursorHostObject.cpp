@@ -0,0 +1,82 @@
+//
+//  RNFSTurboDirCursorHostObject.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include "RNFSTurboDirCursorHostObject.h"
+#include "RNFSTurboLogger.h"
+
+namespace cmpayc::rnfsturbo {
+
+using namespace facebook;
+
+// Page size of next() without arguments
+static constexpr size_t kDefaultPageSize = 100;
+
+jsi::Array createDirItems(jsi::Runtime& runtime, const RNFSTurboPropNames& names, const std::vector<WalkEntry>& entries) {
+  jsi::Array items = jsi::Array(runtime, entries.size());
+  for (size_t i = 0; i < entries.size(); i++) {
+    const WalkEntry& entry = entries[i];
+    jsi::Object item = jsi::Object(runtime);
+    item.setProperty(runtime, names[PropKey::Name], jsi::String::createFromUtf8(runtime, entry.path.substr(entry.nameOffset)));
+    item.setProperty(runtime, names[PropKey::Path], jsi::String::createFromUtf8(runtime, entry.path));
+    item.setProperty(runtime, names[PropKey::Size], jsi::Value(entry.size));
+    item.setProperty(runtime, names[PropKey::Mtime], jsi::Value(entry.mtime));
+    item.setProperty(runtime, names[PropKey::IsFile], jsi::Value(entry.isFile));
+    item.setProperty(runtime, names[PropKey::IsDirectory], jsi::Value(entry.isDirectory));
+    items.setValueAtIndex(runtime, i, std::move(item));
+  }
+  return items;
+}
+
+RNFSTurboDirCursorHostObject::RNFSTurboDirCursorHostObject(std::unique_ptr<DirCursor> cursor, std::shared_ptr<RNFSTurboPropNames> propNames)
+  : cursor(std::move(cursor)), propNames(std::move(propNames)) {}
+
+std::vector<jsi::PropNameID> RNFSTurboDirCursorHostObject::getPropertyNames(jsi::Runtime& rt) {
+  std::vector<jsi::PropNameID> names;
+  names.push_back(jsi::PropNameID::forAscii(rt, "next"));
+  names.push_back(jsi::PropNameID::forAscii(rt, "close"));
+  return names;
+}
+
+jsi::Value RNFSTurboDirCursorHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& propNameId) {
+  std::string propName = propNameId.utf8(runtime);
+
+  // Created on every access, jsi values can't be kept in a host object (see RNFSTurboHostObject::get)
+  if (propName == "next") {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [cursor = cursor, propNames = propNames](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count > 1) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "next", "Too many arguments"));
+        }
+        size_t pageSize = kDefaultPageSize;
+        if (count == 1 && arguments[0].isNumber()) {
+          if (arguments[0].asNumber() < 1) [[unlikely]] {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "next", "First argument ('count') has to be a positive number"));
+          }
+          pageSize = static_cast<size_t>(arguments[0].asNumber());
+        }
+
+        return createDirItems(runtime, *propNames, cursor->next(pageSize));
+      }
+    );
+  }
+  if (propName == "close") {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      0,
+      [cursor = cursor](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        cursor->close();
+        return jsi::Value::undefined();
+      }
+    );
+  }
+
+  return jsi::Value::undefined();
+}
+
+}
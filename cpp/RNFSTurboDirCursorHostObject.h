@@ -0,0 +1,41 @@
+//
+//  RNFSTurboDirCursorHostObject.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <jsi/jsi.h>
+#include <memory>
+#include <string>
+#include <vector>
+#include "filesystem/dir-cursor.h"
+#include "filesystem/walk-utils.h"
+#include "RNFSTurboPropNames.h"
+
+namespace cmpayc::rnfsturbo {
+
+using namespace facebook;
+
+// Item objects returned by walk and openDir
+jsi::Array createDirItems(jsi::Runtime& runtime, const RNFSTurboPropNames& names, const std::vector<WalkEntry>& entries);
+
+// JS side of a DirCursor returned by openDir, the directory is closed by close() or on GC.
+// next and close share the cursor, so they stay usable when kept after the object is collected,
+// the directory is then closed once they are collected too.
+class RNFSTurboDirCursorHostObject : public jsi::HostObject {
+public:
+  RNFSTurboDirCursorHostObject(std::unique_ptr<DirCursor> cursor, std::shared_ptr<RNFSTurboPropNames> propNames);
+
+public:
+  jsi::Value get(jsi::Runtime&, const jsi::PropNameID& name) override;
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override;
+
+private:
+  std::shared_ptr<DirCursor> cursor;
+  std::shared_ptr<RNFSTurboPropNames> propNames;
+};
+
+}
@@ -12,6 +12,188 @@ namespace cmpayc::rnfsturbo {
 
 using namespace facebook;
 namespace fs = std::filesystem;
+
+// How often long copies call the JS progress callback
+static constexpr int kCopyProgressIntervalMs = 100;
+
+// Runs a copy job, reporting {bytesCopied, totalBytes} to the optional JS progress callback
+static void runCopyJob(
+  jsi::Runtime& runtime,
+  const RNFSTurboPropNames& names,
+  std::optional<jsi::Function>& progressFunc,
+  const std::function<void(CopyProgress&)>& job
+) {
+  if (!progressFunc.has_value()) {
+    CopyProgress progress;
+    job(progress);
+    return;
+  }
+  runWithProgress(
+    job,
+    [&runtime, &names, &progressFunc](uint64_t bytesCopied, uint64_t totalBytes) {
+      jsi::Object result = jsi::Object(runtime);
+      result.setProperty(runtime, names[PropKey::BytesCopied], jsi::Value(static_cast<double>(bytesCopied)));
+      result.setProperty(runtime, names[PropKey::TotalBytes], jsi::Value(static_cast<double>(totalBytes)));
+      progressFunc->call(runtime, std::move(result));
+    },
+    kCopyProgressIntervalMs
+  );
+}
+
+static std::optional<jsi::Function> getProgressOption(jsi::Runtime& runtime, const jsi::Object& optionsObject, const RNFSTurboPropNames& names) {
+  auto progressOption = optionsObject.getProperty(runtime, names[PropKey::Progress]);
+  if (progressOption.isObject() && progressOption.asObject(runtime).isFunction(runtime)) {
+    return progressOption.asObject(runtime).asFunction(runtime);
+  }
+  return std::nullopt;
+}
+
+static std::vector<std::string> getPathsArgument(jsi::Runtime& runtime, const jsi::Array& pathsArray, const std::string& propName) {
+  size_t len = pathsArray.size(runtime);
+  std::vector<std::string> paths;
+  paths.reserve(len);
+  for (size_t i = 0; i < len; i++) {
+    jsi::Value item = pathsArray.getValueAtIndex(runtime, i);
+    if (!item.isString()) [[unlikely]] {
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Each path has to be of type string"));
+    }
+    paths.push_back(cleanPath(item.asString(runtime).utf8(runtime)));
+  }
+  return paths;
+}
+// Builds the stages of pipeline() from [{type, ...options}]
+static std::vector<std::unique_ptr<TransformStage>> getPipelineStages(
+  jsi::Runtime& runtime,
+  const RNFSTurboPropNames& names,
+  const jsi::Array& stagesArray
+) {
+  std::vector<std::unique_ptr<TransformStage>> stages;
+  size_t len = stagesArray.size(runtime);
+  stages.reserve(len);
+  for (size_t i = 0; i < len; i++) {
+    jsi::Value item = stagesArray.getValueAtIndex(runtime, i);
+    if (!item.isObject()) [[unlikely]] {
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "pipeline", "Each stage has to be of type object"));
+    }
+    jsi::Object stageObject = item.asObject(runtime);
+    jsi::Value typeOption = stageObject.getProperty(runtime, names[PropKey::Type]);
+    std::string type = typeOption.isString() ? typeOption.asString(runtime).utf8(runtime) : "";
+    if (type == "gunzip") {
+      stages.push_back(std::make_unique<GunzipStage>());
+    } else if (type == "base64decode") {
+      stages.push_back(std::make_unique<Base64DecodeStage>());
+    } else if (type == "hash") {
+      jsi::Value algorithmOption = stageObject.getProperty(runtime, names[PropKey::Algorithm]);
+      std::string algorithm = algorithmOption.isString() ? algorithmOption.asString(runtime).utf8(runtime) : "";
+      std::unique_ptr<Hasher> hasher = Hasher::create(algorithm);
+      if (hasher == nullptr) {
+        throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "pipeline", "Wrong algorithm", algorithm.c_str()));
+      }
+      stages.push_back(std::make_unique<HashStage>(std::move(hasher)));
+    } else if (type == "decrypt") {
+#ifdef RNFSTURBO_USE_ENCRYPTION
+      bool encrypted{false};
+      int passphraseLength{0};
+      int ivLength{0};
+      std::vector<unsigned char> passphrase;
+      std::vector<unsigned char> iv;
+      std::string mode{"ecb"};
+      std::string padding{"pkcs5/pkcs7"};
+      bool mac{true};
+      processEncryptionOptions(runtime, "pipeline", names, stageObject, encrypted, passphraseLength, passphrase, ivLength, iv, mode, padding, mac);
+      if (passphraseLength != 16 && passphraseLength != 24 && passphraseLength != 32) {
+        throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "pipeline", "Passphrase length should be 16, 24 or 32"));
+      }
+      auto cipher = createCipherMode(runtime, "pipeline", mode, padding, passphrase.data(), passphrase.size());
+      stages.push_back(std::make_unique<DecryptStage>(std::move(cipher), iv));
+#else
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "pipeline", "Encryption is disabled"));
+#endif
+    } else {
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "pipeline", "Wrong stage type", type.c_str()));
+    }
+  }
+  return stages;
+}
+
+static jsi::Object createPipelineResult(jsi::Runtime& runtime, const RNFSTurboPropNames& names, const PipelineResult& pipelineResult) {
+  jsi::Object result = jsi::Object(runtime);
+  result.setProperty(runtime, names[PropKey::BytesRead], jsi::Value(static_cast<double>(pipelineResult.bytesRead)));
+  result.setProperty(runtime, names[PropKey::BytesWritten], jsi::Value(static_cast<double>(pipelineResult.bytesWritten)));
+  jsi::Array digests = jsi::Array(runtime, pipelineResult.digests.size());
+  for (size_t i = 0; i < pipelineResult.digests.size(); i++) {
+    digests.setValueAtIndex(runtime, i, jsi::String::createFromUtf8(runtime, pipelineResult.digests[i]));
+  }
+  result.setProperty(runtime, names[PropKey::Digests], std::move(digests));
+  return result;
+}
+
+// Bytes of a string (UTF-8, kept in stringStorage) or ArrayBuffer argument, without a copy.
+// They are only valid while the argument is alive, background jobs have to copy them
+static std::pair<const uint8_t*, size_t> getDataArgument(
+  jsi::Runtime& runtime,
+  const jsi::Value& value,
+  const std::string& propName,
+  std::string& stringStorage
+) {
+  if (value.isString()) {
+    stringStorage = value.asString(runtime).utf8(runtime);
+    return {reinterpret_cast<const uint8_t*>(stringStorage.data()), stringStorage.size()};
+  }
+  if (value.isObject() && value.asObject(runtime).isArrayBuffer(runtime)) {
+    jsi::ArrayBuffer arrayBuffer = value.asObject(runtime).getArrayBuffer(runtime);
+    return {arrayBuffer.data(runtime), arrayBuffer.size(runtime)};
+  }
+  throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "First argument ('data') has to be of type string or ArrayBuffer"));
+}
+
+// Result of chunkManifest, the chunk digests stay raw bytes in one ArrayBuffer
+static jsi::Object createChunkManifestResult(jsi::Runtime& runtime, const RNFSTurboPropNames& names, ChunkManifest&& manifest, uint64_t chunkSize) {
+  jsi::Object result = jsi::Object(runtime);
+  result.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(manifest.size)));
+  result.setProperty(runtime, names[PropKey::ChunkSize], jsi::Value(static_cast<double>(chunkSize)));
+  result.setProperty(runtime, names[PropKey::Digest], jsi::String::createFromUtf8(runtime, toHex(manifest.fileDigest.data(), manifest.fileDigest.size())));
+  result.setProperty(runtime, names[PropKey::Digests], jsi::ArrayBuffer(runtime, std::make_shared<RNFSTurboBuffer>(std::move(manifest.chunkDigests))));
+  return result;
+}
+
+#ifdef RNFSTURBO_USE_ENCRYPTION
+// Result of decryptData, a string for the utf8 and base64 encodings and an ArrayBuffer otherwise
+static jsi::Value createDataResult(jsi::Runtime& runtime, std::vector<uint8_t>&& bytes, const std::string& encoding) {
+  if (encoding == "utf8") {
+    return jsi::String::createFromUtf8(runtime, bytes.data(), bytes.size());
+  }
+  if (encoding == "base64") {
+    return jsi::String::createFromUtf8(runtime, base64::to_base64(std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size())));
+  }
+  return jsi::ArrayBuffer(runtime, std::make_shared<RNFSTurboBuffer>(std::move(bytes)));
+}
+
+// Cipher of encryptData and decryptData, chunked is a file format and isn't available here
+static std::shared_ptr<Mode::MODE> getDataCipher(
+  jsi::Runtime& runtime,
+  const RNFSTurboPropNames& names,
+  const std::string& propName,
+  jsi::Object& optionsObject,
+  std::vector<unsigned char>& iv
+) {
+  bool encrypted{true};
+  int passphraseLength{0};
+  int ivLength{0};
+  std::vector<unsigned char> passphrase;
+  std::string mode{"ecb"};
+  std::string padding{"pkcs5/pkcs7"};
+  bool mac{true};
+  processEncryptionOptions(runtime, propName, names, optionsObject, encrypted, passphraseLength, passphrase, ivLength, iv, mode, padding, mac);
+  if (passphraseLength == 0) {
+    throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Passphrase is required for encryption"));
+  }
+  if (mode == "chunked") {
+    throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Only ecb, cbc and cfb modes allowed"));
+  }
+  return createCipherMode(runtime, propName, mode, padding, passphrase.data(), passphrase.size());
+}
+#endif
  
 RNFSTurboHostObject::RNFSTurboHostObject(std::shared_ptr<react::CallInvoker> jsInvoker) {
   RNFSTurboLogger::log("RNFSTurbo", "Initializing RNFSTurbo");
@@ -27,20 +209,39 @@ RNFSTurboHostObject::RNFSTurboHostObject(std::shared_ptr<react::CallInvoker> jsI
 }
 
 RNFSTurboHostObject::~RNFSTurboHostObject() {
+  watchers.clear();
+  statCacheWatchers.clear();
   delete platformHelper;
   platformHelper = nullptr;
 }
 
 std::vector<jsi::PropNameID> RNFSTurboHostObject::getPropertyNames(jsi::Runtime& rt) {
-  return jsi::PropNameID::names(rt, "readDir", "readDirAssets", "readdir", "stat", "readFile", "read", "readFileAssets", "readFileRes", "writeFile", "appendFile", "write", "moveFile", "copyFolder", "copyFile", "copyFileAssets", "copyFileRes", "copyAssetsFileIOS", "copyAssetsVideoIOS", "unlink" "exists", "existsAssets", "existsRes", "hash", "touch", "mkdir", "downloadFile", "stopDownload", "resumeDownload", "isResumable", "completeHandlerIOS", "uploadFiles", "stopUpload", "getFSInfo", "scanFile", "getAllExternalFilesDirs", "pathForGroup");
+  std::vector<jsi::PropNameID> names;
+  names.reserve(kRNFSTurboMethodCount);
+  for (std::string_view name : kRNFSTurboMethodNames) {
+    names.push_back(jsi::PropNameID::forAscii(rt, name.data(), name.size()));
+  }
+  return names;
 }
 
 jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& propNameId) {
   std::string propName = propNameId.utf8(runtime);
+  RNFSTurboMethod method = methodFromName(propName);
+  if (method == RNFSTurboMethod::Unknown) [[unlikely]] {
+    return jsi::Value::undefined();
+  }
+
+  // Functions aren't kept here: the runtime may destroy this object after it has gone itself,
+  // and a jsi::Function member would then be released into a dead runtime. RNFSTurbo.ts caches them.
+  RNFSTurboLogger::log("RNFSTurbo", "create func %s...", propName.c_str());
+  if (propNames == nullptr) [[unlikely]] {
+    propNames = std::make_shared<RNFSTurboPropNames>(runtime);
+  }
+  return createHostFunction(runtime, method, propName);
+}
 
-  RNFSTurboLogger::log("RNFSTurbo", "call func %s...", propName.c_str());
-  
-  if (propName == "stat") {
+jsi::Function RNFSTurboHostObject::createHostFunction(jsi::Runtime& runtime, RNFSTurboMethod method, const std::string& propName) {
+  if (method == RNFSTurboMethod::Stat) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -60,22 +261,24 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         }
 
         struct stat t_stat;
-        int res = stat(filePath.c_str(), &t_stat);
-        if (res < 0) {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "stat", strerror(errno)));
+        int error = statCache.stat(filePath, t_stat);
+        if (error != 0) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "stat", strerror(error)));
         }
 
+        const RNFSTurboPropNames& names = *propNames;
         jsi::Object obj = jsi::Object(runtime);
-        obj.setProperty(runtime, "path", jsi::String::createFromUtf8(runtime, filePath));
-        obj.setProperty(runtime, "ctime", jsi::Value(static_cast<float>(t_stat.st_ctime)));
-        obj.setProperty(runtime, "mtime", jsi::Value(static_cast<float>(t_stat.st_mtime)));
-        obj.setProperty(runtime, "size", jsi::Value(static_cast<float>(t_stat.st_size)));
-        obj.setProperty(runtime, "mode", jsi::Value(static_cast<int>(t_stat.st_mode)));
-        obj.setProperty(runtime, "originalFilepath", jsi::String::createFromUtf8(runtime, filePath));
+        jsi::String jsFilePath = jsi::String::createFromUtf8(runtime, filePath);
+        obj.setProperty(runtime, names[PropKey::Path], jsi::Value(runtime, jsFilePath));
+        obj.setProperty(runtime, names[PropKey::Ctime], jsi::Value(static_cast<float>(t_stat.st_ctime)));
+        obj.setProperty(runtime, names[PropKey::Mtime], jsi::Value(static_cast<float>(t_stat.st_mtime)));
+        obj.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<float>(t_stat.st_size)));
+        obj.setProperty(runtime, names[PropKey::Mode], jsi::Value(static_cast<int>(t_stat.st_mode)));
+        obj.setProperty(runtime, names[PropKey::OriginalFilepath], std::move(jsFilePath));
         if (isNewFormat) {
-          obj.setProperty(runtime, "isDirectory", jsi::Value(static_cast<bool>(t_stat.st_mode & S_IFDIR)));
+          obj.setProperty(runtime, names[PropKey::IsDirectory], jsi::Value(static_cast<bool>(t_stat.st_mode & S_IFDIR)));
         } else {
-          obj.setProperty(runtime, "isDirectory", jsi::Function::createFromHostFunction(
+          obj.setProperty(runtime, names[PropKey::IsDirectory], jsi::Function::createFromHostFunction(
             runtime,
             jsi::PropNameID::forAscii(runtime, "isDirectory"),
             0,
@@ -85,9 +288,9 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
           ));
         }
         if (isNewFormat) {
-          obj.setProperty(runtime, "isFile", jsi::Value(static_cast<bool>(t_stat.st_mode & S_IFREG)));
+          obj.setProperty(runtime, names[PropKey::IsFile], jsi::Value(static_cast<bool>(t_stat.st_mode & S_IFREG)));
         } else {
-          obj.setProperty(runtime, "isFile", jsi::Function::createFromHostFunction(
+          obj.setProperty(runtime, names[PropKey::IsFile], jsi::Function::createFromHostFunction(
             runtime,
             jsi::PropNameID::forAscii(runtime, "isFile"),
             0,
@@ -101,13 +304,13 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "readDir" || propName == "readDirAssets" || propName == "readdir") {
+  if (method == RNFSTurboMethod::ReadDir || method == RNFSTurboMethod::ReadDirAssets || method == RNFSTurboMethod::Readdir) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
-      [this, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+      [this, method, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
 #ifndef __ANDROID__
-        if (propName == "readDirAssets") {
+        if (method == RNFSTurboMethod::ReadDirAssets) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "readDirAssets", "Command only for Android"));
         }
 #endif
@@ -117,7 +320,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         if (count > 2) [[unlikely]] {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Too many arguments"));
         }
-        bool isAndroidAssets = propName == "readDirAssets";
+        bool isAndroidAssets = method == RNFSTurboMethod::ReadDirAssets;
 
         std::string dirPath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
         bool isNewFormat{false};
@@ -176,7 +379,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
               continue;
             }
           }
-          if (propName == "readdir") {
+          if (method == RNFSTurboMethod::Readdir) {
             arr.setValueAtIndex(
               runtime,
               len,
@@ -191,40 +394,41 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
               absolutePath.append(dent->d_name);
               stat(absolutePath.c_str(), &t_stat);
             }
+            const RNFSTurboPropNames& names = *propNames;
             jsi::Object obj = jsi::Object(runtime);
-            obj.setProperty(runtime, "path", jsi::String::createFromUtf8(runtime, absolutePath));
+            obj.setProperty(runtime, names[PropKey::Path], jsi::String::createFromUtf8(runtime, absolutePath));
             obj.setProperty(
               runtime,
-              "ctime",
+              names[PropKey::Ctime],
               jsi::Value(static_cast<float>(isAndroidAssets ? 0 : t_stat.st_ctime))
             );
             obj.setProperty(
               runtime,
-              "mtime",
+              names[PropKey::Mtime],
               jsi::Value(static_cast<float>(isAndroidAssets ? 0 : t_stat.st_mtime))
             );
             obj.setProperty(
               runtime,
-              "size",
+              names[PropKey::Size],
               jsi::Value(static_cast<float>(isAndroidAssets ? assetsDirItemsIt->size : t_stat.st_size))
             );
             if (isNewFormat) {
               obj.setProperty(
                 runtime,
-                "mode",
+                names[PropKey::Mode],
                 jsi::Value(static_cast<int>(isAndroidAssets ? 0 : t_stat.st_mode))
               );
             }
             obj.setProperty(
               runtime,
-              "name",
+              names[PropKey::Name],
               jsi::String::createFromUtf8(runtime, isAndroidAssets ? assetsDirItemsIt->name : dent->d_name)
             );
             bool isDirectory = isAndroidAssets ? assetsDirItemsIt->isDirectory : static_cast<bool>(t_stat.st_mode & S_IFDIR);
             if (isNewFormat) {
-              obj.setProperty(runtime, "isDirectory", jsi::Value(isDirectory));
+              obj.setProperty(runtime, names[PropKey::IsDirectory], jsi::Value(isDirectory));
             } else {
-              obj.setProperty(runtime, "isDirectory", jsi::Function::createFromHostFunction(
+              obj.setProperty(runtime, names[PropKey::IsDirectory], jsi::Function::createFromHostFunction(
                 runtime,
                 jsi::PropNameID::forAscii(runtime, "isDirectory"),
                 0,
@@ -235,9 +439,9 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
             }
             bool isFile = isAndroidAssets ? !assetsDirItemsIt->isDirectory : static_cast<bool>(t_stat.st_mode & S_IFREG);
             if (isNewFormat) {
-              obj.setProperty(runtime, "isFile", jsi::Value(isFile));
+              obj.setProperty(runtime, names[PropKey::IsFile], jsi::Value(isFile));
             } else {
-              obj.setProperty(runtime, "isFile", jsi::Function::createFromHostFunction(
+              obj.setProperty(runtime, names[PropKey::IsFile], jsi::Function::createFromHostFunction(
                 runtime,
                 jsi::PropNameID::forAscii(runtime, "isFile"),
                 0,
@@ -254,7 +458,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
           }
           len++;
         }
-        if (propName != "readDirAssets") {
+        if (method != RNFSTurboMethod::ReadDirAssets) {
           closedir(dir);
         }
 
@@ -262,33 +466,33 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "readFile" || propName == "readFileAssets" || propName == "readFileRes" || propName == "read") {
+  if (method == RNFSTurboMethod::ReadFile || method == RNFSTurboMethod::ReadFileAssets || method == RNFSTurboMethod::ReadFileRes || method == RNFSTurboMethod::Read) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
-      [this, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+      [this, method, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
 #ifndef __ANDROID__
-        if (propName == "readFileAssets" || propName == "readFileRes") {
+        if (method == RNFSTurboMethod::ReadFileAssets || method == RNFSTurboMethod::ReadFileRes) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Command only for Android"));
         }
 #endif
         if (count < 1 || !arguments[0].isString()) [[unlikely]] {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "First argument ('filepath') has to be of type string"));
         }
-        if ((propName == "read" && count > 4) || (propName != "read" && count > 2)) [[unlikely]] {
+        if ((method == RNFSTurboMethod::Read && count > 4) || (method != RNFSTurboMethod::Read && count > 2)) [[unlikely]] {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Too many arguments"));
         }
 
         std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
         long length{0};
-        if (propName == "read" && count > 1 && arguments[1].isNumber()) {
+        if (method == RNFSTurboMethod::Read && count > 1 && arguments[1].isNumber()) {
           length = arguments[1].asNumber();
         }
         long offset{0};
-        if (propName == "read" && count > 2 && arguments[2].isNumber()) {
+        if (method == RNFSTurboMethod::Read && count > 2 && arguments[2].isNumber()) {
           offset = arguments[2].asNumber();
         }
-        std::string encoding{"utf8"};
+        std::string encodingName{"utf8"};
 #ifdef RNFSTURBO_USE_ENCRYPTION
         bool encrypted{false};
         int passphraseLength{0};
@@ -297,34 +501,53 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         std::vector<unsigned char> iv;
         std::string mode{"ecb"};
         std::string padding{"pkcs5/pkcs7"};
+        bool mac{true};
 #endif
         int optionsIndex{-1};
         bool optionsIsObject{false};
-        if (propName == "read" && count == 4 && arguments[3].isString()) {
+        bool uncached{false};
+        Compression compression{Compression::None};
+        if (method == RNFSTurboMethod::Read && count == 4 && arguments[3].isString()) {
           optionsIndex = 3;
-        } else if (propName != "read" && count == 2 && arguments[1].isString()) {
+        } else if (method != RNFSTurboMethod::Read && count == 2 && arguments[1].isString()) {
           optionsIndex = 1;
-        } else if (propName == "read" && count == 4 && arguments[3].isObject()) {
+        } else if (method == RNFSTurboMethod::Read && count == 4 && arguments[3].isObject()) {
           optionsIndex = 3;
           optionsIsObject = true;
-        } else if (propName != "read" && count == 2 && arguments[1].isObject()) {
+        } else if (method != RNFSTurboMethod::Read && count == 2 && arguments[1].isObject()) {
           optionsIndex = 1;
           optionsIsObject = true;
         }
         if (optionsIndex > -1 && !optionsIsObject) {
-          encoding = arguments[optionsIndex].asString(runtime).utf8(runtime);
+          encodingName = arguments[optionsIndex].asString(runtime).utf8(runtime);
         } else if (optionsIndex > -1 && optionsIsObject) {
           auto optionsObject = arguments[optionsIndex].asObject(runtime);
-          if (optionsObject.hasProperty(runtime, "encoding")) {
-            auto encodingOption = optionsObject.getProperty(runtime, "encoding");
-            if (encodingOption.isString()) {
-              encoding = encodingOption.asString(runtime).utf8(runtime);
+          auto encodingOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Encoding]);
+          if (encodingOption.isString()) {
+            encodingName = encodingOption.asString(runtime).utf8(runtime);
+          }
+          auto uncachedOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Uncached]);
+          if (uncachedOption.isBool()) {
+            uncached = uncachedOption.asBool();
+          }
+          auto compressionOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Compression]);
+          if (compressionOption.isString()) {
+            std::string compressionName = compressionOption.asString(runtime).utf8(runtime);
+            std::optional<Compression> parsedCompression = parseCompression(compressionName);
+            if (!parsedCompression.has_value()) {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", propName.c_str(), "Wrong compression", compressionName.c_str()));
             }
+            // Only the lz4 block format can be read partially
+            if (method != RNFSTurboMethod::ReadFile && !(method == RNFSTurboMethod::Read && parsedCompression.value() == Compression::Lz4)) {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Compression is only available for the readFile, writeFile and appendFile methods"));
+            }
+            compression = parsedCompression.value();
           }
 #ifdef RNFSTURBO_USE_ENCRYPTION
           processEncryptionOptions(
             runtime,
             propName,
+            *propNames,
             optionsObject,
             encrypted,
             passphraseLength,
@@ -332,40 +555,43 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
             ivLength,
             iv,
             mode,
-            padding
+            padding,
+            mac
           );
 #endif
         }
-        if (
-          encoding != "utf8" &&
-          encoding != "base64" &&
-          encoding != "uint8" &&
-          encoding != "uint16" &&
-          encoding != "uint32" &&
-          encoding != "float32" &&
-          encoding != "ascii"
-        ) {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", propName.c_str(), "Wrong encoding", encoding.c_str()));
+        std::optional<Encoding> parsedEncoding = parseEncoding(encodingName);
+        if (!parsedEncoding.has_value()) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", propName.c_str(), "Wrong encoding", encodingName.c_str()));
         }
+        Encoding encoding = parsedEncoding.value();
 #ifdef RNFSTURBO_USE_ENCRYPTION
         if (encrypted && passphraseLength == 0) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Passphrase is required for encryption"));
         }
+        if (encrypted && compression != Compression::None) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Compression can't be combined with encryption"));
+        }
 #endif
+        if (compression != Compression::None && isNumericEncoding(encoding)) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Compression is only available for utf8, ascii and base64 encodings"));
+        }
 
         try {
-          if (propName == "readFileAssets" || propName == "readFileRes") {
+          if (method == RNFSTurboMethod::ReadFileAssets || method == RNFSTurboMethod::ReadFileRes) {
 #ifdef __ANDROID__
-            std::string resultString = platformHelper->readFileAssetsOrRes(filePath.c_str(), propName == "readFileRes");
-            return encoding == "ascii"
+            std::string resultString = platformHelper->readFileAssetsOrRes(filePath.c_str(), method == RNFSTurboMethod::ReadFileRes);
+            return encoding == Encoding::Ascii
               ? jsi::String::createFromAscii(runtime, resultString)
               : jsi::String::createFromUtf8(
                   runtime,
-                  encoding == "base64" ? base64::to_base64(resultString) : resultString
+                  encoding == Encoding::Base64 ? base64::to_base64(resultString) : resultString
               );
 #endif
           } else {
-            if (encoding == "uint8" || encoding == "uint16" || encoding == "uint32") {
+            // One-shot reads of large files shouldn't stay in the page cache
+            ScopedEvict evict(filePath, uncached);
+            if (encoding == Encoding::Uint8 || encoding == Encoding::Uint16 || encoding == Encoding::Uint32) {
               FileBuffer buffer = readFileUintUniversal(encoding, filePath.c_str(), (int)offset, (int)length);
               jsi::Array res = std::visit([&](auto&& vec) -> jsi::Array {
                 jsi::Array arr(runtime, vec.size());
@@ -379,7 +605,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
                 return arr;
               }, buffer);
               return res;
-            } else if (encoding == "float32") {
+            } else if (encoding == Encoding::Float32) {
               std::vector<float> buffer = readFileFloat32(filePath.c_str(), (int)offset, (int)length);
               jsi::Array res = jsi::Array(runtime, buffer.size());
               int len = 0;
@@ -393,7 +619,26 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
               }
               return res;
             } else {
-              std::string buffer = readFile(filePath.c_str(), (int)offset, (int)length);
+#ifdef RNFSTURBO_USE_ENCRYPTION
+              // Only the chunks covering the range are read and decrypted
+              if (encrypted && mode == "chunked") {
+                std::string decryptedContent = readChunkedEncryptedFile(
+                  filePath.c_str(),
+                  passphrase,
+                  static_cast<uint64_t>(std::max<long>(offset, 0)),
+                  static_cast<uint64_t>(std::max<long>(length, 0))
+                );
+                return encoding == Encoding::Ascii
+                  ? jsi::String::createFromAscii(runtime, decryptedContent)
+                  : jsi::String::createFromUtf8(
+                      runtime,
+                      encoding == Encoding::Base64 ? base64::to_base64(decryptedContent) : decryptedContent
+                  );
+              }
+#endif
+              std::string buffer = compression == Compression::None
+                ? readFile(filePath.c_str(), (int)offset, (int)length)
+                : readFileCompressed(filePath.c_str(), compression, offset, length);
 #ifdef RNFSTURBO_USE_ENCRYPTION
               if (encrypted) {
                 auto krypt = createCipherMode(
@@ -404,33 +649,21 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
                   passphrase.data(),
                   passphrase.size()
                 );
-                ByteArray decryptedBytes = krypt->decrypt(
+                // Decrypted in the read buffer, the padding is cut off
+                size_t decryptedLength = krypt->decryptInPlace(
                   reinterpret_cast<unsigned char*>(buffer.data()),
                   buffer.size(),
                   iv.data()
                 );
-
-                std::string decryptedContent(
-                  reinterpret_cast<const char*>(decryptedBytes.array),
-                  decryptedBytes.length
-                );
-                return encoding == "ascii"
-                  ? jsi::String::createFromAscii(runtime, decryptedContent)
-                  : jsi::String::createFromUtf8(
-                      runtime,
-                      encoding == "base64" ? base64::to_base64(decryptedContent) : decryptedContent
-                  );
-              } else {
-#endif
-                return encoding == "ascii"
-                  ? jsi::String::createFromAscii(runtime, buffer)
-                  : jsi::String::createFromUtf8(
-                      runtime,
-                      encoding == "base64" ? base64::to_base64(buffer) : buffer
-                  );
-#ifdef RNFSTURBO_USE_ENCRYPTION
+                buffer.resize(decryptedLength);
               }
 #endif
+              return encoding == Encoding::Ascii
+                ? jsi::String::createFromAscii(runtime, buffer)
+                : jsi::String::createFromUtf8(
+                    runtime,
+                    encoding == Encoding::Base64 ? base64::to_base64(buffer) : buffer
+                );
             }
           }
         } catch (const char *error_message) {
@@ -443,52 +676,70 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "writeFile" || propName == "appendFile" || propName == "write") {
+  if (method == RNFSTurboMethod::WriteFile || method == RNFSTurboMethod::AppendFile || method == RNFSTurboMethod::Write) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
-      [this, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+      [this, method, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
         if (count < 1 || !arguments[0].isString()) [[unlikely]] {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "First argument ('filepath') has to be of type string"));
         }
-        std::string encoding{"utf8"};
+        std::string encodingName{"utf8"};
         std::map<std::string, std::string> options;
         int optionsIndex{-1};
         bool optionsIsObject{false};
+        bool preallocate{false};
+        Compression compression{Compression::None};
 #ifdef RNFSTURBO_USE_ENCRYPTION
         bool encrypted{false};
         std::string mode{"ecb"};
         std::string padding{"pkcs5/pkcs7"};
+        bool mac{true};
         int passphraseLength{0};
         int ivLength{0};
         std::vector<unsigned char> passphrase;
         std::vector<unsigned char> iv;
 #endif
-        if (propName == "write" && count == 4 && arguments[3].isString()) {
+        if (method == RNFSTurboMethod::Write && count == 4 && arguments[3].isString()) {
           optionsIndex = 3;
-        } else if (propName != "write" && count == 3 && arguments[2].isString()) {
+        } else if (method != RNFSTurboMethod::Write && count == 3 && arguments[2].isString()) {
           optionsIndex = 2;
-        } else if (propName == "write" && count == 4 && arguments[3].isObject()) {
+        } else if (method == RNFSTurboMethod::Write && count == 4 && arguments[3].isObject()) {
           optionsIndex = 3;
           optionsIsObject = true;
-        } else if (propName != "write" && count == 3 && arguments[2].isObject()) {
+        } else if (method != RNFSTurboMethod::Write && count == 3 && arguments[2].isObject()) {
           optionsIndex = 2;
           optionsIsObject = true;
         }
         if (optionsIndex > -1 && !optionsIsObject) {
-          encoding = arguments[optionsIndex].asString(runtime).utf8(runtime);
+          encodingName = arguments[optionsIndex].asString(runtime).utf8(runtime);
         } else if (optionsIndex > -1 && optionsIsObject) {
           auto optionsObject = arguments[optionsIndex].asObject(runtime);
-          if (optionsObject.hasProperty(runtime, "encoding")) {
-            auto encodingOption = optionsObject.getProperty(runtime, "encoding");
-            if (encodingOption.isString()) {
-              encoding = encodingOption.asString(runtime).utf8(runtime);
+          auto encodingOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Encoding]);
+          if (encodingOption.isString()) {
+            encodingName = encodingOption.asString(runtime).utf8(runtime);
+          }
+          auto preallocateOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Preallocate]);
+          if (preallocateOption.isBool()) {
+            preallocate = preallocateOption.asBool();
+          }
+          auto compressionOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Compression]);
+          if (compressionOption.isString()) {
+            std::string compressionName = compressionOption.asString(runtime).utf8(runtime);
+            std::optional<Compression> parsedCompression = parseCompression(compressionName);
+            if (!parsedCompression.has_value()) {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", propName.c_str(), "Wrong compression", compressionName.c_str()));
+            }
+            if (method == RNFSTurboMethod::Write) {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Compression is only available for the readFile, writeFile and appendFile methods"));
             }
+            compression = parsedCompression.value();
           }
 #ifdef RNFSTURBO_USE_ENCRYPTION
           processEncryptionOptions(
             runtime,
             propName,
+            *propNames,
             optionsObject,
             encrypted,
             passphraseLength,
@@ -496,57 +747,43 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
             ivLength,
             iv,
             mode,
-            padding
+            padding,
+            mac
           );
 #endif
 #ifdef __APPLE__
-          if (optionsObject.hasProperty(runtime, "NSFileProtectionKey")) {
-            auto protectionOption = optionsObject.getProperty(runtime, "NSFileProtectionKey");
-            if (protectionOption.isString()) {
-              options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
-            }
+          auto protectionOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::NSFileProtectionKey]);
+          if (protectionOption.isString()) {
+            options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
           }
 #endif
         }
-        if (
-          encoding != "utf8" &&
-          encoding != "base64" &&
-          encoding != "uint8" &&
-          encoding != "uint16" &&
-          encoding != "uint32" &&
-          encoding != "float32" &&
-          encoding != "ascii"
-        ) {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", propName.c_str(), "Wrong encoding", encoding.c_str()));
-        }
-        if (
-          (
-            encoding == "uint8" ||
-            encoding == "uint16" ||
-            encoding == "uint32" ||
-            encoding == "float32"
-          ) && (count < 2 || !arguments[1].isObject())
-        ) [[unlikely]] {
+        std::optional<Encoding> parsedEncoding = parseEncoding(encodingName);
+        if (!parsedEncoding.has_value()) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", propName.c_str(), "Wrong encoding", encodingName.c_str()));
+        }
+        Encoding encoding = parsedEncoding.value();
+        if (isNumericEncoding(encoding) && (count < 2 || !arguments[1].isObject())) [[unlikely]] {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Second argument ('content') has to be of type number[]"));
-        } else if (
-          encoding != "uint8" &&
-          encoding != "uint16" &&
-          encoding != "uint32" &&
-          encoding != "float32" &&
-          (count < 2 || !arguments[1].isString())
-        ) [[unlikely]] {
+        } else if (!isNumericEncoding(encoding) && (count < 2 || !arguments[1].isString())) [[unlikely]] {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Second argument ('content') has to be of type string"));
         }
-        if ((propName == "write" && count > 4) || (propName != "write" && count > 3)) [[unlikely]] {
+        if ((method == RNFSTurboMethod::Write && count > 4) || (method != RNFSTurboMethod::Write && count > 3)) [[unlikely]] {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Too many arguments"));
         }
 #ifdef RNFSTURBO_USE_ENCRYPTION
         if (encrypted && passphraseLength == 0) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Passphrase is required for encryption"));
         }
+        if (encrypted && compression != Compression::None) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Compression can't be combined with encryption"));
+        }
 #endif
+        if (compression != Compression::None && isNumericEncoding(encoding)) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Compression is only available for utf8, ascii and base64 encodings"));
+        }
         int offset{-1};
-        if (propName == "write" && count > 2 && arguments[2].isNumber()) {
+        if (method == RNFSTurboMethod::Write && count > 2 && arguments[2].isNumber()) {
           offset = arguments[2].asNumber();
         }
         if (offset < -1) {
@@ -561,21 +798,21 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         uint32_t *contentArrUint32 = nullptr;
         float *contentArrFloat32 = nullptr;
         int contentLength{0};
-        if (encoding == "uint8" || encoding == "uint16" || encoding == "uint32" || encoding == "float32") {
+        if (isNumericEncoding(encoding)) {
           jsi::Array jsiArr = arguments[1].asObject(runtime).asArray(runtime);
           if (!jsiArr.isArray(runtime)) {
             throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Second argument ('content') has to be of type number[]"));
           }
-          if (encoding == "float32") {
+          if (encoding == Encoding::Float32) {
             contentArrFloat32 = new float[jsiArr.size(runtime)];
             contentLength = (int) jsiArr.size(runtime) * sizeof(float);
-          } else if (encoding == "uint8") {
+          } else if (encoding == Encoding::Uint8) {
             contentArrUint8 = new uint8_t[jsiArr.size(runtime)];
             contentLength = (int) jsiArr.size(runtime) * sizeof(uint8_t);
-          } else if (encoding == "uint16") {
+          } else if (encoding == Encoding::Uint16) {
             contentArrUint16 = new uint16_t[jsiArr.size(runtime)];
             contentLength = (int) jsiArr.size(runtime) * sizeof(uint16_t);
-          } else if (encoding == "uint32") {
+          } else if (encoding == Encoding::Uint32) {
             contentArrUint32 = new uint32_t[jsiArr.size(runtime)];
             contentLength = (int) jsiArr.size(runtime) * sizeof(uint32_t);
           }
@@ -583,40 +820,59 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
             if (!jsiArr.getValueAtIndex(runtime, i).isNumber()) {
               throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Every element of content array has to be of type number"));
             }
-            if (encoding == "float32") {
+            if (encoding == Encoding::Float32) {
               contentArrFloat32[i] = (float) jsiArr.getValueAtIndex(runtime, i).asNumber();
-            } else if (encoding == "uint8") {
+            } else if (encoding == Encoding::Uint8) {
               contentArrUint8[i] = (uint8_t) jsiArr.getValueAtIndex(runtime, i).asNumber();
-            } else if (encoding == "uint16") {
+            } else if (encoding == Encoding::Uint16) {
               contentArrUint16[i] = fromBigEndian((uint16_t) jsiArr.getValueAtIndex(runtime, i).asNumber());
-            } else if (encoding == "uint32") {
+            } else if (encoding == Encoding::Uint32) {
               contentArrUint32[i] = fromBigEndian((uint32_t) jsiArr.getValueAtIndex(runtime, i).asNumber());
             }
           }
         } else {
           content = arguments[1].asString(runtime).utf8(runtime);
-          if (encoding == "base64") {
+          if (encoding == Encoding::Base64) {
             content = base64::from_base64(content);
           }
         }
         
+        statCache.invalidate(filePath);
         try {
           struct stat t_stat;
           bool fileExists = stat(filePath.c_str(), &t_stat) >= 0;
-          if (encoding == "uint8" || encoding == "uint16" || encoding == "uint32") {
-            if (fileExists && propName == "write" && offset > -1 && encoding == "uint8") {
+          bool isAppend = fileExists && (method == RNFSTurboMethod::AppendFile || (method == RNFSTurboMethod::Write && offset == -1));
+          // Writes at an offset rewrite the file in place, there is nothing to reserve for them.
+          // The compressed size isn't known upfront either
+          if (preallocate && compression == Compression::None && !(fileExists && method == RNFSTurboMethod::Write && offset > -1)) {
+            size_t length = isNumericEncoding(encoding) ? contentLength : content.size();
+#ifdef RNFSTURBO_USE_ENCRYPTION
+            if (encrypted && mode == "chunked") {
+              // Header, nonce and tag of every chunk
+              length += 48 + (length / (64 * 1024) + 1) * 48;
+            } else if (encrypted) {
+              // Room for the padding block
+              length += 16;
+            }
+#endif
+            // Fails with ENOSPC before anything is written. The file is emptied here, so the write appends
+            reserveFileSpace(filePath, length, !isAppend);
+            isAppend = true;
+          }
+          if (encoding == Encoding::Uint8 || encoding == Encoding::Uint16 || encoding == Encoding::Uint32) {
+            if (fileExists && method == RNFSTurboMethod::Write && offset > -1 && encoding == Encoding::Uint8) {
               std::string replaceString(
                 reinterpret_cast<char*>(contentArrUint8),
                 contentLength
               );
               writeWithOffset(filePath.c_str(), replaceString, offset);
-            } else if (fileExists && propName == "write" && offset > -1 && encoding == "uint16") {
+            } else if (fileExists && method == RNFSTurboMethod::Write && offset > -1 && encoding == Encoding::Uint16) {
               std::string replaceString(
                 reinterpret_cast<char*>(contentArrUint16),
                 contentLength
               );
               writeWithOffset(filePath.c_str(), replaceString, offset);
-            } else if (fileExists && propName == "write" && offset > -1 && encoding == "uint32") {
+            } else if (fileExists && method == RNFSTurboMethod::Write && offset > -1 && encoding == Encoding::Uint32) {
               std::string replaceString(
                 reinterpret_cast<char*>(contentArrUint32),
                 contentLength
@@ -630,11 +886,11 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
                 contentArrUint16,
                 contentArrUint32,
                 contentLength,
-                fileExists && (propName == "appendFile" || (propName == "write" && offset == -1))
+                isAppend
               );
             }
-          } else if (encoding == "float32") {
-            if (fileExists && propName == "write" && offset > -1) {
+          } else if (encoding == Encoding::Float32) {
+            if (fileExists && method == RNFSTurboMethod::Write && offset > -1) {
               std::string replaceString = reinterpret_cast<char*>(contentArrFloat32);
               writeWithOffset(filePath.c_str(), replaceString, offset);
             } else {
@@ -642,17 +898,25 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
                 filePath.c_str(),
                 contentArrFloat32,
                 contentLength,
-                fileExists && (propName == "appendFile" || (propName == "write" && offset == -1))
+                isAppend
               );
             }
           } else {
-            if (fileExists && propName == "write" && offset > -1) {
+            if (fileExists && method == RNFSTurboMethod::Write && offset > -1) {
               writeWithOffset(
                 filePath.c_str(),
                 content,
                 offset
               );
 #ifdef RNFSTURBO_USE_ENCRYPTION
+            } else if (encrypted && mode == "chunked") {
+              writeChunkedEncryptedFile(
+                filePath.c_str(),
+                content,
+                passphrase,
+                mac,
+                isAppend
+              );
             } else if (encrypted) {
               auto krypt = createCipherMode(
                 runtime,
@@ -662,27 +926,26 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
                 passphrase.data(),
                 passphrase.size()
               );
-              ByteArray cipher = krypt->encrypt(
-                reinterpret_cast<unsigned char*>(content.data()),
-                content.size(),
-                iv.data()
-              );
-              
-              std::string encryptedContent(
-                reinterpret_cast<const char*>(cipher.array),
-                cipher.length
-              );
-              writeFile(
+              writeEncryptedFile(
                 filePath.c_str(),
-                encryptedContent,
-                fileExists && (propName == "appendFile" || (propName == "write" && offset == -1))
+                content,
+                *krypt,
+                iv,
+                isAppend
               );
 #endif
+            } else if (compression != Compression::None) {
+              writeFileCompressed(
+                filePath.c_str(),
+                content,
+                compression,
+                isAppend
+              );
             } else {
               writeFile(
                 filePath.c_str(),
                 content,
-                fileExists && (propName == "appendFile" || (propName == "write" && offset == -1))
+                isAppend
               );
             }
           }
@@ -717,7 +980,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "moveFile") {
+  if (method == RNFSTurboMethod::MoveFile) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -733,20 +996,37 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         std::string destPath = cleanPath(arguments[1].asString(runtime).utf8(runtime));
         
         std::map<std::string, std::string> options;
+        std::optional<jsi::Function> progressFunc;
+        bool uncached{false};
         if (count == 3 && arguments[2].isObject()) {
           auto optionsObject = arguments[2].asObject(runtime);
 #ifdef __APPLE__
-          if (optionsObject.hasProperty(runtime, "NSFileProtectionKey")) {
-            auto protectionOption = optionsObject.getProperty(runtime, "NSFileProtectionKey");
-            if (protectionOption.isString()) {
-              options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
-            }
+          auto protectionOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::NSFileProtectionKey]);
+          if (protectionOption.isString()) {
+            options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
           }
 #endif
+          progressFunc = getProgressOption(runtime, optionsObject, *propNames);
+          auto uncachedOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Uncached]);
+          if (uncachedOption.isBool()) {
+            uncached = uncachedOption.asBool();
+          }
         }
 
         try {
-          fs::rename(filePath.c_str(), destPath.c_str());
+          statCache.invalidate(filePath);
+          statCache.invalidate(destPath);
+          try {
+            fs::rename(filePath.c_str(), destPath.c_str());
+          } catch (fs::filesystem_error& e) {
+            if (e.code() != std::errc::cross_device_link) {
+              throw;
+            }
+            // Different filesystems (e.g. internal storage and an SD card), the data has to be copied
+            runCopyJob(runtime, *propNames, progressFunc, [&filePath, &destPath, uncached](CopyProgress& progress) {
+              moveAcrossDevices(filePath, destPath, uncached, progress);
+            });
+          }
           
 #ifdef __APPLE__
           if (options.count("NSFileProtectionKey") > 0) {
@@ -759,13 +1039,20 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
 #endif
         } catch (fs::filesystem_error& e) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "moveFile", e.what()));
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "moveFile", error_message));
+        } catch (const jsi::JSError&) {
+          // Thrown by the progress callback, goes back to JS as it is
+          throw;
+        } catch (const std::exception& e) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "moveFile", e.what()));
         }
 
         return jsi::Value::undefined();
       }
     );
   }
-  if (propName == "copyFolder") {
+  if (method == RNFSTurboMethod::CopyFolder) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -781,16 +1068,21 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         std::string destFolderPath = cleanPath(arguments[1].asString(runtime).utf8(runtime));
         
         std::map<std::string, std::string> options;
+        std::optional<jsi::Function> progressFunc;
+        bool uncached{false};
         if (count == 3 && arguments[2].isObject()) {
           auto optionsObject = arguments[2].asObject(runtime);
 #ifdef __APPLE__
-          if (optionsObject.hasProperty(runtime, "NSFileProtectionKey")) {
-            auto protectionOption = optionsObject.getProperty(runtime, "NSFileProtectionKey");
-            if (protectionOption.isString()) {
-              options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
-            }
+          auto protectionOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::NSFileProtectionKey]);
+          if (protectionOption.isString()) {
+            options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
           }
 #endif
+          progressFunc = getProgressOption(runtime, optionsObject, *propNames);
+          auto uncachedOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Uncached]);
+          if (uncachedOption.isBool()) {
+            uncached = uncachedOption.asBool();
+          }
         }
 
         struct stat t_stat;
@@ -803,7 +1095,10 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         }
 
         try {
-          fs::copy(srcFolderPath, destFolderPath, fs::copy_options::overwrite_existing | fs::copy_options::recursive);
+          statCache.invalidate(destFolderPath);
+          runCopyJob(runtime, *propNames, progressFunc, [&srcFolderPath, &destFolderPath, uncached](CopyProgress& progress) {
+            copyTreeNative(srcFolderPath, destFolderPath, CopyOptions{true, false, uncached}, progress);
+          });
           
 #ifdef __APPLE__
           if (options.count("NSFileProtectionKey") > 0) {
@@ -816,19 +1111,25 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
 #endif
         } catch (fs::filesystem_error& e) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "copyFolder", e.what()));
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", srcFolderPath.c_str(), "copyFolder", error_message));
+        } catch (const jsi::JSError&) {
+          throw;
+        } catch (const std::exception& e) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", srcFolderPath.c_str(), "copyFolder", e.what()));
         }
 
         return jsi::Value::undefined();
       }
     );
   }
-  if (propName == "copyFile" || propName == "copyFileAssets" || propName == "copyFileRes") {
+  if (method == RNFSTurboMethod::CopyFile || method == RNFSTurboMethod::CopyFileAssets || method == RNFSTurboMethod::CopyFileRes) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
-      [this, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+      [this, method, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
 #ifndef __ANDROID__
-        if (propName == "copyFileAssets" || propName == "copyFileRes") {
+        if (method == RNFSTurboMethod::CopyFileAssets || method == RNFSTurboMethod::CopyFileRes) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Command only for Android"));
         }
 #endif
@@ -843,25 +1144,34 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         std::string destPath = cleanPath(arguments[1].asString(runtime).utf8(runtime));
         
         std::map<std::string, std::string> options;
+        std::optional<jsi::Function> progressFunc;
+        bool uncached{false};
         if (count == 3 && arguments[2].isObject()) {
           auto optionsObject = arguments[2].asObject(runtime);
 #ifdef __APPLE__
-          if (optionsObject.hasProperty(runtime, "NSFileProtectionKey")) {
-            auto protectionOption = optionsObject.getProperty(runtime, "NSFileProtectionKey");
-            if (protectionOption.isString()) {
-              options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
-            }
+          auto protectionOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::NSFileProtectionKey]);
+          if (protectionOption.isString()) {
+            options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
           }
 #endif
+          progressFunc = getProgressOption(runtime, optionsObject, *propNames);
+          auto uncachedOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::Uncached]);
+          if (uncachedOption.isBool()) {
+            uncached = uncachedOption.asBool();
+          }
         }
 
+        statCache.invalidate(destPath);
         try {
-          if (propName == "copyFileAssets" || propName == "copyFileRes") {
+          if (method == RNFSTurboMethod::CopyFileAssets || method == RNFSTurboMethod::CopyFileRes) {
 #ifdef __ANDROID__
-            platformHelper->copyFileAssetsOrRes(filePath.c_str(), destPath.c_str(), propName == "copyFileRes");
+            platformHelper->copyFileAssetsOrRes(filePath.c_str(), destPath.c_str(), method == RNFSTurboMethod::CopyFileRes);
 #endif
           } else {
-            fs::copy(filePath.c_str(), destPath.c_str());
+            // Fails if destPath already exists
+            runCopyJob(runtime, *propNames, progressFunc, [&filePath, &destPath, uncached](CopyProgress& progress) {
+              copyFileNative(filePath, destPath, CopyOptions{false, false, uncached}, progress);
+            });
             
 #ifdef __APPLE__
           if (options.count("NSFileProtectionKey") > 0) {
@@ -877,13 +1187,17 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), e.what()));
         } catch (const char* error_message) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), propName.c_str(), error_message));
+        } catch (const jsi::JSError&) {
+          throw;
+        } catch (const std::exception& e) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), propName.c_str(), e.what()));
         }
 
         return jsi::Value::undefined();
       }
     );
   }
-  if (propName == "copyAssetsFileIOS") {
+  if (method == RNFSTurboMethod::CopyAssetsFileIOS) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -922,6 +1236,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         
         if (imageUri.rfind("ph://", 0) == std::string::npos) {
           try {
+            statCache.invalidate(destPath);
             fs::copy(imageUri.c_str(), destPath.c_str());
           } catch (fs::filesystem_error& e) {
             throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "copyAssetsFileIOS", e.what()));
@@ -930,6 +1245,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         }
 
         try {
+          statCache.invalidate(destPath);
           platformHelper->copyAssetsFileIOS(imageUri.c_str(), destPath.c_str(), width, height, scale, compression, resizeMode.c_str());
         } catch (const char* error_message) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", imageUri.c_str(), "copyAssetsFileIOS", error_message));
@@ -943,7 +1259,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "copyAssetsVideoIOS") {
+  if (method == RNFSTurboMethod::CopyAssetsVideoIOS) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -961,6 +1277,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
 
         if (videoUri.rfind("ph://", 0) == std::string::npos) {
           try {
+            statCache.invalidate(destPath);
             fs::copy(videoUri.c_str(), destPath.c_str());
           } catch (fs::filesystem_error& e) {
             throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "copyAssetsVideoIOS", e.what()));
@@ -969,6 +1286,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         }
 
         try {
+          statCache.invalidate(destPath);
           platformHelper->copyAssetsVideoIOS(videoUri.c_str(), destPath.c_str());
         } catch (const char* error_message) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", videoUri.c_str(), "copyAssetsVideoIOS", error_message));
@@ -982,7 +1300,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "unlink") {
+  if (method == RNFSTurboMethod::Unlink) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1009,6 +1327,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         }
 
         try {
+          statCache.invalidate(filePath);
           fs::remove_all(filePath.c_str());
         } catch (fs::filesystem_error& e) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "unlink", e.what()));
@@ -1018,13 +1337,13 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "exists" || propName == "existsAssets" || propName == "existsRes") {
+  if (method == RNFSTurboMethod::Exists || method == RNFSTurboMethod::ExistsAssets || method == RNFSTurboMethod::ExistsRes) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
-      [this, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+      [this, method, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
 #ifndef __ANDROID__
-        if (propName == "existsAssets" || propName == "existsRes") {
+        if (method == RNFSTurboMethod::ExistsAssets || method == RNFSTurboMethod::ExistsRes) {
           throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Command only for Android"));
         }
 #endif
@@ -1035,141 +1354,1556 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
 
         bool exists{false};
-        if (propName == "existsAssets" || propName == "existsRes") {
+        if (method == RNFSTurboMethod::ExistsAssets || method == RNFSTurboMethod::ExistsRes) {
 #ifdef __ANDROID__
-          exists = platformHelper->existsAssetsOrRes(filePath.c_str(), propName == "existsRes");
+          exists = platformHelper->existsAssetsOrRes(filePath.c_str(), method == RNFSTurboMethod::ExistsRes);
 #endif
         } else {
           struct stat t_stat;
-          exists = stat(filePath.c_str(), &t_stat) >= 0;
+          exists = statCache.stat(filePath, t_stat) == 0;
         }
         
         return jsi::Value(exists);
       }
     );
   }
-  if (propName == "hash") {
+  if (method == RNFSTurboMethod::StatMany || method == RNFSTurboMethod::ExistsMany) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [this, method, propName](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count != 1 || !arguments[0].isObject() || !arguments[0].asObject(runtime).isArray(runtime)) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "First argument ('filepaths') has to be an array of strings"));
+        }
+
+        std::vector<std::string> paths = getPathsArgument(runtime, arguments[0].asObject(runtime).asArray(runtime), propName);
+        size_t len = paths.size();
+
+        if (method == RNFSTurboMethod::ExistsMany) {
+          auto exists = std::make_shared<RNFSTurboBuffer>(len);
+          try {
+            existsMany(paths, exists->data());
+          } catch (const char* error_message) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), error_message));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), e.what()));
+          }
+          return jsi::ArrayBuffer(runtime, exists);
+        }
+
+        // Columnar results: one typed array per field instead of an object per file
+        auto size = std::make_shared<RNFSTurboBuffer>(len * sizeof(double));
+        auto mtime = std::make_shared<RNFSTurboBuffer>(len * sizeof(double));
+        auto mode = std::make_shared<RNFSTurboBuffer>(len * sizeof(uint32_t));
+        auto flags = std::make_shared<RNFSTurboBuffer>(len);
+        try {
+          statMany(paths, size->as<double>(), mtime->as<double>(), mode->as<uint32_t>(), flags->data());
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), error_message));
+        } catch (const std::exception& e) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), e.what()));
+        }
+
+        const RNFSTurboPropNames& names = *propNames;
+        jsi::Object obj = jsi::Object(runtime);
+        obj.setProperty(runtime, names[PropKey::Size], jsi::ArrayBuffer(runtime, size));
+        obj.setProperty(runtime, names[PropKey::Mtime], jsi::ArrayBuffer(runtime, mtime));
+        obj.setProperty(runtime, names[PropKey::Mode], jsi::ArrayBuffer(runtime, mode));
+        obj.setProperty(runtime, names[PropKey::Flags], jsi::ArrayBuffer(runtime, flags));
+
+        return obj;
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Walk) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
       [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
-        if (count < 2 || !arguments[0].isString()) [[unlikely]] {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hash", "First argument ('filepath') has to be of type string"));
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "walk", "First argument ('dirpath') has to be of type string"));
         }
-        if (count < 2 || !arguments[1].isString()) [[unlikely]] {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hash", "Second argument ('algorithm') has to be of type string"));
+        if (count > 5) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "walk", "Too many arguments"));
         }
 
-        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
-        std::string algorithm = arguments[1].asString(runtime).utf8(runtime);
+        std::string dirPath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        if (dirPath.size() > 1 && dirPath.back() == '/') {
+          dirPath.pop_back();
+        }
 
-        try {
-          std::string buffer = readFile(filePath.c_str(), 0, -1);
-          jsi::String res = jsi::String::createFromUtf8(runtime, "");
-
-          if (algorithm == "md5") {
-            res = jsi::String::createFromUtf8(runtime, md5(buffer));
-          } else if (algorithm == "sha1") {
-            res = jsi::String::createFromUtf8(runtime, sha1(buffer));
-          } else if (algorithm == "sha224") {
-            res = jsi::String::createFromUtf8(runtime, sha224(buffer));
-          } else if (algorithm == "sha256") {
-            res = jsi::String::createFromUtf8(runtime, sha256(buffer));
-          } else if (algorithm == "sha384") {
-            res = jsi::String::createFromUtf8(runtime, sha384(buffer));
-          } else if (algorithm == "sha512") {
-            res = jsi::String::createFromUtf8(runtime, sha512(buffer));
-          } else {
-            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "hash", "Wrong algorithm", algorithm.c_str()));
+        const RNFSTurboPropNames& names = *propNames;
+        WalkOptions walkOptions;
+        if (count > 1 && arguments[1].isObject()) {
+          jsi::Object options = arguments[1].asObject(runtime);
+          jsi::Value optionMaxDepth = options.getProperty(runtime, names[PropKey::MaxDepth]);
+          if (optionMaxDepth.isNumber()) {
+            walkOptions.maxDepth = static_cast<int>(optionMaxDepth.asNumber());
+          }
+          jsi::Value optionGlob = options.getProperty(runtime, names[PropKey::Glob]);
+          if (optionGlob.isString()) {
+            walkOptions.glob = optionGlob.asString(runtime).utf8(runtime);
+          }
+          jsi::Value optionMinSize = options.getProperty(runtime, names[PropKey::MinSize]);
+          if (optionMinSize.isNumber()) {
+            walkOptions.minSize = optionMinSize.asNumber();
+          }
+          jsi::Value optionMaxSize = options.getProperty(runtime, names[PropKey::MaxSize]);
+          if (optionMaxSize.isNumber()) {
+            walkOptions.maxSize = optionMaxSize.asNumber();
+          }
+          jsi::Value optionModifiedAfter = options.getProperty(runtime, names[PropKey::ModifiedAfter]);
+          if (optionModifiedAfter.isNumber()) {
+            walkOptions.modifiedAfter = optionModifiedAfter.asNumber();
+          }
+          jsi::Value optionType = options.getProperty(runtime, names[PropKey::Type]);
+          if (optionType.isString()) {
+            std::string typeName = optionType.asString(runtime).utf8(runtime);
+            std::optional<WalkType> type = parseWalkType(typeName);
+            if (!type.has_value()) {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "walk", "Wrong type", typeName.c_str()));
+            }
+            walkOptions.type = type.value();
+          }
+          jsi::Value optionFollowSymlinks = options.getProperty(runtime, names[PropKey::FollowSymlinks]);
+          if (optionFollowSymlinks.isBool()) {
+            walkOptions.followSymlinks = optionFollowSymlinks.asBool();
           }
+          jsi::Value optionBatchSize = options.getProperty(runtime, names[PropKey::BatchSize]);
+          if (optionBatchSize.isNumber() && optionBatchSize.asNumber() >= 1) {
+            walkOptions.batchSize = static_cast<size_t>(optionBatchSize.asNumber());
+          }
+        }
 
-          return res;
-        } catch (const char* error_message) {
-          throw jsi::JSError(runtime, error_message);
+        if (count < 3 || !arguments[2].isObject()) {
+          std::vector<WalkEntry> entries;
+          try {
+            walk(dirPath, walkOptions, [&entries](std::vector<WalkEntry>&& batch) {
+              if (entries.empty()) {
+                entries = std::move(batch);
+              } else {
+                std::move(batch.begin(), batch.end(), std::back_inserter(entries));
+              }
+            });
+          } catch (const char* error_message) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", dirPath.c_str(), "walk", error_message));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", dirPath.c_str(), "walk", e.what()));
+          }
+          return createDirItems(runtime, names, entries);
         }
-        return jsi::Value::undefined();
+
+        std::shared_ptr<jsi::Function> batchFunc = std::make_shared<jsi::Function>(arguments[2].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> completeFunc;
+        if (count > 3 && arguments[3].isObject()) {
+          completeFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        }
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 4 && arguments[4].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[4].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        // Matches are streamed to JS batch by batch while the walk goes on
+        std::thread([&runtime, this, jobId, dirPath, walkOptions, batchFunc, completeFunc, errorFunc]() {
+          size_t total{0};
+          std::string errorMessage;
+          try {
+            walk(dirPath, walkOptions, [&runtime, this, jobId, batchFunc, &total](std::vector<WalkEntry>&& batch) {
+              total += batch.size();
+              auto entries = std::make_shared<std::vector<WalkEntry>>(std::move(batch));
+              _jsInvoker->invokeAsync([&runtime, this, jobId, batchFunc, entries]() {
+                const RNFSTurboPropNames& names = *propNames;
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+                result.setProperty(runtime, names[PropKey::Items], createDirItems(runtime, names, *entries));
+                batchFunc->call(runtime, std::move(result));
+              });
+            });
+          } catch (const char* error_message) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", dirPath.c_str(), "walk", error_message);
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", dirPath.c_str(), "walk", e.what());
+          }
+          if (!errorMessage.empty()) {
+            if (errorFunc != nullptr) {
+              _jsInvoker->invokeAsync([&runtime, errorFunc, jobId, errorMessage]() {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              });
+            }
+            return;
+          }
+          if (completeFunc != nullptr) {
+            _jsInvoker->invokeAsync([&runtime, completeFunc, jobId, total]() {
+              jsi::Object result = jsi::Object(runtime);
+              result.setProperty(runtime, "jobId", jsi::Value(jobId));
+              result.setProperty(runtime, "count", jsi::Value(static_cast<double>(total)));
+              completeFunc->call(runtime, std::move(result));
+            });
+          }
+        }).detach();
+
+        return jsi::Value(jobId);
       }
     );
   }
-  if (propName == "touch") {
+  if (method == RNFSTurboMethod::Du) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
       [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
         if (count < 1 || !arguments[0].isString()) [[unlikely]] {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "touch", "First argument ('filepath') has to be of type string"));
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "du", "First argument ('path') has to be of type string"));
         }
-        if (count > 3) [[unlikely]] {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "touch", "Too many arguments"));
+        if (count > 2) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "du", "Too many arguments"));
         }
 
-        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::string path = cleanPath(arguments[0].asString(runtime).utf8(runtime));
 
-        long int mtime{0};
-        bool isMTime{false};
-        if (count > 1 && arguments[1].isNumber()) {
-          mtime = arguments[1].asNumber() / 1000;
-          isMTime = true;
+        const RNFSTurboPropNames& names = *propNames;
+        DiskUsageMode mode{DiskUsageMode::Allocated};
+        bool perChild{false};
+        if (count > 1 && arguments[1].isObject()) {
+          jsi::Object options = arguments[1].asObject(runtime);
+          jsi::Value optionMode = options.getProperty(runtime, names[PropKey::Mode]);
+          if (optionMode.isString()) {
+            std::string modeName = optionMode.asString(runtime).utf8(runtime);
+            std::optional<DiskUsageMode> parsedMode = parseDiskUsageMode(modeName);
+            if (!parsedMode.has_value()) {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "du", "Wrong mode", modeName.c_str()));
+            }
+            mode = parsedMode.value();
+          }
+          jsi::Value optionPerChild = options.getProperty(runtime, names[PropKey::PerChild]);
+          if (optionPerChild.isBool()) {
+            perChild = optionPerChild.asBool();
+          }
         }
-        long int ctime{0};
-        bool isCTime{false};
-        if (count > 2 && arguments[2].isNumber()) {
-          ctime = arguments[2].asNumber() / 1000;
-          isCTime = true;
+
+        DiskUsage usage;
+        try {
+          usage = diskUsage(path, mode, perChild);
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", path.c_str(), "du", error_message));
+        } catch (const std::exception& e) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", path.c_str(), "du", e.what()));
         }
 
-        struct stat t_stat;
-        int res = stat(filePath.c_str(), &t_stat);
-        if (res < 0) {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "touch", strerror(errno)));
+        jsi::Object obj = jsi::Object(runtime);
+        obj.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(usage.size)));
+        obj.setProperty(runtime, names[PropKey::Files], jsi::Value(static_cast<double>(usage.files)));
+        if (perChild) {
+          jsi::Array children = jsi::Array(runtime, usage.children.size());
+          for (size_t i = 0; i < usage.children.size(); i++) {
+            jsi::Object child = jsi::Object(runtime);
+            child.setProperty(runtime, names[PropKey::Name], jsi::String::createFromUtf8(runtime, usage.children[i].name));
+            child.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(usage.children[i].size)));
+            children.setValueAtIndex(runtime, i, std::move(child));
+          }
+          obj.setProperty(runtime, names[PropKey::Children], std::move(children));
         }
 
-        if (isMTime) {
-          struct utimbuf new_times;
-          new_times.modtime = mtime > 0 ? mtime : std::time(0);
-          new_times.actime = mtime > 0 ? mtime : std::time(0);
-          utime(filePath.c_str(), &new_times);
+        return obj;
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::OpenDir) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "openDir", "First argument ('dirpath') has to be of type string"));
         }
-        if (isCTime) {
-          // Not available
+        if (count > 2) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "openDir", "Too many arguments"));
         }
-        stat(filePath.c_str(), &t_stat);
 
-        return jsi::Value(static_cast<int>(t_stat.st_mtime));
+        std::string dirPath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+
+        const RNFSTurboPropNames& names = *propNames;
+        DirSort sort{DirSort::None};
+        bool descending{false};
+        size_t limit{0};
+        if (count > 1 && arguments[1].isObject()) {
+          jsi::Object options = arguments[1].asObject(runtime);
+          jsi::Value optionSort = options.getProperty(runtime, names[PropKey::Sort]);
+          if (optionSort.isString()) {
+            std::string sortName = optionSort.asString(runtime).utf8(runtime);
+            std::optional<DirSort> parsedSort = parseDirSort(sortName);
+            if (!parsedSort.has_value()) {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "openDir", "Wrong sort", sortName.c_str()));
+            }
+            sort = parsedSort.value();
+          }
+          jsi::Value optionOrder = options.getProperty(runtime, names[PropKey::Order]);
+          if (optionOrder.isString()) {
+            descending = optionOrder.asString(runtime).utf8(runtime) == "desc";
+          }
+          jsi::Value optionLimit = options.getProperty(runtime, names[PropKey::Limit]);
+          if (optionLimit.isNumber() && optionLimit.asNumber() >= 1) {
+            limit = static_cast<size_t>(optionLimit.asNumber());
+          }
+        }
+
+        try {
+          auto cursor = std::make_unique<DirCursor>(dirPath, sort, descending, limit);
+          return jsi::Object::createFromHostObject(
+            runtime,
+            std::make_shared<RNFSTurboDirCursorHostObject>(std::move(cursor), propNames)
+          );
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", dirPath.c_str(), "openDir", error_message));
+        }
       }
     );
   }
-  if (propName == "mkdir") {
+  if (method == RNFSTurboMethod::Watch) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
       [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
-        if ((count != 1 && count != 2) || !arguments[0].isString()) [[unlikely]] {
-          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "mkdir", "First argument ('filepath') has to be of type string"));
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "watch", "First argument ('dirpath') has to be of type string"));
+        }
+        if (count < 3 || !arguments[2].isObject() || !arguments[2].asObject(runtime).isFunction(runtime)) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "watch", "Third argument ('callback') has to be of type function"));
+        }
+        if (count > 3) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "watch", "Too many arguments"));
         }
 
-        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::string dirPath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        if (dirPath.size() > 1 && dirPath.back() == '/') {
+          dirPath.pop_back();
+        }
 
-        std::map<std::string, std::string> options;
-        if (count == 2 && arguments[1].isObject()) {
-          auto optionsObject = arguments[1].asObject(runtime);
-#ifdef __APPLE__
-          if (optionsObject.hasProperty(runtime, "NSFileProtectionKey")) {
-            auto protectionOption = optionsObject.getProperty(runtime, "NSFileProtectionKey");
-            if (protectionOption.isString()) {
-              options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
+        const RNFSTurboPropNames& names = *propNames;
+        WatchOptions watchOptions;
+        if (arguments[1].isObject()) {
+          jsi::Object options = arguments[1].asObject(runtime);
+          jsi::Value optionRecursive = options.getProperty(runtime, names[PropKey::Recursive]);
+          if (optionRecursive.isBool()) {
+            watchOptions.recursive = optionRecursive.asBool();
+          }
+          jsi::Value optionDebounceMs = options.getProperty(runtime, names[PropKey::DebounceMs]);
+          if (optionDebounceMs.isNumber()) {
+            watchOptions.debounceMs = static_cast<int>(optionDebounceMs.asNumber());
+          }
+          jsi::Value optionEvents = options.getProperty(runtime, names[PropKey::Events]);
+          if (optionEvents.isObject() && optionEvents.asObject(runtime).isArray(runtime)) {
+            jsi::Array events = optionEvents.asObject(runtime).asArray(runtime);
+            watchOptions.events = 0;
+            for (size_t i = 0; i < events.size(runtime); i++) {
+              jsi::Value event = events.getValueAtIndex(runtime, i);
+              std::string eventName = event.isString() ? event.asString(runtime).utf8(runtime) : "";
+              std::optional<WatchEvents> parsedEvent = parseWatchEvent(eventName);
+              if (!parsedEvent.has_value()) {
+                throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "watch", "Wrong event", eventName.c_str()));
+              }
+              watchOptions.events |= parsedEvent.value();
             }
           }
-          if (optionsObject.hasProperty(runtime, "NSURLIsExcludedFromBackupKey")) {
-            auto excludeFromBackupOption = optionsObject.getProperty(runtime, "NSURLIsExcludedFromBackupKey");
-            if (excludeFromBackupOption.isBool()) {
-              options["NSURLIsExcludedFromBackupKey"] = excludeFromBackupOption.getBool() ? "YES" : "NO";
+        }
+
+        std::shared_ptr<jsi::Function> callbackFunc = std::make_shared<jsi::Function>(arguments[2].asObject(runtime).asFunction(runtime));
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int watchId = RNFSTurboPlatformHelper::jobId;
+
+        WatchCallback watchCallback = [&runtime, this, watchId, callbackFunc](std::vector<WatchChange>&& changes) -> void {
+          auto batch = std::make_shared<std::vector<WatchChange>>(std::move(changes));
+          _jsInvoker->invokeAsync([&runtime, this, watchId, callbackFunc, batch]() {
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Array changesArray = jsi::Array(runtime, batch->size());
+            for (size_t i = 0; i < batch->size(); i++) {
+              const WatchChange& change = (*batch)[i];
+              std::vector<std::string_view> eventNames = watchEventNames(change.events);
+              jsi::Array events = jsi::Array(runtime, eventNames.size());
+              for (size_t j = 0; j < eventNames.size(); j++) {
+                events.setValueAtIndex(runtime, j, jsi::String::createFromAscii(runtime, eventNames[j].data(), eventNames[j].size()));
+              }
+              jsi::Object item = jsi::Object(runtime);
+              item.setProperty(runtime, names[PropKey::Path], jsi::String::createFromUtf8(runtime, change.path));
+              item.setProperty(runtime, names[PropKey::Events], std::move(events));
+              item.setProperty(runtime, names[PropKey::IsDirectory], jsi::Value(change.isDirectory));
+              changesArray.setValueAtIndex(runtime, i, std::move(item));
             }
+            jsi::Object result = jsi::Object(runtime);
+            result.setProperty(runtime, names[PropKey::WatchId], jsi::Value(watchId));
+            result.setProperty(runtime, names[PropKey::Changes], std::move(changesArray));
+            callbackFunc->call(runtime, std::move(result));
+          });
+        };
+
+        try {
+          watchers[watchId] = std::make_unique<DirWatcher>(dirPath, watchOptions, std::move(watchCallback));
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", dirPath.c_str(), "watch", error_message));
+        }
+
+        return jsi::Value(watchId);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Unwatch) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count != 1 || !arguments[0].isNumber()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "unwatch", "First argument ('watchId') has to be of type number"));
+        }
+
+        watchers.erase(static_cast<int>(arguments[0].asNumber()));
+
+        return jsi::Value::undefined();
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::ConfigureStatCache) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count != 1 || !arguments[0].isObject()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "configureStatCache", "First argument ('options') has to be of type object"));
+        }
+
+        const RNFSTurboPropNames& names = *propNames;
+        jsi::Object options = arguments[0].asObject(runtime);
+        bool enabled{true};
+        size_t maxEntries{StatCache::kDefaultMaxEntries};
+        std::vector<std::string> watchPaths;
+        jsi::Value optionEnabled = options.getProperty(runtime, names[PropKey::Enabled]);
+        if (optionEnabled.isBool()) {
+          enabled = optionEnabled.asBool();
+        }
+        jsi::Value optionMaxEntries = options.getProperty(runtime, names[PropKey::MaxEntries]);
+        if (optionMaxEntries.isNumber() && optionMaxEntries.asNumber() >= 1) {
+          maxEntries = static_cast<size_t>(optionMaxEntries.asNumber());
+        }
+        jsi::Value optionWatchPaths = options.getProperty(runtime, names[PropKey::WatchPaths]);
+        if (optionWatchPaths.isObject() && optionWatchPaths.asObject(runtime).isArray(runtime)) {
+          watchPaths = getPathsArgument(runtime, optionWatchPaths.asObject(runtime).asArray(runtime), "configureStatCache");
+        }
+
+        statCacheWatchers.clear();
+        statCache.configure(enabled, maxEntries);
+
+        // External changes are picked up by watching the given directories
+        if (enabled) {
+          WatchOptions watchOptions;
+          watchOptions.recursive = true;
+          watchOptions.debounceMs = 0;
+          for (const std::string& watchPath : watchPaths) {
+            try {
+              statCacheWatchers.push_back(std::make_unique<DirWatcher>(watchPath, watchOptions, [this](std::vector<WatchChange>&& changes) -> void {
+                for (const WatchChange& change : changes) {
+                  if (change.events & WatchEventOverflow) {
+                    statCache.clear();
+                    return;
+                  }
+                  statCache.invalidate(change.path);
+                }
+              }));
+            } catch (const char* error_message) {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", watchPath.c_str(), "configureStatCache", error_message));
+            }
+          }
+        }
+
+        return jsi::Value::undefined();
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::GetStatCacheStats) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      0,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count > 0) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "getStatCacheStats", "The function does not take arguments"));
+        }
+
+        const RNFSTurboPropNames& names = *propNames;
+        StatCacheStats stats = statCache.stats();
+        jsi::Object obj = jsi::Object(runtime);
+        obj.setProperty(runtime, names[PropKey::Enabled], jsi::Value(statCache.isEnabled()));
+        obj.setProperty(runtime, names[PropKey::Hits], jsi::Value(static_cast<double>(stats.hits)));
+        obj.setProperty(runtime, names[PropKey::Misses], jsi::Value(static_cast<double>(stats.misses)));
+        obj.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(stats.size)));
+        obj.setProperty(runtime, names[PropKey::MaxEntries], jsi::Value(static_cast<double>(stats.maxEntries)));
+
+        return obj;
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Allocate) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      3,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "allocate", "First argument ('filepath') has to be of type string"));
+        }
+        if (count < 2 || !arguments[1].isNumber() || arguments[1].asNumber() < 0) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "allocate", "Second argument ('size') has to be a non-negative number"));
+        }
+
+        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        uint64_t size = static_cast<uint64_t>(arguments[1].asNumber());
+        bool keepSize{false};
+        if (count > 2 && arguments[2].isObject()) {
+          auto keepSizeOption = arguments[2].asObject(runtime).getProperty(runtime, (*propNames)[PropKey::KeepSize]);
+          if (keepSizeOption.isBool()) {
+            keepSize = keepSizeOption.asBool();
+          }
+        }
+
+        statCache.invalidate(filePath);
+        try {
+          allocateFile(filePath, size, keepSize);
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "allocate", error_message));
+        }
+
+        return jsi::Value::undefined();
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Prefetch) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isObject() || !arguments[0].asObject(runtime).isArray(runtime)) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "prefetch", "First argument ('filepaths') has to be of type string[]"));
+        }
+
+        std::vector<std::string> paths = getPathsArgument(runtime, arguments[0].asObject(runtime).asArray(runtime), "prefetch");
+        double offset{0};
+        double length{0};
+        if (count > 1 && arguments[1].isObject()) {
+          const RNFSTurboPropNames& names = *propNames;
+          auto optionsObject = arguments[1].asObject(runtime);
+          auto offsetOption = optionsObject.getProperty(runtime, names[PropKey::Offset]);
+          if (offsetOption.isNumber()) {
+            offset = offsetOption.asNumber();
+          }
+          auto lengthOption = optionsObject.getProperty(runtime, names[PropKey::Length]);
+          if (lengthOption.isNumber()) {
+            length = lengthOption.asNumber();
+          }
+        }
+        if (offset < 0 || length < 0) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "prefetch", "Offset and length can't be negative"));
+        }
+
+        // Only a hint, nothing is reported back
+        std::thread([paths = std::move(paths), offset, length]() {
+          prefetchFiles(paths, static_cast<uint64_t>(offset), static_cast<uint64_t>(length));
+        }).detach();
+
+        return jsi::Value::undefined();
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Evict) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "evict", "First argument ('filepath') has to be of type string"));
+        }
+
+        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        try {
+          evictFile(filePath);
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "evict", error_message));
+        }
+
+        return jsi::Value::undefined();
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Pipeline) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      3,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "pipeline", "First argument ('srcPath') has to be of type string"));
+        }
+        if (count < 2 || !arguments[1].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "pipeline", "Second argument ('destPath') has to be of type string"));
+        }
+        if (count < 3 || !arguments[2].isObject() || !arguments[2].asObject(runtime).isArray(runtime)) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "pipeline", "Third argument ('stages') has to be of type array"));
+        }
+        if (count > 5) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "pipeline", "Too many arguments"));
+        }
+
+        std::string srcPath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::string destPath = cleanPath(arguments[1].asString(runtime).utf8(runtime));
+        const RNFSTurboPropNames& names = *propNames;
+        auto stages = std::make_shared<std::vector<std::unique_ptr<TransformStage>>>(
+          getPipelineStages(runtime, names, arguments[2].asObject(runtime).asArray(runtime))
+        );
+
+        if (count < 4 || !arguments[3].isObject()) {
+          PipelineResult pipelineResult;
+          statCache.invalidate(destPath);
+          try {
+            pipelineResult = runPipeline(srcPath, destPath, *stages);
+          } catch (const char* error_message) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", srcPath.c_str(), "pipeline", error_message));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", srcPath.c_str(), "pipeline", e.what()));
+          }
+          return createPipelineResult(runtime, names, pipelineResult);
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 4 && arguments[4].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[4].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        std::thread([&runtime, this, jobId, srcPath, destPath, stages, completeFunc, errorFunc]() {
+          std::string errorMessage;
+          auto pipelineResult = std::make_shared<PipelineResult>();
+          try {
+            *pipelineResult = runPipeline(srcPath, destPath, *stages);
+          } catch (const char* error_message) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", srcPath.c_str(), "pipeline", error_message);
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", srcPath.c_str(), "pipeline", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, completeFunc, errorFunc, jobId, destPath, pipelineResult, errorMessage]() {
+            statCache.invalidate(destPath);
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            jsi::Object result = createPipelineResult(runtime, *propNames, *pipelineResult);
+            result.setProperty(runtime, "jobId", jsi::Value(jobId));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Unzip) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "unzip", "First argument ('archivePath') has to be of type string"));
+        }
+        if (count < 2 || !arguments[1].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "unzip", "Second argument ('destDir') has to be of type string"));
+        }
+        if (count > 5) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "unzip", "Too many arguments"));
+        }
+
+        std::string archivePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::string destDir = cleanPath(arguments[1].asString(runtime).utf8(runtime));
+        if (destDir.size() > 1 && destDir.back() == '/') {
+          destDir.pop_back();
+        }
+
+        const RNFSTurboPropNames& names = *propNames;
+        UnzipOptions unzipOptions;
+        if (count > 2 && arguments[2].isObject()) {
+          jsi::Object options = arguments[2].asObject(runtime);
+          jsi::Value optionFilter = options.getProperty(runtime, names[PropKey::Filter]);
+          if (optionFilter.isString()) {
+            unzipOptions.filter = GlobMatcher(optionFilter.asString(runtime).utf8(runtime));
+          }
+          jsi::Value optionOverwrite = options.getProperty(runtime, names[PropKey::Overwrite]);
+          if (optionOverwrite.isBool()) {
+            unzipOptions.overwrite = optionOverwrite.asBool();
+          }
+        }
+
+        if (count < 4 || !arguments[3].isObject()) {
+          UnzipResult unzipResult;
+          try {
+            unzipResult = unzipArchive(archivePath, destDir, unzipOptions);
+          } catch (const char* error_message) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", archivePath.c_str(), "unzip", error_message));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", archivePath.c_str(), "unzip", e.what()));
+          }
+          statCache.invalidate(destDir);
+          jsi::Object result = jsi::Object(runtime);
+          result.setProperty(runtime, names[PropKey::Files], jsi::Value(static_cast<double>(unzipResult.files)));
+          result.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(unzipResult.size)));
+          return result;
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 4 && arguments[4].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[4].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        std::thread([&runtime, this, jobId, archivePath, destDir, unzipOptions, completeFunc, errorFunc]() {
+          std::string errorMessage;
+          UnzipResult unzipResult;
+          try {
+            unzipResult = unzipArchive(archivePath, destDir, unzipOptions);
+          } catch (const char* error_message) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", archivePath.c_str(), "unzip", error_message);
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", archivePath.c_str(), "unzip", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, jobId, destDir, unzipResult, errorMessage, completeFunc, errorFunc]() {
+            statCache.invalidate(destDir);
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Object result = jsi::Object(runtime);
+            result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+            result.setProperty(runtime, names[PropKey::Files], jsi::Value(static_cast<double>(unzipResult.files)));
+            result.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(unzipResult.size)));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Zip) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "zip", "First argument ('srcDir') has to be of type string"));
+        }
+        if (count < 2 || !arguments[1].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "zip", "Second argument ('archivePath') has to be of type string"));
+        }
+        if (count > 5) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "zip", "Too many arguments"));
+        }
+
+        std::string srcDir = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::string archivePath = cleanPath(arguments[1].asString(runtime).utf8(runtime));
+        if (srcDir.size() > 1 && srcDir.back() == '/') {
+          srcDir.pop_back();
+        }
+
+        const RNFSTurboPropNames& names = *propNames;
+        ZipOptions zipOptions;
+        if (count > 2 && arguments[2].isObject()) {
+          jsi::Object options = arguments[2].asObject(runtime);
+          jsi::Value optionLevel = options.getProperty(runtime, names[PropKey::Level]);
+          if (optionLevel.isNumber()) {
+            zipOptions.level = static_cast<int>(optionLevel.asNumber());
+            if (zipOptions.level < 0 || zipOptions.level > 9) [[unlikely]] {
+              throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "zip", "'level' has to be between 0 and 9"));
+            }
+          }
+          jsi::Value optionStoreExtensions = options.getProperty(runtime, names[PropKey::StoreExtensions]);
+          if (optionStoreExtensions.isObject() && optionStoreExtensions.asObject(runtime).isArray(runtime)) {
+            jsi::Array extensions = optionStoreExtensions.asObject(runtime).asArray(runtime);
+            size_t extensionsSize = extensions.size(runtime);
+            zipOptions.storeExtensions.clear();
+            for (size_t i = 0; i < extensionsSize; i++) {
+              jsi::Value extension = extensions.getValueAtIndex(runtime, i);
+              if (!extension.isString()) [[unlikely]] {
+                throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "zip", "'storeExtensions' has to be an array of strings"));
+              }
+              zipOptions.storeExtensions.push_back(extension.asString(runtime).utf8(runtime));
+            }
+          }
+        }
+
+        if (count < 4 || !arguments[3].isObject()) {
+          ArchiveResult archiveResult;
+          try {
+            archiveResult = zipDirectory(srcDir, archivePath, zipOptions);
+          } catch (const char* error_message) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", srcDir.c_str(), "zip", error_message));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", srcDir.c_str(), "zip", e.what()));
+          }
+          statCache.invalidate(archivePath);
+          jsi::Object result = jsi::Object(runtime);
+          result.setProperty(runtime, names[PropKey::Files], jsi::Value(static_cast<double>(archiveResult.files)));
+          result.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(archiveResult.size)));
+          return result;
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 4 && arguments[4].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[4].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        std::thread([&runtime, this, jobId, srcDir, archivePath, zipOptions, completeFunc, errorFunc]() {
+          std::string errorMessage;
+          ArchiveResult archiveResult;
+          try {
+            archiveResult = zipDirectory(srcDir, archivePath, zipOptions);
+          } catch (const char* error_message) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", srcDir.c_str(), "zip", error_message);
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", srcDir.c_str(), "zip", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, jobId, archivePath, archiveResult, errorMessage, completeFunc, errorFunc]() {
+            statCache.invalidate(archivePath);
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Object result = jsi::Object(runtime);
+            result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+            result.setProperty(runtime, names[PropKey::Files], jsi::Value(static_cast<double>(archiveResult.files)));
+            result.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(archiveResult.size)));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Tar) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "tar", "First argument ('srcDir') has to be of type string"));
+        }
+        if (count < 2 || !arguments[1].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "tar", "Second argument ('archivePath') has to be of type string"));
+        }
+        if (count > 4) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "tar", "Too many arguments"));
+        }
+
+        std::string srcDir = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::string archivePath = cleanPath(arguments[1].asString(runtime).utf8(runtime));
+        if (srcDir.size() > 1 && srcDir.back() == '/') {
+          srcDir.pop_back();
+        }
+
+        const RNFSTurboPropNames& names = *propNames;
+        if (count < 3 || !arguments[2].isObject()) {
+          ArchiveResult archiveResult;
+          try {
+            archiveResult = tarDirectory(srcDir, archivePath);
+          } catch (const char* error_message) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", srcDir.c_str(), "tar", error_message));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", srcDir.c_str(), "tar", e.what()));
+          }
+          statCache.invalidate(archivePath);
+          jsi::Object result = jsi::Object(runtime);
+          result.setProperty(runtime, names[PropKey::Files], jsi::Value(static_cast<double>(archiveResult.files)));
+          result.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(archiveResult.size)));
+          return result;
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[2].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 3 && arguments[3].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        std::thread([&runtime, this, jobId, srcDir, archivePath, completeFunc, errorFunc]() {
+          std::string errorMessage;
+          ArchiveResult archiveResult;
+          try {
+            archiveResult = tarDirectory(srcDir, archivePath);
+          } catch (const char* error_message) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", srcDir.c_str(), "tar", error_message);
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", srcDir.c_str(), "tar", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, jobId, archivePath, archiveResult, errorMessage, completeFunc, errorFunc]() {
+            statCache.invalidate(archivePath);
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Object result = jsi::Object(runtime);
+            result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+            result.setProperty(runtime, names[PropKey::Files], jsi::Value(static_cast<double>(archiveResult.files)));
+            result.setProperty(runtime, names[PropKey::Size], jsi::Value(static_cast<double>(archiveResult.size)));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::DeriveKey) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !(arguments[0].isString() || arguments[0].isObject())) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "deriveKey", "First argument ('secret') has to be of type string or number[]"));
+        }
+        if (count < 2 || !arguments[1].isObject()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "deriveKey", "Second argument ('options') has to be of type object"));
+        }
+        if (count > 4) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "deriveKey", "Too many arguments"));
+        }
+
+        const RNFSTurboPropNames& names = *propNames;
+        // A key handle allows HKDF over a PBKDF2 key, e.g. one key per file from a single passphrase
+        std::vector<uint8_t> secret = readKeyBytes(runtime, "deriveKey", "secret", arguments[0]);
+        KdfOptions kdfOptions = parseKdfOptions(runtime, "deriveKey", names, arguments[1].asObject(runtime));
+
+        if (count < 3 || !arguments[2].isObject()) {
+          std::vector<uint8_t> key;
+          try {
+            key = deriveKey(secret, kdfOptions);
+          } catch (const char* error_message) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "deriveKey", error_message));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "deriveKey", e.what()));
+          }
+          return jsi::Object::createFromHostObject(runtime, std::make_shared<RNFSTurboKeyHostObject>(std::move(key)));
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[2].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 3 && arguments[3].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        std::thread([&runtime, this, jobId, secret = std::move(secret), kdfOptions, completeFunc, errorFunc]() {
+          std::string errorMessage;
+          std::shared_ptr<RNFSTurboKeyHostObject> key;
+          try {
+            key = std::make_shared<RNFSTurboKeyHostObject>(deriveKey(secret, kdfOptions));
+          } catch (const char* error_message) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s", "deriveKey", error_message);
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s", "deriveKey", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, jobId, key, errorMessage, completeFunc, errorFunc]() {
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Object result = jsi::Object(runtime);
+            result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+            result.setProperty(runtime, names[PropKey::Key], jsi::Object::createFromHostObject(runtime, key));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Hash) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 2 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hash", "First argument ('filepath') has to be of type string"));
+        }
+        if (count < 2 || !arguments[1].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hash", "Second argument ('algorithm') has to be of type string"));
+        }
+
+        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::string algorithm = arguments[1].asString(runtime).utf8(runtime);
+        double offset{0};
+        double length{0};
+        if (count > 2 && arguments[2].isObject()) {
+          const RNFSTurboPropNames& names = *propNames;
+          auto optionsObject = arguments[2].asObject(runtime);
+          auto offsetOption = optionsObject.getProperty(runtime, names[PropKey::Offset]);
+          if (offsetOption.isNumber()) {
+            offset = offsetOption.asNumber();
+          }
+          auto lengthOption = optionsObject.getProperty(runtime, names[PropKey::Length]);
+          if (lengthOption.isNumber()) {
+            length = lengthOption.asNumber();
+          }
+        }
+        if (offset < 0 || length < 0) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hash", "Offset and length can't be negative"));
+        }
+
+        std::unique_ptr<Hasher> hasher;
+        std::string digest;
+        try {
+          hasher = Hasher::create(algorithm);
+          if (hasher != nullptr && algorithm == "blake3") {
+            digest = hashFileBlake3(filePath, static_cast<uint64_t>(offset), static_cast<uint64_t>(length));
+          } else if (hasher != nullptr) {
+            hashFile(filePath, *hasher, static_cast<uint64_t>(offset), static_cast<uint64_t>(length));
+            digest = hasher->hexDigest();
+          }
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "hash", error_message));
+        } catch (const std::exception& e) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "hash", e.what()));
+        }
+        if (hasher == nullptr) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "hash", "Wrong algorithm", algorithm.c_str()));
+        }
+        return jsi::String::createFromUtf8(runtime, digest);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Hmac) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      3,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hmac", "First argument ('filepath') has to be of type string"));
+        }
+        if (count < 2 || !(arguments[1].isString() || arguments[1].isObject())) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hmac", "Second argument ('key') has to be of type string, number[] or a derived key"));
+        }
+        if (count < 3 || !arguments[2].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hmac", "Third argument ('algorithm') has to be of type string"));
+        }
+
+        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::vector<uint8_t> key = readKeyBytes(runtime, "hmac", "key", arguments[1]);
+        std::string algorithm = arguments[2].asString(runtime).utf8(runtime);
+
+        std::unique_ptr<Hasher> hmac;
+        std::string digest;
+        try {
+          hmac = Hasher::createHmac(algorithm, key.data(), key.size());
+          if (hmac != nullptr) {
+            hashFile(filePath, *hmac);
+            digest = hmac->hexDigest();
+          }
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "hmac", error_message));
+        } catch (const std::exception& e) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "hmac", e.what()));
+        }
+        if (hmac == nullptr) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "hmac", "Wrong algorithm", algorithm.c_str()));
+        }
+        return jsi::String::createFromUtf8(runtime, digest);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::VerifyHmac) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      4,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "verifyHmac", "First argument ('filepath') has to be of type string"));
+        }
+        if (count < 2 || !(arguments[1].isString() || arguments[1].isObject())) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "verifyHmac", "Second argument ('key') has to be of type string, number[] or a derived key"));
+        }
+        if (count < 3 || !arguments[2].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "verifyHmac", "Third argument ('algorithm') has to be of type string"));
+        }
+        if (count < 4 || !(arguments[3].isString() || arguments[3].isObject())) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "verifyHmac", "Fourth argument ('expected') has to be a hex string or number[]"));
+        }
+
+        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        std::vector<uint8_t> key = readKeyBytes(runtime, "verifyHmac", "key", arguments[1]);
+        std::string algorithm = arguments[2].asString(runtime).utf8(runtime);
+
+        std::vector<uint8_t> expected;
+        if (arguments[3].isString()) {
+          std::string hex = arguments[3].asString(runtime).utf8(runtime);
+          if (hex.size() % 2 != 0 || hex.find_first_not_of("0123456789abcdefABCDEF") != std::string::npos) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "verifyHmac", "Fourth argument ('expected') has to be a hex string or number[]"));
+          }
+          expected.reserve(hex.size() / 2);
+          for (size_t i = 0; i < hex.size(); i += 2) {
+            expected.push_back(static_cast<uint8_t>(std::stoi(hex.substr(i, 2), nullptr, 16)));
+          }
+        } else {
+          expected = readBytesOption(runtime, "verifyHmac", "expected", arguments[3]);
+        }
+
+        int64_t expectedFileSize = -1;
+        if (count > 4 && arguments[4].isObject()) {
+          const RNFSTurboPropNames& names = *propNames;
+          auto sizeOption = arguments[4].asObject(runtime).getProperty(runtime, names[PropKey::Size]);
+          if (sizeOption.isNumber()) {
+            expectedFileSize = static_cast<int64_t>(sizeOption.asNumber());
+          }
+        }
+
+        try {
+          return jsi::Value(verifyFileHmac(filePath, algorithm, key, expected, expectedFileSize));
+        } catch (const char* error_message) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "verifyHmac", error_message));
+        } catch (const std::exception& e) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "verifyHmac", e.what()));
+        }
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::HashData) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 2 || !arguments[1].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hashData", "Second argument ('algorithm') has to be of type string"));
+        }
+        if (count > 4) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "hashData", "Too many arguments"));
+        }
+
+        std::string stringStorage;
+        auto [data, length] = getDataArgument(runtime, arguments[0], "hashData", stringStorage);
+        std::string algorithm = arguments[1].asString(runtime).utf8(runtime);
+        std::shared_ptr<Hasher> hasher = Hasher::create(algorithm);
+        if (hasher == nullptr) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "hashData", "Wrong algorithm", algorithm.c_str()));
+        }
+
+        if (count < 3 || !arguments[2].isObject()) {
+          hasher->update(data, length);
+          return jsi::String::createFromUtf8(runtime, hasher->hexDigest());
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[2].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 3 && arguments[3].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        // The JS value can't be touched off the JS thread
+        std::thread([&runtime, this, jobId, bytes = std::vector<uint8_t>(data, data + length), hasher, completeFunc, errorFunc]() {
+          std::string errorMessage;
+          std::string digest;
+          try {
+            hasher->update(bytes.data(), bytes.size());
+            digest = hasher->hexDigest();
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s", "hashData", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, jobId, digest, errorMessage, completeFunc, errorFunc]() {
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Object result = jsi::Object(runtime);
+            result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+            result.setProperty(runtime, names[PropKey::Digest], jsi::String::createFromUtf8(runtime, digest));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::EncryptData) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+#ifdef RNFSTURBO_USE_ENCRYPTION
+        if (count < 2 || !arguments[1].isObject()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "encryptData", "Second argument ('options') has to be of type object"));
+        }
+        if (count > 4) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "encryptData", "Too many arguments"));
+        }
+
+        std::string stringStorage;
+        auto [data, length] = getDataArgument(runtime, arguments[0], "encryptData", stringStorage);
+        const RNFSTurboPropNames& names = *propNames;
+        jsi::Object optionsObject = arguments[1].asObject(runtime);
+        std::vector<unsigned char> iv;
+        std::shared_ptr<Mode::MODE> cipher = getDataCipher(runtime, names, "encryptData", optionsObject, iv);
+
+        if (count < 3 || !arguments[2].isObject()) {
+          try {
+            // Encrypted straight from the JS string or ArrayBuffer into the result
+            auto buffer = std::make_shared<RNFSTurboBuffer>(cipher->encryptedLength(length));
+            encryptBuffer(*cipher, data, length, buffer->data(), iv);
+            return jsi::ArrayBuffer(runtime, buffer);
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "encryptData", e.what()));
+          }
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[2].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 3 && arguments[3].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        }
+
+        // Copied with room for the padding, then encrypted in place off the JS thread
+        std::vector<uint8_t> bytes;
+        bytes.reserve(length + cipher->Encryption->BLOCK_SIZE);
+        bytes.assign(data, data + length);
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        std::thread([&runtime, this, jobId, bytes = std::move(bytes), cipher, iv, completeFunc, errorFunc]() mutable {
+          std::string errorMessage;
+          std::shared_ptr<RNFSTurboBuffer> buffer;
+          try {
+            size_t plainLength = bytes.size();
+            bytes.resize(cipher->encryptedLength(plainLength));
+            encryptBuffer(*cipher, bytes.data(), plainLength, bytes.data(), iv);
+            buffer = std::make_shared<RNFSTurboBuffer>(std::move(bytes));
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s", "encryptData", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, jobId, buffer, errorMessage, completeFunc, errorFunc]() {
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Object result = jsi::Object(runtime);
+            result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+            result.setProperty(runtime, names[PropKey::Data], jsi::ArrayBuffer(runtime, buffer));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+#else
+        throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "encryptData", "Encryption is disabled"));
+#endif
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::DecryptData) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+#ifdef RNFSTURBO_USE_ENCRYPTION
+        if (count < 1 || !arguments[0].isObject() || !arguments[0].asObject(runtime).isArrayBuffer(runtime)) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "decryptData", "First argument ('data') has to be of type ArrayBuffer"));
+        }
+        if (count < 2 || !arguments[1].isObject()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "decryptData", "Second argument ('options') has to be of type object"));
+        }
+        if (count > 4) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "decryptData", "Too many arguments"));
+        }
+
+        const RNFSTurboPropNames& names = *propNames;
+        jsi::Object optionsObject = arguments[1].asObject(runtime);
+        std::vector<unsigned char> iv;
+        std::shared_ptr<Mode::MODE> cipher = getDataCipher(runtime, names, "decryptData", optionsObject, iv);
+        std::string encoding;
+        auto encodingOption = optionsObject.getProperty(runtime, names[PropKey::Encoding]);
+        if (encodingOption.isString()) {
+          encoding = encodingOption.asString(runtime).utf8(runtime);
+          if (encoding != "utf8" && encoding != "base64") {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "decryptData", "Only utf8 and base64 encodings allowed"));
+          }
+        }
+
+        // The ArrayBuffer of the caller isn't modified, the copy is decrypted in place
+        jsi::ArrayBuffer arrayBuffer = arguments[0].asObject(runtime).getArrayBuffer(runtime);
+        const uint8_t* data = arrayBuffer.data(runtime);
+        std::vector<uint8_t> bytes(data, data + arrayBuffer.size(runtime));
+
+        if (count < 3 || !arguments[2].isObject()) {
+          try {
+            bytes.resize(decryptBuffer(*cipher, bytes.data(), bytes.size(), iv));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "decryptData", e.what()));
+          }
+          return createDataResult(runtime, std::move(bytes), encoding);
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[2].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 3 && arguments[3].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        std::thread([&runtime, this, jobId, bytes = std::make_shared<std::vector<uint8_t>>(std::move(bytes)), cipher, iv, encoding, completeFunc, errorFunc]() {
+          std::string errorMessage;
+          try {
+            bytes->resize(decryptBuffer(*cipher, bytes->data(), bytes->size(), iv));
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s", "decryptData", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, jobId, bytes, encoding, errorMessage, completeFunc, errorFunc]() {
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Object result = jsi::Object(runtime);
+            result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+            result.setProperty(runtime, names[PropKey::Data], createDataResult(runtime, std::move(*bytes), encoding));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+#else
+        throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "decryptData", "Encryption is disabled"));
+#endif
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::ChunkManifest) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      2,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "chunkManifest", "First argument ('filepath') has to be of type string"));
+        }
+        if (count < 2 || !arguments[1].isObject()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "chunkManifest", "Second argument ('options') has to be of type object"));
+        }
+        if (count > 4) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "chunkManifest", "Too many arguments"));
+        }
+
+        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+        const RNFSTurboPropNames& names = *propNames;
+        jsi::Object optionsObject = arguments[1].asObject(runtime);
+        jsi::Value chunkSizeOption = optionsObject.getProperty(runtime, names[PropKey::ChunkSize]);
+        if (!chunkSizeOption.isNumber() || chunkSizeOption.asNumber() < 1) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "chunkManifest", "Option 'chunkSize' has to be a positive number"));
+        }
+        uint64_t chunkSize = static_cast<uint64_t>(chunkSizeOption.asNumber());
+        jsi::Value algorithmOption = optionsObject.getProperty(runtime, names[PropKey::Algorithm]);
+        std::string algorithm = algorithmOption.isString() ? algorithmOption.asString(runtime).utf8(runtime) : "";
+        if (Hasher::create(algorithm) == nullptr) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", "chunkManifest", "Wrong algorithm", algorithm.c_str()));
+        }
+
+        if (count < 3 || !arguments[2].isObject()) {
+          ChunkManifest manifest;
+          try {
+            manifest = buildChunkManifest(filePath, algorithm, chunkSize);
+          } catch (const char* error_message) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "chunkManifest", error_message));
+          } catch (const std::exception& e) {
+            throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "chunkManifest", e.what()));
+          }
+          return createChunkManifestResult(runtime, names, std::move(manifest), chunkSize);
+        }
+
+        std::shared_ptr<jsi::Function> completeFunc = std::make_shared<jsi::Function>(arguments[2].asObject(runtime).asFunction(runtime));
+        std::shared_ptr<jsi::Function> errorFunc;
+        if (count > 3 && arguments[3].isObject()) {
+          errorFunc = std::make_shared<jsi::Function>(arguments[3].asObject(runtime).asFunction(runtime));
+        }
+
+        RNFSTurboPlatformHelper::jobId += 1;
+        int jobId = RNFSTurboPlatformHelper::jobId;
+
+        std::thread([&runtime, this, jobId, filePath, algorithm, chunkSize, completeFunc, errorFunc]() {
+          std::string errorMessage;
+          auto manifest = std::make_shared<ChunkManifest>();
+          try {
+            *manifest = buildChunkManifest(filePath, algorithm, chunkSize);
+          } catch (const char* error_message) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "chunkManifest", error_message);
+          } catch (const std::exception& e) {
+            errorMessage = RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "chunkManifest", e.what());
+          }
+          _jsInvoker->invokeAsync([&runtime, this, jobId, manifest, chunkSize, errorMessage, completeFunc, errorFunc]() {
+            if (!errorMessage.empty()) {
+              if (errorFunc != nullptr) {
+                jsi::Object result = jsi::Object(runtime);
+                result.setProperty(runtime, "jobId", jsi::Value(jobId));
+                result.setProperty(runtime, "errorMessage", jsi::String::createFromUtf8(runtime, errorMessage));
+                errorFunc->call(runtime, std::move(result));
+              }
+              return;
+            }
+            const RNFSTurboPropNames& names = *propNames;
+            jsi::Object result = createChunkManifestResult(runtime, names, std::move(*manifest), chunkSize);
+            result.setProperty(runtime, names[PropKey::JobId], jsi::Value(jobId));
+            completeFunc->call(runtime, std::move(result));
+          });
+        }).detach();
+
+        return jsi::Value(jobId);
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Touch) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if (count < 1 || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "touch", "First argument ('filepath') has to be of type string"));
+        }
+        if (count > 3) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "touch", "Too many arguments"));
+        }
+
+        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+
+        long int mtime{0};
+        bool isMTime{false};
+        if (count > 1 && arguments[1].isNumber()) {
+          mtime = arguments[1].asNumber() / 1000;
+          isMTime = true;
+        }
+        long int ctime{0};
+        bool isCTime{false};
+        if (count > 2 && arguments[2].isNumber()) {
+          ctime = arguments[2].asNumber() / 1000;
+          isCTime = true;
+        }
+
+        struct stat t_stat;
+        int res = stat(filePath.c_str(), &t_stat);
+        if (res < 0) {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s: %s", filePath.c_str(), "touch", strerror(errno)));
+        }
+
+        if (isMTime) {
+          struct utimbuf new_times;
+          new_times.modtime = mtime > 0 ? mtime : std::time(0);
+          new_times.actime = mtime > 0 ? mtime : std::time(0);
+          statCache.invalidate(filePath);
+          utime(filePath.c_str(), &new_times);
+        }
+        if (isCTime) {
+          // Not available
+        }
+        stat(filePath.c_str(), &t_stat);
+
+        return jsi::Value(static_cast<int>(t_stat.st_mtime));
+      }
+    );
+  }
+  if (method == RNFSTurboMethod::Mkdir) {
+    return jsi::Function::createFromHostFunction(
+      runtime, jsi::PropNameID::forAscii(runtime, propName),
+      1,
+      [this](jsi::Runtime& runtime, const jsi::Value& thisValue, const jsi::Value* arguments, size_t count) -> jsi::Value {
+        if ((count != 1 && count != 2) || !arguments[0].isString()) [[unlikely]] {
+          throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", "mkdir", "First argument ('filepath') has to be of type string"));
+        }
+
+        std::string filePath = cleanPath(arguments[0].asString(runtime).utf8(runtime));
+
+        std::map<std::string, std::string> options;
+        if (count == 2 && arguments[1].isObject()) {
+          auto optionsObject = arguments[1].asObject(runtime);
+#ifdef __APPLE__
+          auto protectionOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::NSFileProtectionKey]);
+          if (protectionOption.isString()) {
+            options["NSFileProtectionKey"] = protectionOption.asString(runtime).utf8(runtime);
+          }
+          auto excludeFromBackupOption = optionsObject.getProperty(runtime, (*propNames)[PropKey::NSURLIsExcludedFromBackupKey]);
+          if (excludeFromBackupOption.isBool()) {
+            options["NSURLIsExcludedFromBackupKey"] = excludeFromBackupOption.getBool() ? "YES" : "NO";
           }
 #endif
         }
 
         try {
+          statCache.invalidate(filePath);
           fs::create_directories(filePath);
 
 #ifdef __APPLE__
@@ -1196,7 +2930,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "downloadFile") {
+  if (method == RNFSTurboMethod::DownloadFile) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1330,7 +3064,8 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
         RNFSTurboPlatformHelper::jobId += 1;
         int jobId = RNFSTurboPlatformHelper::jobId;
         
-        RNFSTurboCompleteDownloadCallback completeCallback = [&runtime, completeFunc, this](int jobId, int statusCode, float bytesWritten) -> void {
+        RNFSTurboCompleteDownloadCallback completeCallback = [&runtime, completeFunc, this, toFile](int jobId, int statusCode, float bytesWritten) -> void {
+          statCache.invalidate(toFile);
           _jsInvoker->invokeAsync([&runtime, completeFunc, jobId, statusCode, bytesWritten]() {
             jsi::Object result = jsi::Object(runtime);
             result.setProperty(runtime, "jobId", jsi::Value(jobId));
@@ -1412,7 +3147,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "stopDownload") {
+  if (method == RNFSTurboMethod::StopDownload) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1429,7 +3164,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "resumeDownload") {
+  if (method == RNFSTurboMethod::ResumeDownload) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1449,7 +3184,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "isResumable") {
+  if (method == RNFSTurboMethod::IsResumable) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1469,7 +3204,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "completeHandlerIOS") {
+  if (method == RNFSTurboMethod::CompleteHandlerIOS) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1489,7 +3224,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "uploadFiles") {
+  if (method == RNFSTurboMethod::UploadFiles) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1681,7 +3416,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "stopUpload") {
+  if (method == RNFSTurboMethod::StopUpload) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1698,7 +3433,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "getFSInfo") {
+  if (method == RNFSTurboMethod::GetFSInfo) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1734,7 +3469,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "scanFile") {
+  if (method == RNFSTurboMethod::ScanFile) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1777,7 +3512,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "getAllExternalFilesDirs") {
+  if (method == RNFSTurboMethod::GetAllExternalFilesDirs) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1817,7 +3552,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
       }
     );
   }
-  if (propName == "pathForGroup") {
+  if (method == RNFSTurboMethod::PathForGroup) {
     return jsi::Function::createFromHostFunction(
       runtime, jsi::PropNameID::forAscii(runtime, propName),
       1,
@@ -1844,7 +3579,7 @@ jsi::Value RNFSTurboHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID
     );
   }
 
-  return jsi::Value::undefined();
+  throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Unknown method"));
 }
 
 }
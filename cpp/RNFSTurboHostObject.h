@@ -11,6 +11,7 @@
 #include <filesystem>
 #include <jsi/jsi.h>
 #include <map>
+#include <memory>
 #include <stdio.h>
 #include <string>
 #include <sys/stat.h>
@@ -23,18 +24,33 @@
 #include <jni.h>
 #endif
 #include "algorithms/base64.h"
-#include "algorithms/md5.h"
-#include "algorithms/sha1.h"
-#include "algorithms/sha224.h"
-#include "algorithms/sha256.h"
-#include "algorithms/sha384.h"
-#include "algorithms/sha512.h"
+#include "algorithms/hasher.h"
 #ifdef RNFSTURBO_USE_ENCRYPTION
 #include "algorithms/Krypt/aes-config.hpp"
+#include "encryption/chunked-encryption.h"
+#include "encryption/decrypt-stage.h"
 #include "encryption/encryption-utils.h"
 #endif
+#include "filesystem/allocate-utils.h"
+#include "filesystem/archive-utils.h"
+#include "filesystem/cache-hints.h"
+#include "filesystem/compressed-io.h"
+#include "filesystem/copy-utils.h"
+#include "filesystem/dir-watcher.h"
+#include "filesystem/du-utils.h"
 #include "filesystem/filesystem-utils.h"
+#include "filesystem/hash-utils.h"
+#include "filesystem/stat-cache.h"
+#include "filesystem/stat-utils.h"
+#include "filesystem/transform-pipeline.h"
+#include "filesystem/unzip-utils.h"
+#include "filesystem/walk-utils.h"
+#include "RNFSTurboBuffer.h"
+#include "RNFSTurboDirCursorHostObject.h"
+#include "RNFSTurboKeyHostObject.h"
+#include "RNFSTurboMethods.h"
 #include "RNFSTurboPlatformHelper.h"
+#include "RNFSTurboPropNames.h"
 
 namespace cmpayc::rnfsturbo {
 
@@ -50,8 +66,17 @@ public:
   std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override;
   std::shared_ptr<react::CallInvoker> _jsInvoker;
 
+private:
+  jsi::Function createHostFunction(jsi::Runtime& runtime, RNFSTurboMethod method, const std::string& propName);
+
 private:
   RNFSTurboPlatformHelper* platformHelper;
+  // A host object is installed once per runtime, so the interned names belong to that runtime
+  std::shared_ptr<RNFSTurboPropNames> propNames;
+  // Keyed by watch id, only touched on the JS thread
+  std::map<int, std::unique_ptr<DirWatcher>> watchers;
+  StatCache statCache;
+  std::vector<std::unique_ptr<DirWatcher>> statCacheWatchers;
 };
 
 }
@@ -0,0 +1,146 @@
+//
+//  RNFSTurboKeyHostObject.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include "RNFSTurboKeyHostObject.h"
+#include "RNFSTurboLogger.h"
+#include "algorithms/kdf.h"
+
+namespace cmpayc::rnfsturbo {
+
+using namespace facebook;
+
+// Upper bound for PBKDF2, a typo shouldn't hang the app for hours
+static constexpr double kMaxIterations = 100000000;
+
+std::vector<uint8_t> readBytesOption(
+  jsi::Runtime& runtime,
+  const std::string& propName,
+  const char* optionName,
+  const jsi::Value& value
+) {
+  std::vector<uint8_t> bytes;
+  if (value.isString()) {
+    std::string string = value.asString(runtime).utf8(runtime);
+    bytes.assign(string.begin(), string.end());
+    return bytes;
+  }
+  if (value.isObject() && value.asObject(runtime).isArray(runtime)) {
+    jsi::Array array = value.asObject(runtime).asArray(runtime);
+    size_t length = array.size(runtime);
+    bytes.reserve(length);
+    for (size_t i = 0; i < length; i++) {
+      jsi::Value element = array.getValueAtIndex(runtime, i);
+      if (!element.isNumber()) {
+        throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s %s", propName.c_str(), optionName, "has to be of type string or number[]"));
+      }
+      bytes.push_back(static_cast<uint8_t>(element.asNumber()));
+    }
+    return bytes;
+  }
+  throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s %s", propName.c_str(), optionName, "has to be of type string or number[]"));
+}
+
+std::vector<uint8_t> readKeyBytes(
+  jsi::Runtime& runtime,
+  const std::string& propName,
+  const char* optionName,
+  const jsi::Value& value
+) {
+  if (value.isObject() && value.asObject(runtime).isHostObject<RNFSTurboKeyHostObject>(runtime)) {
+    return value.asObject(runtime).getHostObject<RNFSTurboKeyHostObject>(runtime)->key();
+  }
+  return readBytesOption(runtime, propName, optionName, value);
+}
+
+KdfOptions parseKdfOptions(
+  jsi::Runtime& runtime,
+  const std::string& propName,
+  const RNFSTurboPropNames& names,
+  const jsi::Object& options
+) {
+  KdfOptions kdfOptions;
+  auto algorithmOption = options.getProperty(runtime, names[PropKey::Algorithm]);
+  if (algorithmOption.isString()) {
+    kdfOptions.algorithm = algorithmOption.asString(runtime).utf8(runtime);
+  }
+  if (kdfOptions.algorithm != "pbkdf2" && kdfOptions.algorithm != "hkdf") {
+    throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Only pbkdf2 and hkdf key derivation allowed"));
+  }
+  auto saltOption = options.getProperty(runtime, names[PropKey::Salt]);
+  if (!saltOption.isUndefined()) {
+    kdfOptions.salt = readBytesOption(runtime, propName, "salt", saltOption);
+  } else if (kdfOptions.algorithm == "pbkdf2") {
+    throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "pbkdf2 requires a salt"));
+  }
+  if (kdfOptions.algorithm == "pbkdf2") {
+    auto iterationsOption = options.getProperty(runtime, names[PropKey::Iterations]);
+    if (!iterationsOption.isNumber() || iterationsOption.asNumber() < 1 || iterationsOption.asNumber() > kMaxIterations) {
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "pbkdf2 requires iterations between 1 and 100000000"));
+    }
+    kdfOptions.iterations = static_cast<uint32_t>(iterationsOption.asNumber());
+  } else {
+    auto infoOption = options.getProperty(runtime, names[PropKey::Info]);
+    if (!infoOption.isUndefined()) {
+      kdfOptions.info = readBytesOption(runtime, propName, "info", infoOption);
+    }
+  }
+  auto keyLengthOption = options.getProperty(runtime, names[PropKey::KeyLength]);
+  if (keyLengthOption.isNumber()) {
+    double keyLength = keyLengthOption.asNumber();
+    if (keyLength != 16 && keyLength != 24 && keyLength != 32) {
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Key length should be 16, 24 or 32"));
+    }
+    kdfOptions.keyLength = static_cast<size_t>(keyLength);
+  }
+  return kdfOptions;
+}
+
+std::vector<uint8_t> deriveKey(const std::vector<uint8_t>& secret, const KdfOptions& options) {
+  std::vector<uint8_t> key(options.keyLength);
+  if (options.algorithm == "pbkdf2") {
+    pbkdf2Sha256(
+      secret.data(), secret.size(),
+      options.salt.data(), options.salt.size(),
+      options.iterations,
+      key.data(), key.size()
+    );
+  } else {
+    hkdfSha256(
+      secret.data(), secret.size(),
+      options.salt.data(), options.salt.size(),
+      options.info.data(), options.info.size(),
+      key.data(), key.size()
+    );
+  }
+  return key;
+}
+
+RNFSTurboKeyHostObject::RNFSTurboKeyHostObject(std::vector<uint8_t> key) : keyBytes(std::move(key)) {}
+
+RNFSTurboKeyHostObject::~RNFSTurboKeyHostObject() {
+  // volatile so the wipe isn't optimized away as a dead store
+  volatile uint8_t* bytes = keyBytes.data();
+  for (size_t i = 0; i < keyBytes.size(); i++) {
+    bytes[i] = 0;
+  }
+}
+
+std::vector<jsi::PropNameID> RNFSTurboKeyHostObject::getPropertyNames(jsi::Runtime& rt) {
+  std::vector<jsi::PropNameID> names;
+  names.push_back(jsi::PropNameID::forAscii(rt, "length"));
+  return names;
+}
+
+jsi::Value RNFSTurboKeyHostObject::get(jsi::Runtime& runtime, const jsi::PropNameID& propNameId) {
+  std::string propName = propNameId.utf8(runtime);
+  if (propName == "length") {
+    return jsi::Value(static_cast<int>(keyBytes.size()));
+  }
+  return jsi::Value::undefined();
+}
+
+}
@@ -0,0 +1,77 @@
+//
+//  RNFSTurboKeyHostObject.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <jsi/jsi.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "RNFSTurboPropNames.h"
+
+namespace cmpayc::rnfsturbo {
+
+using namespace facebook;
+
+struct KdfOptions {
+  // pbkdf2 or hkdf
+  std::string algorithm;
+  std::vector<uint8_t> salt;
+  // hkdf only
+  std::vector<uint8_t> info;
+  // pbkdf2 only
+  uint32_t iterations{0};
+  size_t keyLength{32};
+};
+
+// Reads { algorithm, salt, iterations, info, keyLength }, throws a JSError for invalid options
+KdfOptions parseKdfOptions(
+  jsi::Runtime& runtime,
+  const std::string& propName,
+  const RNFSTurboPropNames& names,
+  const jsi::Object& options
+);
+
+// Reads a string (its UTF-8 bytes) or a number[] option
+std::vector<uint8_t> readBytesOption(
+  jsi::Runtime& runtime,
+  const std::string& propName,
+  const char* optionName,
+  const jsi::Value& value
+);
+
+// Reads a string, a number[] or a key handle returned by deriveKey
+std::vector<uint8_t> readKeyBytes(
+  jsi::Runtime& runtime,
+  const std::string& propName,
+  const char* optionName,
+  const jsi::Value& value
+);
+
+// Runs PBKDF2-HMAC-SHA256 or HKDF-SHA256 over secret, may take a while with many iterations
+std::vector<uint8_t> deriveKey(const std::vector<uint8_t>& secret, const KdfOptions& options);
+
+// Opaque JS handle of a key returned by deriveKey, the key bytes are never exposed to JS.
+// It is accepted wherever a passphrase is, the key is wiped when the handle is garbage collected
+class RNFSTurboKeyHostObject : public jsi::HostObject {
+public:
+  explicit RNFSTurboKeyHostObject(std::vector<uint8_t> key);
+  ~RNFSTurboKeyHostObject() override;
+
+  const std::vector<uint8_t>& key() const {
+    return keyBytes;
+  }
+
+public:
+  jsi::Value get(jsi::Runtime&, const jsi::PropNameID& name) override;
+  std::vector<jsi::PropNameID> getPropertyNames(jsi::Runtime& rt) override;
+
+private:
+  std::vector<uint8_t> keyBytes;
+};
+
+}
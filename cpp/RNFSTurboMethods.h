@@ -0,0 +1,239 @@
+//
+//  RNFSTurboMethods.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace cmpayc::rnfsturbo {
+
+enum class RNFSTurboMethod : uint8_t {
+  Stat,
+  ReadDir,
+  ReadDirAssets,
+  Readdir,
+  ReadFile,
+  Read,
+  ReadFileAssets,
+  ReadFileRes,
+  WriteFile,
+  AppendFile,
+  Write,
+  MoveFile,
+  CopyFolder,
+  CopyFile,
+  CopyFileAssets,
+  CopyFileRes,
+  CopyAssetsFileIOS,
+  CopyAssetsVideoIOS,
+  Unlink,
+  Exists,
+  ExistsAssets,
+  ExistsRes,
+  Hash,
+  Touch,
+  Mkdir,
+  DownloadFile,
+  StopDownload,
+  ResumeDownload,
+  IsResumable,
+  CompleteHandlerIOS,
+  UploadFiles,
+  StopUpload,
+  GetFSInfo,
+  ScanFile,
+  GetAllExternalFilesDirs,
+  PathForGroup,
+  StatMany,
+  ExistsMany,
+  Walk,
+  Du,
+  OpenDir,
+  Watch,
+  Unwatch,
+  ConfigureStatCache,
+  GetStatCacheStats,
+  Allocate,
+  Prefetch,
+  Evict,
+  Pipeline,
+  Unzip,
+  Zip,
+  Tar,
+  DeriveKey,
+  Hmac,
+  VerifyHmac,
+  HashData,
+  EncryptData,
+  DecryptData,
+  ChunkManifest,
+  Count,
+  Unknown = Count,
+};
+
+inline constexpr size_t kRNFSTurboMethodCount = static_cast<size_t>(RNFSTurboMethod::Count);
+
+// Indexed by RNFSTurboMethod
+inline constexpr std::array<std::string_view, kRNFSTurboMethodCount> kRNFSTurboMethodNames = {
+  "stat",
+  "readDir",
+  "readDirAssets",
+  "readdir",
+  "readFile",
+  "read",
+  "readFileAssets",
+  "readFileRes",
+  "writeFile",
+  "appendFile",
+  "write",
+  "moveFile",
+  "copyFolder",
+  "copyFile",
+  "copyFileAssets",
+  "copyFileRes",
+  "copyAssetsFileIOS",
+  "copyAssetsVideoIOS",
+  "unlink",
+  "exists",
+  "existsAssets",
+  "existsRes",
+  "hash",
+  "touch",
+  "mkdir",
+  "downloadFile",
+  "stopDownload",
+  "resumeDownload",
+  "isResumable",
+  "completeHandlerIOS",
+  "uploadFiles",
+  "stopUpload",
+  "getFSInfo",
+  "scanFile",
+  "getAllExternalFilesDirs",
+  "pathForGroup",
+  "statMany",
+  "existsMany",
+  "walk",
+  "du",
+  "openDir",
+  "watch",
+  "unwatch",
+  "configureStatCache",
+  "getStatCacheStats",
+  "allocate",
+  "prefetch",
+  "evict",
+  "pipeline",
+  "unzip",
+  "zip",
+  "tar",
+  "deriveKey",
+  "hmac",
+  "verifyHmac",
+  "hashData",
+  "encryptData",
+  "decryptData",
+  "chunkManifest",
+};
+
+// FNV-1a, usable in case labels
+constexpr uint32_t methodNameHash(std::string_view name) {
+  uint32_t hash = 2166136261u;
+  for (char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+constexpr std::string_view methodName(RNFSTurboMethod method) {
+  return kRNFSTurboMethodNames[static_cast<size_t>(method)];
+}
+
+// Every method name is a case label of the switch below, so the compiler rejects
+// the table if two names ever hash to the same value (the hash is perfect for this set).
+// The final comparison filters out unrelated property names with a colliding hash.
+constexpr RNFSTurboMethod methodFromName(std::string_view name) {
+#define RNFSTURBO_METHOD_CASE(METHOD) \
+  case methodNameHash(methodName(RNFSTurboMethod::METHOD)): method = RNFSTurboMethod::METHOD; break;
+
+  RNFSTurboMethod method{RNFSTurboMethod::Unknown};
+  switch (methodNameHash(name)) {
+    RNFSTURBO_METHOD_CASE(Stat)
+    RNFSTURBO_METHOD_CASE(ReadDir)
+    RNFSTURBO_METHOD_CASE(ReadDirAssets)
+    RNFSTURBO_METHOD_CASE(Readdir)
+    RNFSTURBO_METHOD_CASE(ReadFile)
+    RNFSTURBO_METHOD_CASE(Read)
+    RNFSTURBO_METHOD_CASE(ReadFileAssets)
+    RNFSTURBO_METHOD_CASE(ReadFileRes)
+    RNFSTURBO_METHOD_CASE(WriteFile)
+    RNFSTURBO_METHOD_CASE(AppendFile)
+    RNFSTURBO_METHOD_CASE(Write)
+    RNFSTURBO_METHOD_CASE(MoveFile)
+    RNFSTURBO_METHOD_CASE(CopyFolder)
+    RNFSTURBO_METHOD_CASE(CopyFile)
+    RNFSTURBO_METHOD_CASE(CopyFileAssets)
+    RNFSTURBO_METHOD_CASE(CopyFileRes)
+    RNFSTURBO_METHOD_CASE(CopyAssetsFileIOS)
+    RNFSTURBO_METHOD_CASE(CopyAssetsVideoIOS)
+    RNFSTURBO_METHOD_CASE(Unlink)
+    RNFSTURBO_METHOD_CASE(Exists)
+    RNFSTURBO_METHOD_CASE(ExistsAssets)
+    RNFSTURBO_METHOD_CASE(ExistsRes)
+    RNFSTURBO_METHOD_CASE(Hash)
+    RNFSTURBO_METHOD_CASE(Touch)
+    RNFSTURBO_METHOD_CASE(Mkdir)
+    RNFSTURBO_METHOD_CASE(DownloadFile)
+    RNFSTURBO_METHOD_CASE(StopDownload)
+    RNFSTURBO_METHOD_CASE(ResumeDownload)
+    RNFSTURBO_METHOD_CASE(IsResumable)
+    RNFSTURBO_METHOD_CASE(CompleteHandlerIOS)
+    RNFSTURBO_METHOD_CASE(UploadFiles)
+    RNFSTURBO_METHOD_CASE(StopUpload)
+    RNFSTURBO_METHOD_CASE(GetFSInfo)
+    RNFSTURBO_METHOD_CASE(ScanFile)
+    RNFSTURBO_METHOD_CASE(GetAllExternalFilesDirs)
+    RNFSTURBO_METHOD_CASE(PathForGroup)
+    RNFSTURBO_METHOD_CASE(StatMany)
+    RNFSTURBO_METHOD_CASE(ExistsMany)
+    RNFSTURBO_METHOD_CASE(Walk)
+    RNFSTURBO_METHOD_CASE(Du)
+    RNFSTURBO_METHOD_CASE(OpenDir)
+    RNFSTURBO_METHOD_CASE(Watch)
+    RNFSTURBO_METHOD_CASE(Unwatch)
+    RNFSTURBO_METHOD_CASE(ConfigureStatCache)
+    RNFSTURBO_METHOD_CASE(GetStatCacheStats)
+    RNFSTURBO_METHOD_CASE(Allocate)
+    RNFSTURBO_METHOD_CASE(Prefetch)
+    RNFSTURBO_METHOD_CASE(Evict)
+    RNFSTURBO_METHOD_CASE(Pipeline)
+    RNFSTURBO_METHOD_CASE(Unzip)
+    RNFSTURBO_METHOD_CASE(Zip)
+    RNFSTURBO_METHOD_CASE(Tar)
+    RNFSTURBO_METHOD_CASE(DeriveKey)
+    RNFSTURBO_METHOD_CASE(Hmac)
+    RNFSTURBO_METHOD_CASE(VerifyHmac)
+    RNFSTURBO_METHOD_CASE(HashData)
+    RNFSTURBO_METHOD_CASE(EncryptData)
+    RNFSTURBO_METHOD_CASE(DecryptData)
+    RNFSTURBO_METHOD_CASE(ChunkManifest)
+    default:
+      return RNFSTurboMethod::Unknown;
+  }
+#undef RNFSTURBO_METHOD_CASE
+
+  return methodName(method) == name ? method : RNFSTurboMethod::Unknown;
+}
+
+static_assert(methodFromName("stat") == RNFSTurboMethod::Stat);
+static_assert(methodFromName("pathForGroup") == RNFSTurboMethod::PathForGroup);
+static_assert(methodFromName("unknown") == RNFSTurboMethod::Unknown);
+
+}
@@ -0,0 +1,187 @@
+//
+//  RNFSTurboPropNames.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <jsi/jsi.h>
+#include <string_view>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+using namespace facebook;
+
+enum class PropKey : uint8_t {
+  Encoding,
+  Encrypted,
+  Passphrase,
+  Iv,
+  Mode,
+  Padding,
+  NSFileProtectionKey,
+  NSURLIsExcludedFromBackupKey,
+  Path,
+  Name,
+  Ctime,
+  Mtime,
+  Size,
+  OriginalFilepath,
+  IsDirectory,
+  IsFile,
+  Flags,
+  MaxDepth,
+  Glob,
+  MinSize,
+  MaxSize,
+  ModifiedAfter,
+  Type,
+  FollowSymlinks,
+  BatchSize,
+  JobId,
+  Items,
+  PerChild,
+  Files,
+  Children,
+  Sort,
+  Order,
+  Limit,
+  Recursive,
+  Events,
+  DebounceMs,
+  WatchId,
+  Changes,
+  Enabled,
+  MaxEntries,
+  WatchPaths,
+  Hits,
+  Misses,
+  Progress,
+  BytesCopied,
+  TotalBytes,
+  KeepSize,
+  Preallocate,
+  Offset,
+  Length,
+  Uncached,
+  Algorithm,
+  BytesRead,
+  BytesWritten,
+  Digests,
+  Compression,
+  Filter,
+  Overwrite,
+  Level,
+  StoreExtensions,
+  Mac,
+  Kdf,
+  Salt,
+  Iterations,
+  Info,
+  KeyLength,
+  Key,
+  Digest,
+  Data,
+  ChunkSize,
+  Count,
+};
+
+// Indexed by PropKey
+inline constexpr std::array<std::string_view, static_cast<size_t>(PropKey::Count)> kPropKeyNames = {
+  "encoding",
+  "encrypted",
+  "passphrase",
+  "iv",
+  "mode",
+  "padding",
+  "NSFileProtectionKey",
+  "NSURLIsExcludedFromBackupKey",
+  "path",
+  "name",
+  "ctime",
+  "mtime",
+  "size",
+  "originalFilepath",
+  "isDirectory",
+  "isFile",
+  "flags",
+  "maxDepth",
+  "glob",
+  "minSize",
+  "maxSize",
+  "modifiedAfter",
+  "type",
+  "followSymlinks",
+  "batchSize",
+  "jobId",
+  "items",
+  "perChild",
+  "files",
+  "children",
+  "sort",
+  "order",
+  "limit",
+  "recursive",
+  "events",
+  "debounceMs",
+  "watchId",
+  "changes",
+  "enabled",
+  "maxEntries",
+  "watchPaths",
+  "hits",
+  "misses",
+  "progress",
+  "bytesCopied",
+  "totalBytes",
+  "keepSize",
+  "preallocate",
+  "offset",
+  "length",
+  "uncached",
+  "algorithm",
+  "bytesRead",
+  "bytesWritten",
+  "digests",
+  "compression",
+  "filter",
+  "overwrite",
+  "level",
+  "storeExtensions",
+  "mac",
+  "kdf",
+  "salt",
+  "iterations",
+  "info",
+  "keyLength",
+  "key",
+  "digest",
+  "data",
+  "chunkSize",
+};
+
+// Option and result keys interned once per runtime, so hot paths don't
+// create a new PropNameID from a C string on every property access
+class RNFSTurboPropNames {
+public:
+  explicit RNFSTurboPropNames(jsi::Runtime& runtime) {
+    names.reserve(kPropKeyNames.size());
+    for (std::string_view name : kPropKeyNames) {
+      names.push_back(jsi::PropNameID::forAscii(runtime, name.data(), name.size()));
+    }
+  }
+
+  const jsi::PropNameID& operator[](PropKey key) const {
+    return names[static_cast<size_t>(key)];
+  }
+
+private:
+  std::vector<jsi::PropNameID> names;
+};
+
+}
@@ -35,6 +35,69 @@
 
 namespace Krypt {
     namespace Mode {
+        // in-place helpers shared by the modes, MODE_TYPE is final so the block calls are not virtual
+        template <typename MODE_TYPE>
+        size_t EncryptIntoBlocks(MODE_TYPE &mode, Bytes *plain, size_t plainLen, Bytes *cipher, Bytes *iv) {
+            const size_t blockSize = mode.Encryption->BLOCK_SIZE;
+            const size_t fullLen = plainLen - plainLen % blockSize;
+            const size_t cipherLen = mode.encryptedLength(plainLen);
+            Bytes chain[16];
+            if (iv != nullptr) {
+                memcpy(chain, iv, blockSize);
+            }
+
+            for (size_t i = 0; i < fullLen; i += blockSize) {
+                mode.blockEncrypt(plain + i, cipher + i, chain);
+            }
+            // the tail block is padded on the stack, `cipher` may alias `plain`
+            if (cipherLen > fullLen) {
+                Bytes tail[16];
+                if (plainLen > fullLen) {
+                    memcpy(tail, plain + fullLen, plainLen - fullLen);
+                }
+                mode.PaddingScheme->PadBlock(tail, plainLen - fullLen, blockSize);
+                mode.blockEncrypt(tail, cipher + fullLen, chain);
+            }
+
+            return cipherLen;
+        }
+
+        template <typename MODE_TYPE>
+        void EncryptBlocksInPlace(MODE_TYPE &mode, Bytes *buffer, size_t len, Bytes *iv) {
+            const size_t blockSize = mode.Encryption->BLOCK_SIZE;
+            if (len % blockSize != 0) {
+                throw Padding::InvalidPaddedLength("`len` has to be divisible by the `BLOCK_SIZE`");
+            }
+
+            for (size_t i = 0; i < len; i += blockSize) {
+                mode.blockEncrypt(buffer + i, buffer + i, iv);
+            }
+        }
+
+        template <typename MODE_TYPE>
+        void DecryptBlocksInPlace(MODE_TYPE &mode, Bytes *buffer, size_t len, Bytes *iv) {
+            const size_t blockSize = mode.Encryption->BLOCK_SIZE;
+            if (len % blockSize != 0) {
+                throw Padding::InvalidPaddedLength("`len` has to be divisible by the `BLOCK_SIZE`");
+            }
+
+            for (size_t i = 0; i < len; i += blockSize) {
+                mode.blockDecrypt(buffer + i, buffer + i, iv);
+            }
+        }
+
+        template <typename MODE_TYPE>
+        size_t DecryptInPlace(MODE_TYPE &mode, Bytes *buffer, size_t len, Bytes *iv) {
+            const size_t blockSize = mode.Encryption->BLOCK_SIZE;
+            Bytes chain[16];
+            if (iv != nullptr) {
+                memcpy(chain, iv, blockSize);
+            }
+
+            DecryptBlocksInPlace(mode, buffer, len, chain);
+            return mode.PaddingScheme->UnpaddedLength(buffer, len, blockSize);
+        }
+
         // CBC
         template <typename CIPHER_TYPE, typename PADDING_TYPE>
         CBC<CIPHER_TYPE, PADDING_TYPE>::CBC(const Bytes *key, size_t keyLen) : MODE() {
@@ -85,9 +148,32 @@ namespace Krypt {
 
         template <typename CIPHER_TYPE, typename PADDING_TYPE>
         void CBC<CIPHER_TYPE, PADDING_TYPE>::blockDecrypt(Bytes *cipher, Bytes *recover, Bytes *iv) {
+            // `recover` may be `cipher` itself
+            Bytes next[16];
+            memcpy(next, cipher, Encryption->BLOCK_SIZE);
             Encryption->DecryptBlock(cipher, recover);
             XorAesBlock(iv, recover, recover);
-            memcpy(iv, cipher, Encryption->BLOCK_SIZE);
+            memcpy(iv, next, Encryption->BLOCK_SIZE);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        size_t CBC<CIPHER_TYPE, PADDING_TYPE>::encryptInto(Bytes *plain, size_t plainLen, Bytes *cipher, Bytes *iv) {
+            return EncryptIntoBlocks(*this, plain, plainLen, cipher, iv);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        size_t CBC<CIPHER_TYPE, PADDING_TYPE>::decryptInPlace(Bytes *buffer, size_t len, Bytes *iv) {
+            return DecryptInPlace(*this, buffer, len, iv);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        void CBC<CIPHER_TYPE, PADDING_TYPE>::encryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) {
+            EncryptBlocksInPlace(*this, buffer, len, iv);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        void CBC<CIPHER_TYPE, PADDING_TYPE>::decryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) {
+            DecryptBlocksInPlace(*this, buffer, len, iv);
         }
     
         // CFB
@@ -142,16 +228,39 @@ namespace Krypt {
 
         template <typename CIPHER_TYPE, typename PADDING_TYPE>
         void CFB<CIPHER_TYPE, PADDING_TYPE>::blockEncrypt(Bytes *plain, Bytes *cipher, Bytes *iv) {
-            Encryption->EncryptBlock(iv, cipher);
-            XorAesBlock(plain, cipher, cipher);
+            // `cipher` may be `plain` itself, the keystream goes through `iv`
+            Encryption->EncryptBlock(iv, iv);
+            XorAesBlock(plain, iv, cipher);
             memcpy(iv, cipher, Encryption->BLOCK_SIZE);
         }
 
         template <typename CIPHER_TYPE, typename PADDING_TYPE>
         void CFB<CIPHER_TYPE, PADDING_TYPE>::blockDecrypt(Bytes *cipher, Bytes *recover, Bytes *iv) {
-            Encryption->EncryptBlock(iv, recover);
-            XorAesBlock(cipher, recover, recover);
+            // `recover` may be `cipher` itself
+            Bytes keystream[16];
+            Encryption->EncryptBlock(iv, keystream);
             memcpy(iv, cipher, Encryption->BLOCK_SIZE);
+            XorAesBlock(iv, keystream, recover);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        size_t CFB<CIPHER_TYPE, PADDING_TYPE>::encryptInto(Bytes *plain, size_t plainLen, Bytes *cipher, Bytes *iv) {
+            return EncryptIntoBlocks(*this, plain, plainLen, cipher, iv);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        size_t CFB<CIPHER_TYPE, PADDING_TYPE>::decryptInPlace(Bytes *buffer, size_t len, Bytes *iv) {
+            return DecryptInPlace(*this, buffer, len, iv);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        void CFB<CIPHER_TYPE, PADDING_TYPE>::encryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) {
+            EncryptBlocksInPlace(*this, buffer, len, iv);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        void CFB<CIPHER_TYPE, PADDING_TYPE>::decryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) {
+            DecryptBlocksInPlace(*this, buffer, len, iv);
         }
     
         // ECB
@@ -195,6 +304,26 @@ namespace Krypt {
         void ECB<CIPHER_TYPE, PADDING_TYPE>::blockDecrypt(Bytes *cipher, Bytes *recover, Bytes *) {
             this->Encryption->DecryptBlock(cipher, recover);
         }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        size_t ECB<CIPHER_TYPE, PADDING_TYPE>::encryptInto(Bytes *plain, size_t plainLen, Bytes *cipher, Bytes *) {
+            return EncryptIntoBlocks(*this, plain, plainLen, cipher, nullptr);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        size_t ECB<CIPHER_TYPE, PADDING_TYPE>::decryptInPlace(Bytes *buffer, size_t len, Bytes *) {
+            return DecryptInPlace(*this, buffer, len, nullptr);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        void ECB<CIPHER_TYPE, PADDING_TYPE>::encryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *) {
+            EncryptBlocksInPlace(*this, buffer, len, nullptr);
+        }
+
+        template <typename CIPHER_TYPE, typename PADDING_TYPE>
+        void ECB<CIPHER_TYPE, PADDING_TYPE>::decryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *) {
+            DecryptBlocksInPlace(*this, buffer, len, nullptr);
+        }
     } // namespace Mode
 } // namespace Krypt
 
@@ -51,6 +51,28 @@ namespace Krypt {
             virtual void blockEncrypt(Bytes *, Bytes *, Bytes *) = 0;
             virtual void blockDecrypt(Bytes *, Bytes *, Bytes *) = 0;
 
+            /// encrypts `plain` into a caller provided buffer without allocating, only the tail block is padded
+            /// (on the stack).
+            /// @param cipher needs `encryptedLength(plainLen)` bytes, it may be `plain` itself.
+            /// @param iv left untouched, unused for ECB.
+            /// @return the length of the encrypted data.
+            virtual size_t encryptInto(Bytes *plain, size_t plainLen, Bytes *cipher, Bytes *iv) = 0;
+            /// decrypts `buffer` in place without allocating and checks the padding of the last block.
+            /// @param iv left untouched, unused for ECB.
+            /// @return the length of the decrypted data, the padding stays behind it in `buffer`.
+            virtual size_t decryptInPlace(Bytes *buffer, size_t len, Bytes *iv) = 0;
+            /// encrypts whole blocks in place without padding, `iv` is updated so that the next call (`encryptInto`
+            /// for the padded tail) continues the chain.
+            virtual void encryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) = 0;
+            /// decrypts whole blocks in place, `iv` is updated so that the next call continues the chain. The padding
+            /// is not removed, for streaming where the last block is only known at the end.
+            virtual void decryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) = 0;
+
+            /// the size of the buffer `encryptInto` needs for `plainLen` bytes.
+            size_t encryptedLength(size_t plainLen) {
+                return PaddingScheme->PaddedLength(plainLen, Encryption->BLOCK_SIZE);
+            }
+
             virtual ~MODE() {
                 delete Encryption;
                 delete PaddingScheme;
@@ -59,7 +81,7 @@ namespace Krypt {
 
         /// Electronic Code Blocking.
         template <typename CIPHER_TYPE, typename PADDING_TYPE>
-        class ECB : public MODE {
+        class ECB final : public MODE {
             public:
 
             ECB(const Bytes *key, size_t keyLen);
@@ -78,11 +100,16 @@ namespace Krypt {
 
             void blockEncrypt(Bytes *plain, Bytes *cipher, Bytes *iv = nullptr) override;
             void blockDecrypt(Bytes *plain, Bytes *cipher, Bytes *iv = nullptr) override;
+
+            size_t encryptInto(Bytes *plain, size_t plainLen, Bytes *cipher, Bytes *iv) override;
+            size_t decryptInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
+            void encryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
+            void decryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
         };
 
         /// Cipher Block Chaining.
         template <typename CIPHER_TYPE, typename PADDING_TYPE>
-        class CBC : public MODE {
+        class CBC final : public MODE {
             public:
 
             CBC(const Bytes *key, size_t keyLen);
@@ -99,11 +126,16 @@ namespace Krypt {
 
             void blockEncrypt(Bytes *plain, Bytes *cipher, Bytes *iv) override;
             void blockDecrypt(Bytes *plain, Bytes *cipher, Bytes *iv) override;
+
+            size_t encryptInto(Bytes *plain, size_t plainLen, Bytes *cipher, Bytes *iv) override;
+            size_t decryptInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
+            void encryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
+            void decryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
         };
 
         /// Cipher Feedback.
         template <typename CIPHER_TYPE, typename PADDING_TYPE>
-        class CFB : public MODE {
+        class CFB final : public MODE {
             public:
 
             CFB(const Bytes *key, size_t keyLen);
@@ -120,6 +152,11 @@ namespace Krypt {
 
             void blockEncrypt(Bytes *plain, Bytes *cipher, Bytes *iv) override;
             void blockDecrypt(Bytes *plain, Bytes *cipher, Bytes *iv) override;
+
+            size_t encryptInto(Bytes *plain, size_t plainLen, Bytes *cipher, Bytes *iv) override;
+            size_t decryptInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
+            void encryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
+            void decryptBlocksInPlace(Bytes *buffer, size_t len, Bytes *iv) override;
         };
     } // namespace Mode
 } // namespace Krypt
@@ -34,18 +34,35 @@ namespace Krypt {
     namespace Padding {
         // ANSI_X9_23
         ByteArray ANSI_X9_23::AddPadding(Bytes *src, size_t len, size_t BLOCKSIZE) {
-            size_t paddings = BLOCKSIZE - (len % BLOCKSIZE);
-            size_t paddedLen = paddings + len;
+            size_t paddedLen = PaddedLength(len, BLOCKSIZE);
+            size_t tail = len - len % BLOCKSIZE;
             Bytes *paddedBlock = new Bytes[paddedLen];
 
             memcpy(paddedBlock, src, len);
-            memset(paddedBlock + len, 0x00, paddings);
-            paddedBlock[paddedLen - 1] = static_cast<Bytes>(paddings);
+            PadBlock(paddedBlock + tail, len - tail, BLOCKSIZE);
 
             return ByteArray(paddedBlock, paddedLen);
         }
 
         ByteArray ANSI_X9_23::RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE) {
+            size_t noPaddingLength = UnpaddedLength(src, len, BLOCKSIZE);
+            Bytes *NoPadding = new Bytes[noPaddingLength];
+            memcpy(NoPadding, src, noPaddingLength);
+
+            return ByteArray(NoPadding, noPaddingLength);
+        }
+
+        size_t ANSI_X9_23::PaddedLength(size_t len, size_t BLOCKSIZE) {
+            return len + BLOCKSIZE - (len % BLOCKSIZE);
+        }
+
+        void ANSI_X9_23::PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE) {
+            size_t paddings = BLOCKSIZE - used;
+            memset(block + used, 0x00, paddings);
+            block[BLOCKSIZE - 1] = static_cast<Bytes>(paddings);
+        }
+
+        size_t ANSI_X9_23::UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE) {
 #ifndef PADDING_CHECK_DISABLE
             if (len < BLOCKSIZE || len % BLOCKSIZE != 0) {
                 std::cerr << "\nA padded `src` should have a `len` greater than and divisible by the `BLOCKSIZE`\n";
@@ -54,9 +71,11 @@ namespace Krypt {
 #endif
 
             size_t paddings = src[len - 1];
-            size_t noPaddingLength = len - paddings;
 
 #ifndef PADDING_CHECK_DISABLE
+            if (paddings == 0 || paddings > BLOCKSIZE) {
+                throw InvalidPadding("ANSI_X9_23: does not match the padding scheme used in `src`");
+            }
             for (size_t i = 1; i < paddings; ++i) {
                 if (src[len - 1 - i] != 0x00) {
                     throw InvalidPadding("ANSI_X9_23: does not match the padding scheme used in `src`");
@@ -64,26 +83,39 @@ namespace Krypt {
             }
 #endif
 
-            Bytes *NoPadding = new Bytes[noPaddingLength];
-            memcpy(NoPadding, src, noPaddingLength);
-
-            return ByteArray(NoPadding, noPaddingLength);
+            return len - paddings;
         }
     
         // ISO_IEC_7816_4
         ByteArray ISO_IEC_7816_4::AddPadding(Bytes *src, size_t originalSrcLen, size_t BLOCKSIZE) {
-            size_t paddings = BLOCKSIZE - (originalSrcLen % BLOCKSIZE);
-            size_t paddedLen = paddings + originalSrcLen;
+            size_t paddedLen = PaddedLength(originalSrcLen, BLOCKSIZE);
+            size_t tail = originalSrcLen - originalSrcLen % BLOCKSIZE;
             Bytes *paddedBlock = new Bytes[paddedLen];
 
             memcpy(paddedBlock, src, originalSrcLen);
-            memset(paddedBlock + originalSrcLen, 0x00, paddings);
-            paddedBlock[originalSrcLen] = 0x80;
+            PadBlock(paddedBlock + tail, originalSrcLen - tail, BLOCKSIZE);
 
             return ByteArray(paddedBlock, paddedLen);
         }
 
         ByteArray ISO_IEC_7816_4::RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE) {
+            size_t noPaddingLength = UnpaddedLength(src, len, BLOCKSIZE);
+            Bytes *NoPadding = new Bytes[noPaddingLength];
+            memcpy(NoPadding, src, noPaddingLength);
+
+            return ByteArray(NoPadding, noPaddingLength);
+        }
+
+        size_t ISO_IEC_7816_4::PaddedLength(size_t len, size_t BLOCKSIZE) {
+            return len + BLOCKSIZE - (len % BLOCKSIZE);
+        }
+
+        void ISO_IEC_7816_4::PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE) {
+            memset(block + used, 0x00, BLOCKSIZE - used);
+            block[used] = 0x80;
+        }
+
+        size_t ISO_IEC_7816_4::UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE) {
 #ifndef PADDING_CHECK_DISABLE
             if (len < BLOCKSIZE || len % BLOCKSIZE != 0) {
                 std::cerr << "\nA padded `src` should have a `len` greater than and divisible by the `BLOCKSIZE`\n";
@@ -94,23 +126,19 @@ namespace Krypt {
 
             size_t i;
 
-#ifndef PADDING_CHECK_DISABLE
             for (i = 1; i < BLOCKSIZE; ++i) {
                 if (src[len - i] == 0x80) {
                     break;
                 }
 
+#ifndef PADDING_CHECK_DISABLE
                 if (src[len - i] != 0x00) {
                     throw InvalidPadding("ISO_IEC_7816_4: does not match the padding scheme used in `src`");
                 }
-            }
 #endif
+            }
 
-            size_t noPaddingLength = len - i;
-            Bytes *NoPadding = new Bytes[noPaddingLength];
-            memcpy(NoPadding, src, noPaddingLength);
-
-            return ByteArray(NoPadding, noPaddingLength);
+            return len - i;
         }
     
         // NoPadding
@@ -132,20 +160,51 @@ namespace Krypt {
             memcpy(Copy, src, len);
             return ByteArray(Copy, len);
         }
+
+        size_t NoPadding::PaddedLength(size_t len, size_t BLOCKSIZE) {
+            if (len % BLOCKSIZE != 0) {
+                throw InvalidPaddedLength("NoPadding: `len` has to be divisible by the `BLOCKSIZE`");
+            }
+            return len;
+        }
+
+        void NoPadding::PadBlock(Bytes *, size_t, size_t) {
+        }
+
+        size_t NoPadding::UnpaddedLength(Bytes *, size_t len, size_t) {
+            return len;
+        }
     
         // PKCS_5_7
         ByteArray PKCS_5_7::AddPadding(Bytes *src, size_t len, size_t BLOCKSIZE) {
-            size_t paddings = BLOCKSIZE - (len % BLOCKSIZE);
-            size_t paddedLen = paddings + len;
+            size_t paddedLen = PaddedLength(len, BLOCKSIZE);
+            size_t tail = len - len % BLOCKSIZE;
             Bytes *paddedBlock = new Bytes[paddedLen];
 
             memcpy(paddedBlock, src, len);
-            memset(paddedBlock + len, static_cast<Bytes>(paddings), paddings);
+            PadBlock(paddedBlock + tail, len - tail, BLOCKSIZE);
 
             return ByteArray(paddedBlock, paddedLen);
         }
 
         ByteArray PKCS_5_7::RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE) {
+            size_t noPaddingLength = UnpaddedLength(src, len, BLOCKSIZE);
+            Bytes *NoPadding = new Bytes[noPaddingLength];
+            memcpy(NoPadding, src, noPaddingLength);
+
+            return ByteArray(NoPadding, noPaddingLength);
+        }
+
+        size_t PKCS_5_7::PaddedLength(size_t len, size_t BLOCKSIZE) {
+            return len + BLOCKSIZE - (len % BLOCKSIZE);
+        }
+
+        void PKCS_5_7::PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE) {
+            size_t paddings = BLOCKSIZE - used;
+            memset(block + used, static_cast<Bytes>(paddings), paddings);
+        }
+
+        size_t PKCS_5_7::UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE) {
 #ifndef PADDING_CHECK_DISABLE
             if (len < BLOCKSIZE || len % BLOCKSIZE != 0) {
                 std::cerr << "\nA padded `src` should have a `len` greater than and divisible by the `BLOCKSIZE`\n";
@@ -154,9 +213,11 @@ namespace Krypt {
 #endif
 
             size_t paddings = src[len - 1];
-            size_t noPaddingLength = len - paddings;
 
 #ifndef PADDING_CHECK_DISABLE
+            if (paddings == 0 || paddings > BLOCKSIZE) {
+                throw InvalidPadding("PKCS_5_7: does not match the padding scheme used in `src`");
+            }
             Bytes checkchar = static_cast<Bytes>(paddings);
             for (size_t i = 1; i < paddings; ++i) {
                 if (src[len - 1 - i] != checkchar) {
@@ -165,25 +226,38 @@ namespace Krypt {
             }
 #endif
 
-            Bytes *NoPadding = new Bytes[noPaddingLength];
-            memcpy(NoPadding, src, noPaddingLength);
-
-            return ByteArray(NoPadding, noPaddingLength);
+            return len - paddings;
         }
     
         // ZeroNulls
         ByteArray ZeroNulls::AddPadding(Bytes *src, size_t len, size_t BLOCKSIZE) {
-            size_t paddings = BLOCKSIZE - (len % BLOCKSIZE);
-            size_t paddedLen = paddings + len;
+            size_t paddedLen = PaddedLength(len, BLOCKSIZE);
+            size_t tail = len - len % BLOCKSIZE;
             Bytes *paddedBlock = new Bytes[paddedLen];
 
             memcpy(paddedBlock, src, len);
-            memset(paddedBlock + len, 0x00, paddings);
+            PadBlock(paddedBlock + tail, len - tail, BLOCKSIZE);
 
             return ByteArray(paddedBlock, paddedLen);
         }
 
         ByteArray ZeroNulls::RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE) {
+            size_t noPaddingLength = UnpaddedLength(src, len, BLOCKSIZE);
+            Bytes *NoPadding = new Bytes[noPaddingLength];
+            memcpy(NoPadding, src, noPaddingLength);
+
+            return ByteArray(NoPadding, noPaddingLength);
+        }
+
+        size_t ZeroNulls::PaddedLength(size_t len, size_t BLOCKSIZE) {
+            return len + BLOCKSIZE - (len % BLOCKSIZE);
+        }
+
+        void ZeroNulls::PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE) {
+            memset(block + used, 0x00, BLOCKSIZE - used);
+        }
+
+        size_t ZeroNulls::UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE) {
 #ifndef PADDING_CHECK_DISABLE
             if (len < BLOCKSIZE || len % BLOCKSIZE != 0) {
                 std::cerr << "\nA padded `src` should have a `len` greater than and divisible by the `BLOCKSIZE`\n";
@@ -197,7 +271,7 @@ namespace Krypt {
             }
 #endif
 
-            size_t paddings = 0, noPaddingLength = 0;
+            size_t paddings = 0;
             for (size_t i = 0; i < BLOCKSIZE; ++i)
                 if (src[len - 1 - i] == 0x00) {
                     paddings++;
@@ -205,11 +279,7 @@ namespace Krypt {
                     break;
                 }
 
-            noPaddingLength = len - paddings;
-            Bytes *NoPadding = new Bytes[noPaddingLength];
-            memcpy(NoPadding, src, noPaddingLength);
-
-            return ByteArray(NoPadding, noPaddingLength);
+            return len - paddings;
         }
     } // namespace Padding
 } // namespace Krypt
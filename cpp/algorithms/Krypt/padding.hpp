@@ -66,6 +66,21 @@ namespace Krypt {
             /** does nothing obviously. **/
             virtual ByteArray RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE);
 
+            /** the length of `len` bytes once padded, `len` itself here.
+             * @throws InvalidPaddedLength when `len` is not a multiple of `BLOCKSIZE`.
+             * **/
+            virtual size_t PaddedLength(size_t len, size_t BLOCKSIZE);
+
+            /** pads the tail block in place, `block` holds `used` bytes followed by room up to `BLOCKSIZE`.
+             * never called here, the length of unpadded data is a multiple of `BLOCKSIZE`.
+             * **/
+            virtual void PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE);
+
+            /** checks the padding at the end of `src` without copying it [no allocation].
+             * @return the length of `src` without the padding, `len` itself here.
+             * **/
+            virtual size_t UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE);
+
             virtual ~NoPadding() = default;
         };
 
@@ -83,6 +98,12 @@ namespace Krypt {
              * **/
             ByteArray RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE);
 
+            size_t PaddedLength(size_t len, size_t BLOCKSIZE);
+
+            void PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE);
+
+            size_t UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE);
+
             ~ZeroNulls() = default;
         };
 
@@ -100,6 +121,12 @@ namespace Krypt {
              * **/
             ByteArray RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE) override;
 
+            size_t PaddedLength(size_t len, size_t BLOCKSIZE) override;
+
+            void PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE) override;
+
+            size_t UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE) override;
+
             ~ANSI_X9_23() {
             }
         };
@@ -119,6 +146,12 @@ namespace Krypt {
              * **/
             ByteArray RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE) override;
 
+            size_t PaddedLength(size_t len, size_t BLOCKSIZE) override;
+
+            void PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE) override;
+
+            size_t UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE) override;
+
             ~ISO_IEC_7816_4() {
             }
         };
@@ -137,6 +170,12 @@ namespace Krypt {
              * **/
             ByteArray RemovePadding(Bytes *src, size_t len, size_t BLOCKSIZE) override;
 
+            size_t PaddedLength(size_t len, size_t BLOCKSIZE) override;
+
+            void PadBlock(Bytes *block, size_t used, size_t BLOCKSIZE) override;
+
+            size_t UnpaddedLength(Bytes *src, size_t len, size_t BLOCKSIZE) override;
+
             ~PKCS_5_7() {
             }
         };
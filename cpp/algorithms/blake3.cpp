@@ -0,0 +1,585 @@
+//
+//  blake3.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "blake3.h"
+
+#if defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define BLAKE3_HAS_X86_SIMD 1
+#include <cpuid.h>
+#endif
+
+namespace cmpayc::rnfsturbo {
+
+namespace {
+
+constexpr uint32_t kIv[8] = {
+  0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A, 0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19,
+};
+
+enum : uint8_t {
+  kChunkStart = 1 << 0,
+  kChunkEnd = 1 << 1,
+  kParent = 1 << 2,
+  kRoot = 1 << 3,
+};
+
+// Message word order of each of the 7 rounds, every round permutes the previous one
+constexpr std::array<std::array<uint8_t, 16>, 7> kSchedule = [] {
+  constexpr uint8_t permutation[16] = {2, 6, 3, 10, 7, 0, 4, 13, 1, 11, 12, 5, 9, 14, 15, 8};
+  std::array<std::array<uint8_t, 16>, 7> schedule{};
+  for (uint8_t i = 0; i < 16; i++) {
+    schedule[0][i] = i;
+  }
+  for (size_t round = 1; round < 7; round++) {
+    for (size_t i = 0; i < 16; i++) {
+      schedule[round][i] = schedule[round - 1][permutation[i]];
+    }
+  }
+  return schedule;
+}();
+
+inline uint32_t load32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | static_cast<uint32_t>(p[1]) << 8
+    | static_cast<uint32_t>(p[2]) << 16 | static_cast<uint32_t>(p[3]) << 24;
+}
+
+inline void store32(uint8_t* p, uint32_t value) {
+  p[0] = static_cast<uint8_t>(value);
+  p[1] = static_cast<uint8_t>(value >> 8);
+  p[2] = static_cast<uint8_t>(value >> 16);
+  p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+typedef uint32_t U32x4 __attribute__((vector_size(16)));
+typedef uint32_t U32x8 __attribute__((vector_size(32)));
+
+// Rotations by whole bytes are a single byte shuffle on vectors
+template <int N, typename V, size_t... Bytes>
+__attribute__((always_inline)) inline void rotrBytes(V& x, std::index_sequence<Bytes...>) {
+  typedef uint8_t Bytes8 __attribute__((vector_size(sizeof(V))));
+  Bytes8 bytes = reinterpret_cast<const Bytes8&>(x);
+  Bytes8 rotated = __builtin_shufflevector(bytes, bytes, ((Bytes & ~size_t(3)) | ((Bytes + N / 8) & 3))...);
+  x = reinterpret_cast<const V&>(rotated);
+}
+
+// Shared by the scalar and the SIMD code, T is uint32_t or a vector of uint32_t lanes.
+// Vectors are only passed by reference, wide vectors by value would depend on the target ABI
+template <int N, typename T>
+__attribute__((always_inline)) inline void xorRotr(T& x, const T& y) {
+  x ^= y;
+  if constexpr (!std::is_integral_v<T> && N % 8 == 0) {
+    rotrBytes<N>(x, std::make_index_sequence<sizeof(T)>());
+  } else {
+    x = (x >> N) | (x << (32 - N));
+  }
+}
+
+template <typename T>
+__attribute__((always_inline)) inline void g(T v[16], int a, int b, int c, int d, const T& mx, const T& my) {
+  v[a] += v[b] + mx;
+  xorRotr<16>(v[d], v[a]);
+  v[c] += v[d];
+  xorRotr<12>(v[b], v[c]);
+  v[a] += v[b] + my;
+  xorRotr<8>(v[d], v[a]);
+  v[c] += v[d];
+  xorRotr<7>(v[b], v[c]);
+}
+
+template <size_t Round, typename T>
+__attribute__((always_inline)) inline void round(T v[16], const T m[16]) {
+  constexpr const auto& s = kSchedule[Round];
+  g(v, 0, 4, 8, 12, m[s[0]], m[s[1]]);
+  g(v, 1, 5, 9, 13, m[s[2]], m[s[3]]);
+  g(v, 2, 6, 10, 14, m[s[4]], m[s[5]]);
+  g(v, 3, 7, 11, 15, m[s[6]], m[s[7]]);
+  g(v, 0, 5, 10, 15, m[s[8]], m[s[9]]);
+  g(v, 1, 6, 11, 12, m[s[10]], m[s[11]]);
+  g(v, 2, 7, 8, 13, m[s[12]], m[s[13]]);
+  g(v, 3, 4, 9, 14, m[s[14]], m[s[15]]);
+}
+
+// Unrolled, so the message word order is known at compile time
+template <typename T, size_t... Rounds>
+__attribute__((always_inline)) inline void roundsUnrolled(T v[16], const T m[16], std::index_sequence<Rounds...>) {
+  (round<Rounds>(v, m), ...);
+}
+
+template <typename T>
+__attribute__((always_inline)) inline void rounds(T v[16], const T m[16]) {
+  roundsUnrolled(v, m, std::make_index_sequence<7>());
+}
+
+// Full 16 word state after the rounds, the chaining value is its first half xored with the second one
+void compress(
+  const uint32_t cv[8],
+  const uint8_t block[kBlake3BlockLen],
+  uint8_t blockLength,
+  uint64_t counter,
+  uint8_t flags,
+  uint32_t v[16]
+) {
+  uint32_t m[16];
+  for (size_t i = 0; i < 16; i++) {
+    m[i] = load32(block + i * 4);
+  }
+  for (size_t i = 0; i < 8; i++) {
+    v[i] = cv[i];
+  }
+  for (size_t i = 0; i < 4; i++) {
+    v[i + 8] = kIv[i];
+  }
+  v[12] = static_cast<uint32_t>(counter);
+  v[13] = static_cast<uint32_t>(counter >> 32);
+  v[14] = blockLength;
+  v[15] = flags;
+  rounds(v, m);
+}
+
+void compressInPlace(uint32_t cv[8], const uint8_t block[kBlake3BlockLen], uint8_t blockLength, uint64_t counter, uint8_t flags) {
+  uint32_t v[16];
+  compress(cv, block, blockLength, counter, flags, v);
+  for (size_t i = 0; i < 8; i++) {
+    cv[i] = v[i] ^ v[i + 8];
+  }
+}
+
+void storeCv(uint8_t out[kBlake3OutLen], const uint32_t cv[8]) {
+  for (size_t i = 0; i < 8; i++) {
+    store32(out + i * 4, cv[i]);
+  }
+}
+
+// Root output: the digest is the first half of the state, with the second half xored in
+void rootOutput(const uint32_t cv[8], const uint8_t block[kBlake3BlockLen], uint8_t blockLength, uint8_t flags, uint8_t out[kBlake3OutLen]) {
+  uint32_t v[16];
+  compress(cv, block, blockLength, 0, flags | kRoot, v);
+  for (size_t i = 0; i < 8; i++) {
+    store32(out + i * 4, v[i] ^ v[i + 8]);
+  }
+}
+
+// Compresses `blocks` whole blocks of each input (a chunk or a pair of chaining values) into its chaining value.
+// Input i gets the counter counter + i when incrementCounter is set
+void hashOne(const uint8_t* input, size_t blocks, uint64_t counter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t out[kBlake3OutLen]) {
+  uint32_t cv[8];
+  memcpy(cv, kIv, sizeof(cv));
+  uint8_t blockFlags = flags | flagsStart;
+  for (size_t b = 0; b < blocks; b++, input += kBlake3BlockLen) {
+    if (b + 1 == blocks) {
+      blockFlags |= flagsEnd;
+    }
+    compressInPlace(cv, input, kBlake3BlockLen, counter, blockFlags);
+    blockFlags = flags;
+  }
+  storeCv(out, cv);
+}
+
+void hashManyPortable(
+  const uint8_t* const* inputs,
+  size_t count,
+  size_t blocks,
+  uint64_t counter,
+  bool incrementCounter,
+  uint8_t flags,
+  uint8_t flagsStart,
+  uint8_t flagsEnd,
+  uint8_t* out
+) {
+  for (size_t i = 0; i < count; i++) {
+    hashOne(inputs[i], blocks, counter, flags, flagsStart, flagsEnd, out + i * kBlake3OutLen);
+    if (incrementCounter) {
+      counter++;
+    }
+  }
+}
+
+// Word i of every lane: the rows hold consecutive message words of one lane each (little-endian loads,
+// like every target of the library), transposed with unpack-style shuffles
+__attribute__((always_inline)) inline void transpose(U32x4 m[4], const U32x4 rows[4]) {
+  U32x4 t0 = __builtin_shufflevector(rows[0], rows[1], 0, 4, 1, 5);
+  U32x4 t1 = __builtin_shufflevector(rows[0], rows[1], 2, 6, 3, 7);
+  U32x4 t2 = __builtin_shufflevector(rows[2], rows[3], 0, 4, 1, 5);
+  U32x4 t3 = __builtin_shufflevector(rows[2], rows[3], 2, 6, 3, 7);
+  m[0] = __builtin_shufflevector(t0, t2, 0, 1, 4, 5);
+  m[1] = __builtin_shufflevector(t0, t2, 2, 3, 6, 7);
+  m[2] = __builtin_shufflevector(t1, t3, 0, 1, 4, 5);
+  m[3] = __builtin_shufflevector(t1, t3, 2, 3, 6, 7);
+}
+
+__attribute__((always_inline)) inline void transpose(U32x8 m[8], const U32x8 rows[8]) {
+  U32x8 t[8];
+  for (size_t i = 0; i < 4; i++) {
+    t[i * 2] = __builtin_shufflevector(rows[i * 2], rows[i * 2 + 1], 0, 8, 1, 9, 4, 12, 5, 13);
+    t[i * 2 + 1] = __builtin_shufflevector(rows[i * 2], rows[i * 2 + 1], 2, 10, 3, 11, 6, 14, 7, 15);
+  }
+  U32x8 u[8];
+  for (size_t i = 0; i < 2; i++) {
+    for (size_t j = 0; j < 2; j++) {
+      const U32x8& a = t[i * 4 + j];
+      const U32x8& b = t[i * 4 + j + 2];
+      u[i * 4 + j * 2] = __builtin_shufflevector(a, b, 0, 1, 8, 9, 4, 5, 12, 13);
+      u[i * 4 + j * 2 + 1] = __builtin_shufflevector(a, b, 2, 3, 10, 11, 6, 7, 14, 15);
+    }
+  }
+  for (size_t i = 0; i < 4; i++) {
+    m[i] = __builtin_shufflevector(u[i], u[i + 4], 0, 1, 2, 3, 8, 9, 10, 11);
+    m[i + 4] = __builtin_shufflevector(u[i], u[i + 4], 4, 5, 6, 7, 12, 13, 14, 15);
+  }
+}
+
+// The same input block of every lane at once: lane l computes inputs[l], the message words are transposed
+// so word i of all lanes sits in one vector. Compiled once per instruction set by the wrappers below.
+template <typename V, size_t Lanes>
+__attribute__((always_inline)) inline void hashLanes(
+  const uint8_t* const* inputs,
+  size_t blocks,
+  uint64_t counter,
+  bool incrementCounter,
+  uint8_t flags,
+  uint8_t flagsStart,
+  uint8_t flagsEnd,
+  uint8_t* out
+) {
+  V h[8];
+  for (size_t i = 0; i < 8; i++) {
+    h[i] = V{} + kIv[i];
+  }
+  V counterLow;
+  V counterHigh;
+  for (size_t lane = 0; lane < Lanes; lane++) {
+    uint64_t laneCounter = counter + (incrementCounter ? lane : 0);
+    counterLow[lane] = static_cast<uint32_t>(laneCounter);
+    counterHigh[lane] = static_cast<uint32_t>(laneCounter >> 32);
+  }
+  uint8_t blockFlags = flags | flagsStart;
+  for (size_t b = 0; b < blocks; b++) {
+    if (b + 1 == blocks) {
+      blockFlags |= flagsEnd;
+    }
+    V m[16];
+    for (size_t group = 0; group < 16; group += Lanes) {
+      V rows[Lanes];
+      for (size_t lane = 0; lane < Lanes; lane++) {
+        memcpy(&rows[lane], inputs[lane] + b * kBlake3BlockLen + group * 4, sizeof(V));
+      }
+      transpose(m + group, rows);
+    }
+    V v[16];
+    for (size_t i = 0; i < 8; i++) {
+      v[i] = h[i];
+    }
+    for (size_t i = 0; i < 4; i++) {
+      v[i + 8] = V{} + kIv[i];
+    }
+    v[12] = counterLow;
+    v[13] = counterHigh;
+    v[14] = V{} + static_cast<uint32_t>(kBlake3BlockLen);
+    v[15] = V{} + static_cast<uint32_t>(blockFlags);
+    rounds(v, m);
+    for (size_t i = 0; i < 8; i++) {
+      h[i] = v[i] ^ v[i + 8];
+    }
+    blockFlags = flags;
+  }
+  for (size_t lane = 0; lane < Lanes; lane++) {
+    for (size_t i = 0; i < 8; i++) {
+      store32(out + lane * kBlake3OutLen + i * 4, h[i][lane]);
+    }
+  }
+}
+
+#ifdef BLAKE3_HAS_X86_SIMD
+__attribute__((target("avx2")))
+void hash8Avx2(const uint8_t* const* inputs, size_t blocks, uint64_t counter, bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+  hashLanes<U32x8, 8>(inputs, blocks, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+}
+
+__attribute__((target("sse4.1")))
+void hash4Sse41(const uint8_t* const* inputs, size_t blocks, uint64_t counter, bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+  hashLanes<U32x4, 4>(inputs, blocks, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+}
+
+bool hasAvx2() {
+  static const bool available = [] {
+    unsigned int eax, ebx, ecx, edx;
+    // The OS has to save the ymm registers too
+    if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_OSXSAVE) == 0 || (ecx & bit_AVX) == 0) {
+      return false;
+    }
+    unsigned int xcr0Low, xcr0High;
+    __asm__("xgetbv" : "=a"(xcr0Low), "=d"(xcr0High) : "c"(0));
+    if ((xcr0Low & 6) != 6) {
+      return false;
+    }
+    return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_AVX2) != 0;
+  }();
+  return available;
+}
+
+bool hasSse41() {
+  static const bool available = [] {
+    unsigned int eax, ebx, ecx, edx;
+    return __get_cpuid(1, &eax, &ebx, &ecx, &edx) && (ecx & bit_SSE4_1) != 0;
+  }();
+  return available;
+}
+#elif defined(__aarch64__)
+// NEON is part of the arm64 baseline
+void hash4Neon(const uint8_t* const* inputs, size_t blocks, uint64_t counter, bool incrementCounter, uint8_t flags, uint8_t flagsStart, uint8_t flagsEnd, uint8_t* out) {
+  hashLanes<U32x4, 4>(inputs, blocks, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+}
+#endif
+
+// Widest kernel first, the inputs that don't fill its lanes go to the narrower ones
+void hashMany(
+  const uint8_t* const* inputs,
+  size_t count,
+  size_t blocks,
+  uint64_t counter,
+  bool incrementCounter,
+  uint8_t flags,
+  uint8_t flagsStart,
+  uint8_t flagsEnd,
+  uint8_t* out
+) {
+  auto advance = [&](size_t lanes) {
+    inputs += lanes;
+    count -= lanes;
+    out += lanes * kBlake3OutLen;
+    if (incrementCounter) {
+      counter += lanes;
+    }
+  };
+#ifdef BLAKE3_HAS_X86_SIMD
+  if (hasAvx2()) {
+    while (count >= 8) {
+      hash8Avx2(inputs, blocks, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+      advance(8);
+    }
+  }
+  if (hasSse41()) {
+    while (count >= 4) {
+      hash4Sse41(inputs, blocks, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+      advance(4);
+    }
+  }
+#elif defined(__aarch64__)
+  while (count >= 4) {
+    hash4Neon(inputs, blocks, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+    advance(4);
+  }
+#endif
+  hashManyPortable(inputs, count, blocks, counter, incrementCounter, flags, flagsStart, flagsEnd, out);
+}
+
+constexpr size_t kBatchChunks = 16;
+
+// Chaining values of the whole chunks of data, back to back
+void hashChunks(const uint8_t* data, size_t chunks, uint64_t chunkCounter, uint8_t* cvs) {
+  const uint8_t* inputs[kBatchChunks];
+  while (chunks > 0) {
+    size_t batch = std::min(chunks, kBatchChunks);
+    for (size_t i = 0; i < batch; i++) {
+      inputs[i] = data + i * kBlake3ChunkLen;
+    }
+    hashMany(inputs, batch, kBlake3ChunkLen / kBlake3BlockLen, chunkCounter, true, 0, kChunkStart, kChunkEnd, cvs);
+    data += batch * kBlake3ChunkLen;
+    chunks -= batch;
+    chunkCounter += batch;
+    cvs += batch * kBlake3OutLen;
+  }
+}
+
+// Chaining value of a partial last chunk, it is never the root here
+void hashPartialChunk(const uint8_t* data, size_t length, uint64_t chunkCounter, uint8_t cv[kBlake3OutLen]) {
+  uint32_t state[8];
+  memcpy(state, kIv, sizeof(state));
+  uint8_t flags = kChunkStart;
+  while (length > kBlake3BlockLen) {
+    compressInPlace(state, data, kBlake3BlockLen, chunkCounter, flags);
+    data += kBlake3BlockLen;
+    length -= kBlake3BlockLen;
+    flags = 0;
+  }
+  uint8_t last[kBlake3BlockLen] = {0};
+  memcpy(last, data, length);
+  compressInPlace(state, last, static_cast<uint8_t>(length), chunkCounter, flags | kChunkEnd);
+  storeCv(cv, state);
+}
+
+// One level of the tree: the parents of adjacent pairs, an odd last node moves up as is.
+// Returns the number of nodes in out
+size_t parentLevel(const uint8_t* cvs, size_t count, uint8_t* out) {
+  const uint8_t* inputs[kBatchChunks];
+  size_t parents = count / 2;
+  for (size_t done = 0; done < parents;) {
+    size_t batch = std::min(parents - done, kBatchChunks);
+    for (size_t i = 0; i < batch; i++) {
+      inputs[i] = cvs + (done + i) * 2 * kBlake3OutLen;
+    }
+    hashMany(inputs, batch, 1, 0, false, kParent, 0, 0, out + done * kBlake3OutLen);
+    done += batch;
+  }
+  if (count % 2 != 0) {
+    memcpy(out + parents * kBlake3OutLen, cvs + (count - 1) * kBlake3OutLen, kBlake3OutLen);
+  }
+  return parents + count % 2;
+}
+
+// Reduces count >= 2 nodes to the two children of the top node, scratch needs room for (count + 1) / 2 nodes.
+// Returns the buffer that holds them
+const uint8_t* reduceToTopChildren(uint8_t* cvs, uint8_t* scratch, size_t count) {
+  while (count > 2) {
+    count = parentLevel(cvs, count, scratch);
+    std::swap(cvs, scratch);
+  }
+  return cvs;
+}
+
+}
+
+Blake3::Blake3() {
+  memcpy(chunkCv, kIv, sizeof(chunkCv));
+}
+
+void Blake3::chunkUpdate(const uint8_t* data, size_t length) {
+  while (length > 0) {
+    if (blockLength == kBlake3BlockLen) {
+      compressInPlace(chunkCv, block, kBlake3BlockLen, chunkCounter, blocksCompressed == 0 ? kChunkStart : 0);
+      blocksCompressed++;
+      blockLength = 0;
+    }
+    size_t take = std::min(length, kBlake3BlockLen - blockLength);
+    memcpy(block + blockLength, data, take);
+    blockLength += take;
+    data += take;
+    length -= take;
+  }
+}
+
+void Blake3::pushCv(const uint8_t cv[kBlake3OutLen], uint64_t totalSubtrees) {
+  uint8_t node[kBlake3OutLen];
+  memcpy(node, cv, kBlake3OutLen);
+  // Every trailing zero bit of the count completes a larger subtree
+  while ((totalSubtrees & 1) == 0) {
+    uint8_t pair[2 * kBlake3OutLen];
+    cvStackLength--;
+    memcpy(pair, cvStack + cvStackLength * kBlake3OutLen, kBlake3OutLen);
+    memcpy(pair + kBlake3OutLen, node, kBlake3OutLen);
+    hashOne(pair, 1, 0, kParent, 0, 0, node);
+    totalSubtrees >>= 1;
+  }
+  memcpy(cvStack + cvStackLength * kBlake3OutLen, node, kBlake3OutLen);
+  cvStackLength++;
+}
+
+void Blake3::update(const uint8_t* data, size_t length) {
+  size_t chunkLength = blocksCompressed * kBlake3BlockLen + blockLength;
+  if (chunkLength > 0) {
+    size_t take = std::min(length, kBlake3ChunkLen - chunkLength);
+    chunkUpdate(data, take);
+    data += take;
+    length -= take;
+    if (length == 0) {
+      return;
+    }
+    // More input follows, so the full chunk isn't the root
+    uint32_t cv[8];
+    memcpy(cv, chunkCv, sizeof(cv));
+    compressInPlace(cv, block, blockLength, chunkCounter, (blocksCompressed == 0 ? kChunkStart : 0) | kChunkEnd);
+    uint8_t cvBytes[kBlake3OutLen];
+    storeCv(cvBytes, cv);
+    chunkCounter++;
+    pushCv(cvBytes, chunkCounter);
+    memcpy(chunkCv, kIv, sizeof(chunkCv));
+    blockLength = 0;
+    blocksCompressed = 0;
+  }
+  // Whole chunks go through the SIMD kernels, at least one byte is kept back for the end flags.
+  // Aligned batches are pushed as one subtree, so their parents go through the kernels as well
+  while (length > kBlake3ChunkLen) {
+    size_t chunks = std::min((length - 1) / kBlake3ChunkLen, kBatchChunks - chunkCounter % kBatchChunks);
+    uint8_t cvs[kBatchChunks * kBlake3OutLen];
+    hashChunks(data, chunks, chunkCounter, cvs);
+    if (chunks == kBatchChunks) {
+      uint8_t scratch[kBatchChunks / 2 * kBlake3OutLen];
+      uint8_t cv[kBlake3OutLen];
+      hashOne(reduceToTopChildren(cvs, scratch, chunks), 1, 0, kParent, 0, 0, cv);
+      chunkCounter += chunks;
+      pushCv(cv, chunkCounter / kBatchChunks);
+    } else {
+      for (size_t i = 0; i < chunks; i++) {
+        chunkCounter++;
+        pushCv(cvs + i * kBlake3OutLen, chunkCounter);
+      }
+    }
+    data += chunks * kBlake3ChunkLen;
+    length -= chunks * kBlake3ChunkLen;
+  }
+  chunkUpdate(data, length);
+}
+
+void Blake3::final(uint8_t out[kBlake3OutLen]) const {
+  uint8_t last[kBlake3BlockLen] = {0};
+  memcpy(last, block, blockLength);
+  uint8_t flags = (blocksCompressed == 0 ? kChunkStart : 0) | kChunkEnd;
+  if (cvStackLength == 0) {
+    rootOutput(chunkCv, last, blockLength, flags, out);
+    return;
+  }
+  // The current chunk is the rightmost leaf, the stack is merged into it from the right
+  uint32_t cv[8];
+  memcpy(cv, chunkCv, sizeof(cv));
+  compressInPlace(cv, last, blockLength, chunkCounter, flags);
+  uint8_t pair[2 * kBlake3OutLen];
+  storeCv(pair + kBlake3OutLen, cv);
+  for (size_t i = cvStackLength; i-- > 0;) {
+    memcpy(pair, cvStack + i * kBlake3OutLen, kBlake3OutLen);
+    uint32_t parentKey[8];
+    memcpy(parentKey, kIv, sizeof(parentKey));
+    if (i == 0) {
+      rootOutput(parentKey, pair, kBlake3BlockLen, kParent, out);
+      return;
+    }
+    compressInPlace(parentKey, pair, kBlake3BlockLen, 0, kParent);
+    storeCv(pair + kBlake3OutLen, parentKey);
+  }
+}
+
+void blake3SubtreeCv(const uint8_t* data, size_t length, uint64_t chunkCounter, uint8_t cv[kBlake3OutLen]) {
+  size_t wholeChunks = length / kBlake3ChunkLen;
+  size_t tail = length % kBlake3ChunkLen;
+  size_t count = wholeChunks + (tail > 0 ? 1 : 0);
+  std::vector<uint8_t> cvs(count * kBlake3OutLen);
+  hashChunks(data, wholeChunks, chunkCounter, cvs.data());
+  if (tail > 0) {
+    hashPartialChunk(data + wholeChunks * kBlake3ChunkLen, tail, chunkCounter + wholeChunks, cvs.data() + wholeChunks * kBlake3OutLen);
+  }
+  if (count == 1) {
+    memcpy(cv, cvs.data(), kBlake3OutLen);
+    return;
+  }
+  std::vector<uint8_t> scratch((count + 1) / 2 * kBlake3OutLen);
+  hashOne(reduceToTopChildren(cvs.data(), scratch.data(), count), 1, 0, kParent, 0, 0, cv);
+}
+
+void blake3RootFromSubtrees(const uint8_t* cvs, size_t count, uint8_t out[kBlake3OutLen]) {
+  std::vector<uint8_t> nodes(cvs, cvs + count * kBlake3OutLen);
+  std::vector<uint8_t> scratch((count + 1) / 2 * kBlake3OutLen);
+  uint32_t key[8];
+  memcpy(key, kIv, sizeof(key));
+  rootOutput(key, reduceToTopChildren(nodes.data(), scratch.data(), count), kBlake3BlockLen, kParent, out);
+}
+
+}
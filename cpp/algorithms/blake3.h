@@ -0,0 +1,57 @@
+//
+//  blake3.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cmpayc::rnfsturbo {
+
+inline constexpr size_t kBlake3OutLen = 32;
+inline constexpr size_t kBlake3BlockLen = 64;
+inline constexpr size_t kBlake3ChunkLen = 1024;
+
+// BLAKE3 in hash mode with the default 32 byte output. Whole 1 KB chunks are compressed several
+// at a time, one per SIMD lane (AVX2 or SSE4.1 when the CPU has them, NEON on arm64)
+class Blake3 {
+public:
+  Blake3();
+
+  void update(const uint8_t* data, size_t length);
+  void final(uint8_t out[kBlake3OutLen]) const;
+
+private:
+  void chunkUpdate(const uint8_t* data, size_t length);
+  // totalSubtrees counts the subtrees of the size of cv so far, including it
+  void pushCv(const uint8_t cv[kBlake3OutLen], uint64_t totalSubtrees);
+
+  // Current chunk, a full block is only compressed once more input arrives,
+  // the last one of the input needs the end flags
+  uint32_t chunkCv[8];
+  uint64_t chunkCounter{0};
+  uint8_t block[kBlake3BlockLen];
+  uint8_t blockLength{0};
+  uint8_t blocksCompressed{0};
+
+  // Chaining values of the completed subtrees, one per set bit of the chunk count
+  uint8_t cvStack[54 * kBlake3OutLen];
+  uint8_t cvStackLength{0};
+};
+
+// Building blocks for hashing one input on several threads. The tree of BLAKE3 splits off the largest
+// power of two number of chunks on the left, so aligned subtrees of 2^n chunks can be hashed independently.
+
+// Chaining value of the subtree over data, which starts at chunk chunkCounter of the input. length has to be
+// a power of two number of chunks, only the last subtree of the input may be shorter. Not for the whole input.
+void blake3SubtreeCv(const uint8_t* data, size_t length, uint64_t chunkCounter, uint8_t cv[kBlake3OutLen]);
+
+// Digest of an input split into count >= 2 subtrees of the same size (except the last one),
+// cvs holds their chaining values back to back
+void blake3RootFromSubtrees(const uint8_t* cvs, size_t count, uint8_t out[kBlake3OutLen]);
+
+}
@@ -0,0 +1,86 @@
+//
+//  crc32.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <zlib.h>
+#include "crc32.h"
+
+#if defined(__aarch64__) && defined(__clang__)
+#define RNFSTURBO_HAS_ARM_CRC32 1
+#include <arm_acle.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#endif
+
+namespace cmpayc::rnfsturbo {
+
+#ifdef RNFSTURBO_HAS_ARM_CRC32
+// CRC32X/CRC32B use the zip polynomial (the CRC32C variants are Castagnoli)
+__attribute__((target("crc")))
+static uint32_t crc32Arm(uint32_t crc, const uint8_t* data, size_t length) {
+  crc = ~crc;
+  while (length > 0 && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+    crc = __crc32b(crc, *data++);
+    length--;
+  }
+  while (length >= 32) {
+    uint64_t words[4];
+    memcpy(words, data, sizeof(words));
+    crc = __crc32d(crc, words[0]);
+    crc = __crc32d(crc, words[1]);
+    crc = __crc32d(crc, words[2]);
+    crc = __crc32d(crc, words[3]);
+    data += 32;
+    length -= 32;
+  }
+  while (length >= 8) {
+    uint64_t word;
+    memcpy(&word, data, sizeof(word));
+    crc = __crc32d(crc, word);
+    data += 8;
+    length -= 8;
+  }
+  while (length > 0) {
+    crc = __crc32b(crc, *data++);
+    length--;
+  }
+  return ~crc;
+}
+
+static bool hasArmCrc32() {
+#if defined(__APPLE__)
+  // Every arm64 Apple CPU implements the CRC32 instructions
+  return true;
+#elif defined(__linux__)
+  static const bool available = (getauxval(AT_HWCAP) & HWCAP_CRC32) != 0;
+  return available;
+#else
+  return false;
+#endif
+}
+#endif
+
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length) {
+#ifdef RNFSTURBO_HAS_ARM_CRC32
+  if (hasArmCrc32()) {
+    return crc32Arm(crc, data, length);
+  }
+#endif
+  while (length > 0) {
+    uInt chunk = static_cast<uInt>(std::min<size_t>(length, UINT_MAX));
+    crc = static_cast<uint32_t>(crc32(crc, data, chunk));
+    data += chunk;
+    length -= chunk;
+  }
+  return crc;
+}
+
+}
@@ -0,0 +1,19 @@
+//
+//  crc32.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cmpayc::rnfsturbo {
+
+// CRC-32 as used by zip and gzip, start with crc = 0 and pass the previous result to continue.
+// Uses the ARMv8 CRC32 instructions when the CPU has them, zlib's table-driven crc32 otherwise.
+uint32_t crc32Update(uint32_t crc, const uint8_t* data, size_t length);
+
+}
@@ -0,0 +1,239 @@
+//
+//  hasher.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <climits>
+#include <vector>
+#include "blake3.h"
+#include "hasher.h"
+#include "md5.h"
+#include "sha1.h"
+#include "sha224.h"
+#include "sha256.h"
+#include "sha384.h"
+#include "sha512.h"
+
+namespace cmpayc::rnfsturbo {
+
+// The vendored implementations take 32-bit lengths
+static constexpr size_t kMaxUpdateLength = 1u << 30;
+
+std::string toHex(const unsigned char* digest, size_t length) {
+  static constexpr char kHexDigits[] = "0123456789abcdef";
+  std::string hex(length * 2, '0');
+  for (size_t i = 0; i < length; i++) {
+    hex[i * 2] = kHexDigits[digest[i] >> 4];
+    hex[i * 2 + 1] = kHexDigits[digest[i] & 0x0f];
+  }
+  return hex;
+}
+
+// md5 and sha1 only produce hex digests
+static void fromHex(const std::string& hex, uint8_t* out) {
+  auto nibble = [](char c) -> uint8_t {
+    return c <= '9' ? c - '0' : (c | 0x20) - 'a' + 10;
+  };
+  for (size_t i = 0; i + 1 < hex.size(); i += 2) {
+    out[i / 2] = (nibble(hex[i]) << 4) | nibble(hex[i + 1]);
+  }
+}
+
+namespace {
+
+class Md5Hasher : public Hasher {
+public:
+  void update(const uint8_t* data, size_t length) override {
+    while (length > 0) {
+      size_t chunk = std::min(length, kMaxUpdateLength);
+      ctx.update(data, static_cast<MD5::size_type>(chunk));
+      data += chunk;
+      length -= chunk;
+    }
+  }
+
+  std::string hexDigest() override {
+    return ctx.finalize().hexdigest();
+  }
+
+  void digest(uint8_t* out) override {
+    fromHex(hexDigest(), out);
+  }
+
+  size_t digestSize() const override {
+    return 16;
+  }
+
+private:
+  MD5 ctx;
+};
+
+class Sha1Hasher : public Hasher {
+public:
+  void update(const uint8_t* data, size_t length) override {
+    ctx.update(std::string(reinterpret_cast<const char*>(data), length));
+  }
+
+  std::string hexDigest() override {
+    return ctx.final();
+  }
+
+  void digest(uint8_t* out) override {
+    fromHex(hexDigest(), out);
+  }
+
+  size_t digestSize() const override {
+    return 20;
+  }
+
+private:
+  SHA1 ctx;
+};
+
+// SHA224/256/384/512 share the init/update/final interface
+template <typename Context>
+class Sha2Hasher : public Hasher {
+public:
+  Sha2Hasher() {
+    ctx.init();
+  }
+
+  void update(const uint8_t* data, size_t length) override {
+    while (length > 0) {
+      size_t chunk = std::min(length, kMaxUpdateLength);
+      ctx.update(data, static_cast<unsigned int>(chunk));
+      data += chunk;
+      length -= chunk;
+    }
+  }
+
+  std::string hexDigest() override {
+    unsigned char digest[Context::DIGEST_SIZE];
+    ctx.final(digest);
+    return toHex(digest, Context::DIGEST_SIZE);
+  }
+
+  void digest(uint8_t* out) override {
+    ctx.final(out);
+  }
+
+  size_t digestSize() const override {
+    return Context::DIGEST_SIZE;
+  }
+
+private:
+  Context ctx;
+};
+
+class Blake3Hasher : public Hasher {
+public:
+  void update(const uint8_t* data, size_t length) override {
+    ctx.update(data, length);
+  }
+
+  std::string hexDigest() override {
+    uint8_t digest[kBlake3OutLen];
+    ctx.final(digest);
+    return toHex(digest, kBlake3OutLen);
+  }
+
+  void digest(uint8_t* out) override {
+    ctx.final(out);
+  }
+
+  size_t digestSize() const override {
+    return kBlake3OutLen;
+  }
+
+private:
+  Blake3 ctx;
+};
+
+// The outer hash only sees the padded key and the inner digest
+class HmacHasher : public Hasher {
+public:
+  HmacHasher(std::unique_ptr<Hasher> inner, std::unique_ptr<Hasher> outer) : inner(std::move(inner)), outer(std::move(outer)) {}
+
+  void update(const uint8_t* data, size_t length) override {
+    inner->update(data, length);
+  }
+
+  std::string hexDigest() override {
+    finishOuter();
+    return outer->hexDigest();
+  }
+
+  void digest(uint8_t* out) override {
+    finishOuter();
+    outer->digest(out);
+  }
+
+  size_t digestSize() const override {
+    return outer->digestSize();
+  }
+
+private:
+  void finishOuter() {
+    uint8_t innerDigest[64];
+    inner->digest(innerDigest);
+    outer->update(innerDigest, inner->digestSize());
+  }
+
+  std::unique_ptr<Hasher> inner;
+  std::unique_ptr<Hasher> outer;
+};
+
+}
+
+std::unique_ptr<Hasher> Hasher::create(std::string_view algorithm) {
+  if (algorithm == "md5") {
+    return std::make_unique<Md5Hasher>();
+  } else if (algorithm == "sha1") {
+    return std::make_unique<Sha1Hasher>();
+  } else if (algorithm == "sha224") {
+    return std::make_unique<Sha2Hasher<SHA224>>();
+  } else if (algorithm == "sha256") {
+    return std::make_unique<Sha2Hasher<SHA256>>();
+  } else if (algorithm == "sha384") {
+    return std::make_unique<Sha2Hasher<SHA384>>();
+  } else if (algorithm == "sha512") {
+    return std::make_unique<Sha2Hasher<SHA512>>();
+  } else if (algorithm == "blake3") {
+    return std::make_unique<Blake3Hasher>();
+  }
+  return nullptr;
+}
+
+std::unique_ptr<Hasher> Hasher::createHmac(std::string_view algorithm, const uint8_t* key, size_t keyLength) {
+  std::unique_ptr<Hasher> inner = create(algorithm);
+  if (inner == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<Hasher> outer = create(algorithm);
+  size_t blockSize = algorithm == "sha384" || algorithm == "sha512" ? 128 : 64;
+
+  std::vector<uint8_t> blockKey(blockSize, 0);
+  if (keyLength > blockSize) {
+    std::unique_ptr<Hasher> keyHasher = create(algorithm);
+    keyHasher->update(key, keyLength);
+    keyHasher->digest(blockKey.data());
+  } else if (keyLength > 0) {
+    std::copy(key, key + keyLength, blockKey.begin());
+  }
+  std::vector<uint8_t> pad(blockSize);
+  for (size_t i = 0; i < blockSize; i++) {
+    pad[i] = blockKey[i] ^ 0x36;
+  }
+  inner->update(pad.data(), blockSize);
+  for (size_t i = 0; i < blockSize; i++) {
+    pad[i] = blockKey[i] ^ 0x5c;
+  }
+  outer->update(pad.data(), blockSize);
+  std::fill(blockKey.begin(), blockKey.end(), 0);
+  return std::make_unique<HmacHasher>(std::move(inner), std::move(outer));
+}
+
+}
@@ -0,0 +1,43 @@
+//
+//  hasher.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cmpayc::rnfsturbo {
+
+// Incremental digest over the hash algorithms of the library, so data can be hashed chunk by chunk
+class Hasher {
+public:
+  virtual ~Hasher() = default;
+
+  virtual void update(const uint8_t* data, size_t length) = 0;
+
+  // Lowercase hex digest, the hasher can't be updated afterwards
+  virtual std::string hexDigest() = 0;
+
+  // Raw digest of digestSize() bytes, the hasher can't be updated afterwards
+  virtual void digest(uint8_t* out) = 0;
+
+  virtual size_t digestSize() const = 0;
+
+  // md5, sha1, sha224, sha256, sha384, sha512 or blake3, nullptr for anything else
+  static std::unique_ptr<Hasher> create(std::string_view algorithm);
+
+  // HMAC (RFC 2104) over the same algorithms, the digest is the MAC
+  static std::unique_ptr<Hasher> createHmac(std::string_view algorithm, const uint8_t* key, size_t keyLength);
+};
+
+// Lowercase hex of a raw digest
+std::string toHex(const unsigned char* digest, size_t length);
+
+}
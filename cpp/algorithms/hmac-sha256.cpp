@@ -0,0 +1,68 @@
+//
+//  hmac-sha256.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cstring>
+#include "hmac-sha256.h"
+
+namespace cmpayc::rnfsturbo {
+
+HmacSha256::HmacSha256(const uint8_t* key, size_t keyLength) {
+  uint8_t blockKey[kBlockSize] = {0};
+  if (keyLength > kBlockSize) {
+    SHA256 keyHash;
+    keyHash.init();
+    keyHash.update(key, static_cast<unsigned int>(keyLength));
+    keyHash.final(blockKey);
+  } else if (keyLength > 0) {
+    memcpy(blockKey, key, keyLength);
+  }
+  uint8_t pad[kBlockSize];
+  for (size_t i = 0; i < kBlockSize; i++) {
+    pad[i] = blockKey[i] ^ 0x36;
+  }
+  innerStart.init();
+  innerStart.update(pad, kBlockSize);
+  for (size_t i = 0; i < kBlockSize; i++) {
+    pad[i] = blockKey[i] ^ 0x5c;
+  }
+  outerStart.init();
+  outerStart.update(pad, kBlockSize);
+  reset();
+}
+
+void HmacSha256::reset() {
+  inner = innerStart;
+}
+
+void HmacSha256::update(const uint8_t* data, size_t length) {
+  // The vendored implementation takes 32-bit lengths
+  while (length > 0) {
+    size_t chunk = std::min<size_t>(length, 1u << 30);
+    inner.update(data, static_cast<unsigned int>(chunk));
+    data += chunk;
+    length -= chunk;
+  }
+}
+
+void HmacSha256::final(uint8_t digest[kHmacSha256Size]) {
+  uint8_t innerDigest[kHmacSha256Size];
+  inner.final(innerDigest);
+  SHA256 outer = outerStart;
+  outer.update(innerDigest, kHmacSha256Size);
+  outer.final(digest);
+}
+
+bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length) {
+  uint8_t difference = 0;
+  for (size_t i = 0; i < length; i++) {
+    difference |= a[i] ^ b[i];
+  }
+  return difference == 0;
+}
+
+}
@@ -0,0 +1,40 @@
+//
+//  hmac-sha256.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "sha256.h"
+
+namespace cmpayc::rnfsturbo {
+
+inline constexpr size_t kHmacSha256Size = SHA256::DIGEST_SIZE;
+
+// HMAC-SHA256 (RFC 2104), the key is hashed first when it is longer than a block.
+// The states after the padded key blocks are kept, so every message costs two compressions less
+class HmacSha256 {
+public:
+  HmacSha256(const uint8_t* key, size_t keyLength);
+
+  // Starts a new message with the same key
+  void reset();
+  void update(const uint8_t* data, size_t length);
+  void final(uint8_t digest[kHmacSha256Size]);
+
+private:
+  static constexpr size_t kBlockSize = 64;
+
+  SHA256 innerStart;
+  SHA256 outerStart;
+  SHA256 inner;
+};
+
+// Compares without an early exit, so the time doesn't tell how many leading bytes matched
+bool constantTimeEquals(const uint8_t* a, const uint8_t* b, size_t length);
+
+}
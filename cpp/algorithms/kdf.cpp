@@ -0,0 +1,94 @@
+//
+//  kdf.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cstring>
+#include "hmac-sha256.h"
+#include "kdf.h"
+
+namespace cmpayc::rnfsturbo {
+
+void pbkdf2Sha256(
+  const uint8_t* password,
+  size_t passwordLength,
+  const uint8_t* salt,
+  size_t saltLength,
+  uint32_t iterations,
+  uint8_t* out,
+  size_t outLength
+) {
+  // The padded password blocks are hashed once, every iteration then costs two compressions
+  HmacSha256 hmac(password, passwordLength);
+  uint32_t blockIndex = 1;
+  while (outLength > 0) {
+    uint8_t counter[4] = {
+      static_cast<uint8_t>(blockIndex >> 24),
+      static_cast<uint8_t>(blockIndex >> 16),
+      static_cast<uint8_t>(blockIndex >> 8),
+      static_cast<uint8_t>(blockIndex),
+    };
+    uint8_t u[kHmacSha256Size];
+    uint8_t block[kHmacSha256Size];
+    hmac.reset();
+    hmac.update(salt, saltLength);
+    hmac.update(counter, sizeof(counter));
+    hmac.final(u);
+    memcpy(block, u, kHmacSha256Size);
+    for (uint32_t i = 1; i < iterations; i++) {
+      hmac.reset();
+      hmac.update(u, kHmacSha256Size);
+      hmac.final(u);
+      for (size_t j = 0; j < kHmacSha256Size; j++) {
+        block[j] ^= u[j];
+      }
+    }
+    size_t length = std::min(outLength, kHmacSha256Size);
+    memcpy(out, block, length);
+    out += length;
+    outLength -= length;
+    blockIndex++;
+  }
+}
+
+void hkdfSha256(
+  const uint8_t* inputKey,
+  size_t inputKeyLength,
+  const uint8_t* salt,
+  size_t saltLength,
+  const uint8_t* info,
+  size_t infoLength,
+  uint8_t* out,
+  size_t outLength
+) {
+  if (outLength > 255 * kHmacSha256Size) {
+    throw "HKDF output is too long";
+  }
+  // Extract, HMAC with a zero-length key is the same as with a block of zeros
+  uint8_t pseudoRandomKey[kHmacSha256Size];
+  HmacSha256 extract(salt, saltLength);
+  extract.update(inputKey, inputKeyLength);
+  extract.final(pseudoRandomKey);
+
+  // Expand, T(i) = HMAC(PRK, T(i - 1) | info | i)
+  HmacSha256 expand(pseudoRandomKey, kHmacSha256Size);
+  uint8_t t[kHmacSha256Size];
+  size_t tLength = 0;
+  for (uint8_t i = 1; outLength > 0; i++) {
+    expand.reset();
+    expand.update(t, tLength);
+    expand.update(info, infoLength);
+    expand.update(&i, 1);
+    expand.final(t);
+    tLength = kHmacSha256Size;
+    size_t length = std::min(outLength, kHmacSha256Size);
+    memcpy(out, t, length);
+    out += length;
+    outLength -= length;
+  }
+}
+
+}
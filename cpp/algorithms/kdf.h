@@ -0,0 +1,39 @@
+//
+//  kdf.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cmpayc::rnfsturbo {
+
+// PBKDF2-HMAC-SHA256 (RFC 8018), fills outLength bytes
+void pbkdf2Sha256(
+  const uint8_t* password,
+  size_t passwordLength,
+  const uint8_t* salt,
+  size_t saltLength,
+  uint32_t iterations,
+  uint8_t* out,
+  size_t outLength
+);
+
+// HKDF-SHA256 (RFC 5869) extract and expand, at most 255 * 32 bytes of output.
+// An empty salt means a block of zeros, as in the RFC
+void hkdfSha256(
+  const uint8_t* inputKey,
+  size_t inputKeyLength,
+  const uint8_t* salt,
+  size_t saltLength,
+  const uint8_t* info,
+  size_t infoLength,
+  uint8_t* out,
+  size_t outLength
+);
+
+}
@@ -0,0 +1,168 @@
+//
+//  lz4-block.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <cstring>
+#include <vector>
+#include "lz4-block.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kMinMatch = 4;
+// The last 5 bytes are always literals and the last match starts 12 bytes before the end at the latest
+static constexpr size_t kLastLiterals = 5;
+static constexpr size_t kMatchFindLimit = 12;
+static constexpr size_t kMaxOffset = 65535;
+static constexpr int kHashLog = 14;
+// Literal runs longer than 2^kSkipTrigger bytes advance faster through incompressible data
+static constexpr int kSkipTrigger = 6;
+
+static inline uint32_t read32(const uint8_t* p) {
+  uint32_t value;
+  memcpy(&value, p, sizeof(value));
+  return value;
+}
+
+static inline uint32_t hashPosition(const uint8_t* p) {
+  return (read32(p) * 2654435761u) >> (32 - kHashLog);
+}
+
+static uint8_t* writeLength(uint8_t* op, size_t length) {
+  while (length >= 255) {
+    *op++ = 255;
+    length -= 255;
+  }
+  *op++ = static_cast<uint8_t>(length);
+  return op;
+}
+
+static uint8_t* writeSequence(
+  uint8_t* op,
+  const uint8_t* literals,
+  size_t literalLength,
+  size_t offset,
+  size_t matchLength
+) {
+  uint8_t* token = op++;
+  *token = static_cast<uint8_t>((literalLength >= 15 ? 15 : literalLength) << 4);
+  if (literalLength >= 15) {
+    op = writeLength(op, literalLength - 15);
+  }
+  memcpy(op, literals, literalLength);
+  op += literalLength;
+  if (matchLength == 0) {
+    // Last sequence, literals only
+    return op;
+  }
+  *op++ = static_cast<uint8_t>(offset);
+  *op++ = static_cast<uint8_t>(offset >> 8);
+  size_t matchCode = matchLength - kMinMatch;
+  *token |= static_cast<uint8_t>(matchCode >= 15 ? 15 : matchCode);
+  if (matchCode >= 15) {
+    op = writeLength(op, matchCode - 15);
+  }
+  return op;
+}
+
+size_t lz4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst) {
+  uint8_t* op = dst;
+  size_t anchor = 0;
+  if (srcSize > kMatchFindLimit) {
+    // Positions + 1, 0 is an empty slot
+    std::vector<uint32_t> table(size_t{1} << kHashLog, 0);
+    size_t matchFindLimit = srcSize - kMatchFindLimit;
+    size_t matchLimit = srcSize - kLastLiterals;
+    size_t ip = 0;
+    while (ip <= matchFindLimit) {
+      uint32_t hash = hashPosition(src + ip);
+      size_t candidate = table[hash];
+      table[hash] = static_cast<uint32_t>(ip + 1);
+      if (candidate == 0 || ip - (candidate - 1) > kMaxOffset || read32(src + candidate - 1) != read32(src + ip)) {
+        ip += 1 + ((ip - anchor) >> kSkipTrigger);
+        continue;
+      }
+      size_t ref = candidate - 1;
+      while (ip > anchor && ref > 0 && src[ip - 1] == src[ref - 1]) {
+        ip--;
+        ref--;
+      }
+      size_t matchLength = kMinMatch;
+      while (ip + matchLength < matchLimit && src[ip + matchLength] == src[ref + matchLength]) {
+        matchLength++;
+      }
+      op = writeSequence(op, src + anchor, ip - anchor, ip - ref, matchLength);
+      ip += matchLength;
+      anchor = ip;
+      if (ip - 2 <= matchFindLimit) {
+        table[hashPosition(src + ip - 2)] = static_cast<uint32_t>(ip - 2 + 1);
+      }
+    }
+  }
+  op = writeSequence(op, src + anchor, srcSize - anchor, 0, 0);
+  return op - dst;
+}
+
+static bool readLength(const uint8_t* src, size_t srcSize, size_t& ip, size_t& length) {
+  uint8_t byte;
+  do {
+    if (ip >= srcSize) {
+      return false;
+    }
+    byte = src[ip++];
+    length += byte;
+  } while (byte == 255);
+  return true;
+}
+
+size_t lz4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity) {
+  size_t ip = 0;
+  size_t op = 0;
+  while (true) {
+    if (ip >= srcSize) {
+      throw "Invalid compressed data";
+    }
+    uint8_t token = src[ip++];
+    size_t literalLength = token >> 4;
+    if (literalLength == 15 && !readLength(src, srcSize, ip, literalLength)) {
+      throw "Invalid compressed data";
+    }
+    if (literalLength > srcSize - ip || literalLength > dstCapacity - op) {
+      throw "Invalid compressed data";
+    }
+    memcpy(dst + op, src + ip, literalLength);
+    ip += literalLength;
+    op += literalLength;
+    if (ip == srcSize) {
+      return op;
+    }
+
+    if (srcSize - ip < 2) {
+      throw "Invalid compressed data";
+    }
+    size_t offset = src[ip] | (src[ip + 1] << 8);
+    ip += 2;
+    size_t matchLength = token & 15;
+    if (matchLength == 15 && !readLength(src, srcSize, ip, matchLength)) {
+      throw "Invalid compressed data";
+    }
+    matchLength += kMinMatch;
+    if (offset == 0 || offset > op || matchLength > dstCapacity - op) {
+      throw "Invalid compressed data";
+    }
+    const uint8_t* match = dst + op - offset;
+    if (offset >= matchLength) {
+      memcpy(dst + op, match, matchLength);
+    } else {
+      // Overlapping copy repeats the last offset bytes
+      for (size_t i = 0; i < matchLength; i++) {
+        dst[op + i] = match[i];
+      }
+    }
+    op += matchLength;
+  }
+}
+
+}
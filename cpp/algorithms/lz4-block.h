@@ -0,0 +1,30 @@
+//
+//  lz4-block.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cmpayc::rnfsturbo {
+
+// Encoder and decoder of the LZ4 block format (https://github.com/lz4/lz4/blob/dev/doc/lz4_Block_format.md).
+// The output can be decoded by any LZ4 implementation, but the encoder is a plain greedy one,
+// so the ratio is a bit lower than the reference LZ4_compress_default.
+
+// Largest possible compressed size of srcSize bytes
+constexpr size_t lz4CompressBound(size_t srcSize) {
+  return srcSize + srcSize / 255 + 16;
+}
+
+// dst has to hold lz4CompressBound(srcSize) bytes, returns the compressed size
+size_t lz4Compress(const uint8_t* src, size_t srcSize, uint8_t* dst);
+
+// Returns the decompressed size, throws on corrupt input or when the output doesn't fit into dstCapacity
+size_t lz4Decompress(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity);
+
+}
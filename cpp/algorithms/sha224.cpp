@@ -38,6 +38,7 @@
 #include <cstring>
 #include <fstream>
 #include "sha224.h"
+#include "sha256.h"
  
 const unsigned int SHA224::sha256_k[64] = //UL = uint32
             {0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
@@ -98,7 +99,7 @@ void SHA224::final(unsigned char *digest)
 {
     unsigned int block_nb;
     unsigned int pm_len;
-    unsigned int len_b;
+    uint64 len_b;
     int i;
     block_nb = (1 + ((SHA224_256_BLOCK_SIZE - 9)
                      < (m_len % SHA224_256_BLOCK_SIZE)));
@@ -106,7 +107,8 @@ void SHA224::final(unsigned char *digest)
     pm_len = block_nb << 6;
     memset(m_block + m_len, 0, pm_len - m_len);
     m_block[m_len] = 0x80;
-    SHA2_UNPACK32(len_b, m_block + pm_len - 4);
+    SHA2_UNPACK32((uint32) len_b, m_block + pm_len - 4);
+    SHA2_UNPACK32((uint32) (len_b >> 32), m_block + pm_len - 8);
     transform(m_block, block_nb);
     for (i = 0 ; i < 7; i++) {
         SHA2_UNPACK32(m_h[i], &digest[i << 2]);
@@ -115,6 +117,10 @@ void SHA224::final(unsigned char *digest)
  
 void SHA224::transform(const unsigned char *message, unsigned int block_nb)
 {
+    // Same compression function as SHA-256, only the initial state differs
+    if (sha256CompressHardware(m_h, message, block_nb)) {
+        return;
+    }
     uint32 w[64];
     uint32 wv[8];
     uint32 t1, t2;
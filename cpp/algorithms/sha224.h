@@ -57,7 +57,7 @@ public:
  
 protected:
     void transform(const unsigned char *message, unsigned int block_nb);
-    unsigned int m_tot_len;
+    uint64 m_tot_len;
     unsigned int m_len;
     unsigned char m_block[2*SHA224_256_BLOCK_SIZE];
     uint32 m_h[8];
@@ -38,6 +38,19 @@
 #include <cstring>
 #include <fstream>
 #include "sha256.h"
+
+#if defined(__aarch64__) && defined(__clang__)
+#define SHA256_HAS_ARM_SHA2 1
+#include <arm_neon.h>
+#if defined(__linux__)
+#include <asm/hwcap.h>
+#include <sys/auxv.h>
+#endif
+#elif defined(__x86_64__) && (defined(__clang__) || defined(__GNUC__))
+#define SHA256_HAS_X86_SHA 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
  
 const unsigned int SHA256::sha256_k[64] = //UL = uint32
             {0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5,
@@ -57,8 +70,121 @@ const unsigned int SHA256::sha256_k[64] = //UL = uint32
              0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
              0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2};
  
+#ifdef SHA256_HAS_ARM_SHA2
+// ARMv8 SHA256H/SHA256H2 do four rounds each, SHA256SU0/SU1 extend the message four words at a time
+__attribute__((target("sha2")))
+static void sha256CompressArm(unsigned int state[8], const unsigned char *data, unsigned int blocks)
+{
+    uint32x4_t abcd = vld1q_u32(&state[0]);
+    uint32x4_t efgh = vld1q_u32(&state[4]);
+    for (unsigned int block = 0; block < blocks; block++, data += 64) {
+        const uint32x4_t abcdSaved = abcd;
+        const uint32x4_t efghSaved = efgh;
+        uint32x4_t msg[4];
+        for (int i = 0; i < 4; i++) {
+            msg[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + i * 16)));
+        }
+        for (int i = 0; i < 16; i++) {
+            const uint32x4_t wk = vaddq_u32(msg[i & 3], vld1q_u32(&SHA256::sha256_k[i * 4]));
+            if (i < 12) {
+                msg[i & 3] = vsha256su1q_u32(vsha256su0q_u32(msg[i & 3], msg[(i + 1) & 3]), msg[(i + 2) & 3], msg[(i + 3) & 3]);
+            }
+            const uint32x4_t abcdPrev = abcd;
+            abcd = vsha256hq_u32(abcd, efgh, wk);
+            efgh = vsha256h2q_u32(efgh, abcdPrev, wk);
+        }
+        abcd = vaddq_u32(abcd, abcdSaved);
+        efgh = vaddq_u32(efgh, efghSaved);
+    }
+    vst1q_u32(&state[0], abcd);
+    vst1q_u32(&state[4], efgh);
+}
+
+static bool hasArmSha2()
+{
+#if defined(__APPLE__)
+    // Every arm64 Apple CPU implements the SHA2 instructions
+    return true;
+#elif defined(__linux__)
+    static const bool available = (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+    return available;
+#else
+    return false;
+#endif
+}
+#endif
+
+#ifdef SHA256_HAS_X86_SHA
+// SHA-NI keeps the state as ABEF/CDGH, SHA256RNDS2 does two rounds per call
+__attribute__((target("sha,sse4.1")))
+static void sha256CompressX86(unsigned int state[8], const unsigned char *data, unsigned int blocks)
+{
+    const __m128i byteSwap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+    __m128i dcba = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[0])), 0xB1);
+    __m128i hgfe = _mm_shuffle_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i *>(&state[4])), 0x1B);
+    __m128i abef = _mm_alignr_epi8(dcba, hgfe, 8);
+    __m128i cdgh = _mm_blend_epi16(hgfe, dcba, 0xF0);
+    for (unsigned int block = 0; block < blocks; block++, data += 64) {
+        const __m128i abefSaved = abef;
+        const __m128i cdghSaved = cdgh;
+        __m128i msg[4];
+        for (int i = 0; i < 4; i++) {
+            msg[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i * 16)), byteSwap);
+        }
+        for (int i = 0; i < 16; i++) {
+            __m128i wk = _mm_add_epi32(msg[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i *>(&SHA256::sha256_k[i * 4])));
+            if (i < 12) {
+                __m128i next = _mm_sha256msg1_epu32(msg[i & 3], msg[(i + 1) & 3]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(msg[(i + 3) & 3], msg[(i + 2) & 3], 4));
+                msg[i & 3] = _mm_sha256msg2_epu32(next, msg[(i + 3) & 3]);
+            }
+            cdgh = _mm_sha256rnds2_epu32(cdgh, abef, wk);
+            wk = _mm_shuffle_epi32(wk, 0x0E);
+            abef = _mm_sha256rnds2_epu32(abef, cdgh, wk);
+        }
+        abef = _mm_add_epi32(abef, abefSaved);
+        cdgh = _mm_add_epi32(cdgh, cdghSaved);
+    }
+    __m128i feba = _mm_shuffle_epi32(abef, 0x1B);
+    __m128i dchg = _mm_shuffle_epi32(cdgh, 0xB1);
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[0]), _mm_blend_epi16(feba, dchg, 0xF0));
+    _mm_storeu_si128(reinterpret_cast<__m128i *>(&state[4]), _mm_alignr_epi8(dchg, feba, 8));
+}
+
+static bool hasX86Sha()
+{
+    static const bool available = [] {
+        unsigned int eax, ebx, ecx, edx;
+        if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx) || (ecx & bit_SSE4_1) == 0) {
+            return false;
+        }
+        return __get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) && (ebx & bit_SHA) != 0;
+    }();
+    return available;
+}
+#endif
+
+bool sha256CompressHardware(unsigned int state[8], const unsigned char *data, unsigned int blocks)
+{
+#if defined(SHA256_HAS_ARM_SHA2)
+    if (hasArmSha2()) {
+        sha256CompressArm(state, data, blocks);
+        return true;
+    }
+#elif defined(SHA256_HAS_X86_SHA)
+    if (hasX86Sha()) {
+        sha256CompressX86(state, data, blocks);
+        return true;
+    }
+#endif
+    return false;
+}
+
 void SHA256::transform(const unsigned char *message, unsigned int block_nb)
 {
+    if (sha256CompressHardware(m_h, message, block_nb)) {
+        return;
+    }
     uint32 w[64];
     uint32 wv[8];
     uint32 t1, t2;
@@ -136,7 +262,7 @@ void SHA256::final(unsigned char *digest)
 {
     unsigned int block_nb;
     unsigned int pm_len;
-    unsigned int len_b;
+    uint64 len_b;
     int i;
     block_nb = (1 + ((SHA224_256_BLOCK_SIZE - 9)
                      < (m_len % SHA224_256_BLOCK_SIZE)));
@@ -144,7 +270,8 @@ void SHA256::final(unsigned char *digest)
     pm_len = block_nb << 6;
     memset(m_block + m_len, 0, pm_len - m_len);
     m_block[m_len] = 0x80;
-    SHA2_UNPACK32(len_b, m_block + pm_len - 4);
+    SHA2_UNPACK32((uint32) len_b, m_block + pm_len - 4);
+    SHA2_UNPACK32((uint32) (len_b >> 32), m_block + pm_len - 8);
     transform(m_block, block_nb);
     for (i = 0 ; i < 8; i++) {
         SHA2_UNPACK32(m_h[i], &digest[i << 2]);
@@ -46,9 +46,10 @@ protected:
     typedef unsigned int uint32;
     typedef unsigned long long uint64;
  
-    const static uint32 sha256_k[];
     static const unsigned int SHA224_256_BLOCK_SIZE = (512/8);
 public:
+    // Round constants, also used by the hardware compression functions
+    const static uint32 sha256_k[];
     void init();
     void update(const unsigned char *message, unsigned int len);
     void final(unsigned char *digest);
@@ -56,13 +57,17 @@ public:
  
 protected:
     void transform(const unsigned char *message, unsigned int block_nb);
-    unsigned int m_tot_len;
+    uint64 m_tot_len;
     unsigned int m_len;
     unsigned char m_block[2*SHA224_256_BLOCK_SIZE];
     uint32 m_h[8];
 };
  
 std::string sha256(std::string input);
+
+// SHA-256 compression of whole blocks with the ARMv8 SHA2 or x86 SHA extensions,
+// false (state untouched) when the CPU has neither
+bool sha256CompressHardware(unsigned int state[8], const unsigned char *data, unsigned int blocks);
  
 #define SHA2_SHFR(x, n)    (x >> n)
 #define SHA2_ROTR(x, n)   ((x >> n) | (x << ((sizeof(x) << 3) - n)))
@@ -122,7 +122,7 @@ void SHA384::final(unsigned char *digest)
 {
     unsigned int block_nb;
     unsigned int pm_len;
-    unsigned int len_b;
+    uint64 len_b;
     int i;
     block_nb = (1 + ((SHA384_512_BLOCK_SIZE - 17)
                      < (m_len % SHA384_512_BLOCK_SIZE)));
@@ -130,7 +130,8 @@ void SHA384::final(unsigned char *digest)
     pm_len = block_nb << 7;
     memset(m_block + m_len, 0, pm_len - m_len);
     m_block[m_len] = 0x80;
-    SHA2_UNPACK32(len_b, m_block + pm_len - 4);
+    SHA2_UNPACK32((uint32) len_b, m_block + pm_len - 4);
+    SHA2_UNPACK32((uint32) (len_b >> 32), m_block + pm_len - 8);
     transform(m_block, block_nb);
     for (i = 0 ; i < 6; i++) {
         SHA2_UNPACK64(m_h[i], &digest[i << 3]);
@@ -0,0 +1,424 @@
+//
+//  chunked-encryption.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+#ifdef RNFSTURBO_USE_ENCRYPTION
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if !defined(__APPLE__) && !defined(__ANDROID__)
+#include <sys/random.h>
+#endif
+#include "../algorithms/hmac-sha256.h"
+#include "../algorithms/Krypt/AES.hpp"
+#include "../filesystem/unique-fd.h"
+#include "../filesystem/worker-pool.h"
+#include "chunked-encryption.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr char kChunkedMagic[4] = {'R', 'F', 'E', 'C'};
+static constexpr uint8_t kChunkedVersion = 1;
+static constexpr uint8_t kChunkedFlagMac = 0x01;
+static constexpr size_t kChunkedHeaderSize = 48;
+// The key check covers everything before it
+static constexpr size_t kChunkedCheckedHeaderSize = 32;
+static constexpr size_t kKeyCheckSize = 16;
+static constexpr size_t kFileIdSize = 16;
+static constexpr size_t kNonceSize = 16;
+static constexpr size_t kAesBlockSize = 16;
+static constexpr uint32_t kChunkSize = 64 * 1024;
+static constexpr uint32_t kMaxChunkSize = 16 * 1024 * 1024;
+// Chunks handed to the workers at once, bounds the memory of large writes and reads
+static constexpr size_t kChunksPerWorker = 16;
+static constexpr char kMacKeyLabel[] = "react-native-fs-turbo chunked encryption mac key";
+
+namespace {
+
+struct ChunkedKeys {
+  const std::vector<unsigned char>& aesKey;
+  // Separate key for the tags, derived from the passphrase
+  uint8_t macKey[kHmacSha256Size];
+};
+
+struct ChunkedLayout {
+  uint8_t fileId[kFileIdSize];
+  bool mac;
+  uint32_t chunkSize;
+  uint64_t chunkCount;
+  uint64_t dataSize;
+
+  size_t tagSize() const {
+    return mac ? kHmacSha256Size : 0;
+  }
+
+  // Size of a full chunk on disk
+  uint64_t stride() const {
+    return kNonceSize + chunkSize + tagSize();
+  }
+
+  uint64_t chunkOffset(uint64_t index) const {
+    return kChunkedHeaderSize + index * stride();
+  }
+
+  size_t chunkLength(uint64_t index) const {
+    return static_cast<size_t>(std::min<uint64_t>(chunkSize, dataSize - index * chunkSize));
+  }
+};
+
+}
+
+static void putLe32(uint8_t* p, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    p[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+static uint32_t getLe32(const uint8_t* p) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    value |= static_cast<uint32_t>(p[i]) << (8 * i);
+  }
+  return value;
+}
+
+static void preadAll(int fd, uint8_t* data, size_t length, uint64_t offset) {
+  while (length > 0) {
+    ssize_t bytesRead = pread(fd, data, length, offset);
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    if (bytesRead == 0) {
+      throw "Unexpected end of file";
+    }
+    data += bytesRead;
+    length -= bytesRead;
+    offset += bytesRead;
+  }
+}
+
+static void pwriteAll(int fd, const uint8_t* data, size_t length, uint64_t offset) {
+  while (length > 0) {
+    ssize_t written = pwrite(fd, data, length, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    data += written;
+    length -= written;
+    offset += written;
+  }
+}
+
+static void randomBytes(uint8_t* data, size_t length) {
+#if defined(__APPLE__) || defined(__ANDROID__)
+  arc4random_buf(data, length);
+#else
+  while (length > 0) {
+    ssize_t filled = getrandom(data, length, 0);
+    if (filled < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    data += filled;
+    length -= filled;
+  }
+#endif
+}
+
+static ChunkedKeys deriveKeys(const std::vector<unsigned char>& passphrase) {
+  ChunkedKeys keys{passphrase, {}};
+  HmacSha256 hmac(passphrase.data(), passphrase.size());
+  hmac.update(reinterpret_cast<const uint8_t*>(kMacKeyLabel), sizeof(kMacKeyLabel) - 1);
+  hmac.final(keys.macKey);
+  return keys;
+}
+
+static void computeKeyCheck(const ChunkedKeys& keys, const uint8_t* header, uint8_t keyCheck[kKeyCheckSize]) {
+  uint8_t digest[kHmacSha256Size];
+  HmacSha256 hmac(keys.macKey, sizeof(keys.macKey));
+  hmac.update(header, kChunkedCheckedHeaderSize);
+  hmac.final(digest);
+  memcpy(keyCheck, digest, kKeyCheckSize);
+}
+
+// XORs `length` bytes with the AES-CTR keystream starting `offset` bytes into the chunk,
+// the nonce is the initial 128-bit big-endian counter block. `in` and `out` may be the same.
+static void aesCtrXor(Krypt::BlockCipher::AES& aes, const uint8_t* nonce, uint64_t offset, const uint8_t* in, uint8_t* out, size_t length) {
+  uint8_t counter[kAesBlockSize];
+  memcpy(counter, nonce, kAesBlockSize);
+  uint64_t blockIndex = offset / kAesBlockSize;
+  for (int i = kAesBlockSize - 1; i >= 0 && blockIndex > 0; i--) {
+    uint64_t sum = counter[i] + (blockIndex & 0xff);
+    counter[i] = static_cast<uint8_t>(sum);
+    blockIndex = (blockIndex >> 8) + (sum >> 8);
+  }
+  uint8_t keystream[kAesBlockSize];
+  size_t skip = static_cast<size_t>(offset % kAesBlockSize);
+  for (size_t pos = 0; pos < length;) {
+    aes.EncryptBlock(counter, keystream);
+    size_t count = std::min(kAesBlockSize - skip, length - pos);
+    for (size_t i = 0; i < count; i++) {
+      out[pos + i] = in[pos + i] ^ keystream[skip + i];
+    }
+    pos += count;
+    skip = 0;
+    for (int i = kAesBlockSize - 1; i >= 0 && ++counter[i] == 0; i--) {
+    }
+  }
+}
+
+// `sealed` is the nonce followed by the ciphertext
+static void computeTag(HmacSha256& hmac, const ChunkedLayout& layout, uint64_t index, bool last, const uint8_t* sealed, size_t sealedLength, uint8_t tag[kHmacSha256Size]) {
+  uint8_t position[9];
+  for (int i = 0; i < 8; i++) {
+    position[i] = static_cast<uint8_t>(index >> (8 * i));
+  }
+  position[8] = last ? 1 : 0;
+  hmac.reset();
+  hmac.update(layout.fileId, kFileIdSize);
+  hmac.update(position, sizeof(position));
+  hmac.update(sealed, sealedLength);
+  hmac.final(tag);
+}
+
+// `chunk` holds the nonce and gets the ciphertext and the tag after it
+static void sealChunk(Krypt::BlockCipher::AES& aes, HmacSha256& hmac, const ChunkedLayout& layout, uint64_t index, bool last, const uint8_t* plain, size_t length, uint8_t* chunk) {
+  aesCtrXor(aes, chunk, 0, plain, chunk + kNonceSize, length);
+  if (layout.mac) {
+    computeTag(hmac, layout, index, last, chunk, kNonceSize + length, chunk + kNonceSize + length);
+  }
+}
+
+static void verifyChunk(HmacSha256& hmac, const ChunkedLayout& layout, uint64_t index, const uint8_t* chunk, size_t length) {
+  if (!layout.mac) {
+    return;
+  }
+  uint8_t tag[kHmacSha256Size];
+  computeTag(hmac, layout, index, index + 1 == layout.chunkCount, chunk, kNonceSize + length, tag);
+  if (!constantTimeEquals(tag, chunk + kNonceSize + length, kHmacSha256Size)) {
+    throw "Authentication failed";
+  }
+}
+
+static ChunkedLayout readLayout(int fd, const ChunkedKeys& keys) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    throw strerror(errno);
+  }
+  uint64_t fileSize = st.st_size;
+  if (fileSize < kChunkedHeaderSize) {
+    throw "Not a chunked encrypted file";
+  }
+  uint8_t header[kChunkedHeaderSize];
+  preadAll(fd, header, sizeof(header), 0);
+  if (memcmp(header, kChunkedMagic, 4) != 0) {
+    throw "Not a chunked encrypted file";
+  }
+  if (header[4] != kChunkedVersion) {
+    throw "Unsupported encrypted file version";
+  }
+  // Also fails when the flags or the chunk size were changed, so the MAC can't be turned off
+  uint8_t keyCheck[kKeyCheckSize];
+  computeKeyCheck(keys, header, keyCheck);
+  if (!constantTimeEquals(keyCheck, header + kChunkedCheckedHeaderSize, kKeyCheckSize)) {
+    throw "Wrong passphrase";
+  }
+
+  ChunkedLayout layout;
+  layout.mac = (header[5] & kChunkedFlagMac) != 0;
+  layout.chunkSize = getLe32(header + 8);
+  memcpy(layout.fileId, header + 16, kFileIdSize);
+  if (layout.chunkSize == 0 || layout.chunkSize > kMaxChunkSize) {
+    throw "Corrupt encrypted file";
+  }
+  uint64_t body = fileSize - kChunkedHeaderSize;
+  uint64_t fullChunks = body / layout.stride();
+  uint64_t rest = body % layout.stride();
+  // Only an empty file ends with an empty chunk
+  uint64_t minRest = kNonceSize + layout.tagSize() + (fullChunks > 0 ? 1 : 0);
+  if (rest != 0 && rest < minRest) {
+    throw "Corrupt encrypted file";
+  }
+  layout.chunkCount = fullChunks + (rest != 0 ? 1 : 0);
+  layout.dataSize = fullChunks * layout.chunkSize + (rest != 0 ? rest - kNonceSize - layout.tagSize() : 0);
+  if (layout.chunkCount == 0) {
+    throw "Corrupt encrypted file";
+  }
+  if (layout.mac) {
+    // Only the real last chunk is tagged as last, a file cut off at a chunk boundary fails here
+    uint64_t last = layout.chunkCount - 1;
+    size_t lastLength = layout.chunkLength(last);
+    std::vector<uint8_t> chunk(kNonceSize + lastLength + layout.tagSize());
+    preadAll(fd, chunk.data(), chunk.size(), layout.chunkOffset(last));
+    HmacSha256 hmac(keys.macKey, sizeof(keys.macKey));
+    verifyChunk(hmac, layout, last, chunk.data(), lastLength);
+  }
+  return layout;
+}
+
+void writeChunkedEncryptedFile(
+  const char* filePath,
+  std::string_view content,
+  const std::vector<unsigned char>& passphrase,
+  bool mac,
+  bool isAppend
+) {
+  ChunkedKeys keys = deriveKeys(passphrase);
+  UniqueFd fd(open(filePath, O_RDWR | O_CREAT | O_CLOEXEC | (isAppend ? 0 : O_TRUNC), 0644));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+
+  ChunkedLayout layout;
+  // Plaintext of a partial last chunk, re-encrypted together with the appended data
+  std::string prefix;
+  uint64_t firstChunk{0};
+  // Tag of a full last chunk that is no longer the last one, written after the new chunks
+  std::vector<uint8_t> retag;
+  uint64_t retagOffset{0};
+  if (isAppend && lseek(fd.get(), 0, SEEK_END) > 0) {
+    // Appends keep the chunk size and MAC setting of the file
+    layout = readLayout(fd.get(), keys);
+    if (content.empty()) {
+      return;
+    }
+    firstChunk = layout.chunkCount;
+    uint64_t last = layout.chunkCount - 1;
+    size_t lastLength = layout.chunkLength(last);
+    std::vector<uint8_t> chunk(kNonceSize + lastLength + layout.tagSize());
+    preadAll(fd.get(), chunk.data(), chunk.size(), layout.chunkOffset(last));
+    if (lastLength < layout.chunkSize) {
+      // Also the empty chunk of an empty file, the new chunks replace it
+      Krypt::BlockCipher::AES aes(keys.aesKey.data(), keys.aesKey.size());
+      prefix.resize(lastLength);
+      aesCtrXor(aes, chunk.data(), 0, chunk.data() + kNonceSize, reinterpret_cast<uint8_t*>(prefix.data()), lastLength);
+      firstChunk = last;
+    } else if (layout.mac) {
+      // The full last chunk stays, only its tag changes as it is no longer the last one
+      HmacSha256 hmac(keys.macKey, sizeof(keys.macKey));
+      retag.resize(kHmacSha256Size);
+      computeTag(hmac, layout, last, false, chunk.data(), kNonceSize + lastLength, retag.data());
+      retagOffset = layout.chunkOffset(last) + kNonceSize + lastLength;
+    }
+  } else {
+    layout.mac = mac;
+    layout.chunkSize = kChunkSize;
+    layout.chunkCount = 0;
+    layout.dataSize = 0;
+    randomBytes(layout.fileId, kFileIdSize);
+    uint8_t header[kChunkedHeaderSize] = {0};
+    memcpy(header, kChunkedMagic, 4);
+    header[4] = kChunkedVersion;
+    header[5] = mac ? kChunkedFlagMac : 0;
+    putLe32(header + 8, layout.chunkSize);
+    memcpy(header + 16, layout.fileId, kFileIdSize);
+    computeKeyCheck(keys, header, header + kChunkedCheckedHeaderSize);
+    pwriteAll(fd.get(), header, sizeof(header), 0);
+  }
+
+  // Chunk j of the new data starts at byte j * chunkSize of prefix + content.
+  // An empty file still gets one (empty) chunk, its tag marks the end of the file
+  uint64_t total = prefix.size() + content.size();
+  uint64_t chunkCount = total == 0 ? 1 : (total + layout.chunkSize - 1) / layout.chunkSize;
+  size_t batchSize = workerCount() * kChunksPerWorker;
+  std::vector<uint8_t> sealed;
+  for (uint64_t batch = 0; batch < chunkCount; batch += batchSize) {
+    size_t count = static_cast<size_t>(std::min<uint64_t>(batchSize, chunkCount - batch));
+    uint64_t batchEnd = std::min<uint64_t>(total, (batch + count) * layout.chunkSize);
+    sealed.resize((count - 1) * layout.stride() + kNonceSize + (batchEnd - (batch + count - 1) * layout.chunkSize) + layout.tagSize());
+    for (size_t i = 0; i < count; i++) {
+      randomBytes(sealed.data() + i * layout.stride(), kNonceSize);
+    }
+    parallelFor(count, 1, [&](size_t begin, size_t end) {
+      Krypt::BlockCipher::AES aes(keys.aesKey.data(), keys.aesKey.size());
+      HmacSha256 hmac(keys.macKey, sizeof(keys.macKey));
+      std::string joined;
+      for (size_t i = begin; i < end; i++) {
+        uint64_t j = batch + i;
+        uint64_t start = j * layout.chunkSize;
+        size_t length = static_cast<size_t>(std::min<uint64_t>(layout.chunkSize, total - start));
+        const char* plain;
+        if (start < prefix.size()) {
+          joined.assign(prefix).append(content.substr(0, length - prefix.size()));
+          plain = joined.data();
+        } else {
+          plain = content.data() + (start - prefix.size());
+        }
+        sealChunk(aes, hmac, layout, firstChunk + j, j + 1 == chunkCount, reinterpret_cast<const uint8_t*>(plain), length, sealed.data() + i * layout.stride());
+      }
+    });
+    pwriteAll(fd.get(), sealed.data(), sealed.size(), layout.chunkOffset(firstChunk + batch));
+  }
+  // Until now the old last chunk still ends the file correctly, so an interrupted append leaves it readable
+  if (!retag.empty()) {
+    pwriteAll(fd.get(), retag.data(), retag.size(), retagOffset);
+  }
+}
+
+std::string readChunkedEncryptedFile(
+  const char* filePath,
+  const std::vector<unsigned char>& passphrase,
+  uint64_t offset,
+  uint64_t length
+) {
+  ChunkedKeys keys = deriveKeys(passphrase);
+  UniqueFd fd(open(filePath, O_RDONLY | O_CLOEXEC));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  ChunkedLayout layout = readLayout(fd.get(), keys);
+  if (offset >= layout.dataSize) {
+    return {};
+  }
+  uint64_t end = length == 0 ? layout.dataSize : std::min(layout.dataSize, offset + length);
+  uint64_t firstChunk = offset / layout.chunkSize;
+  uint64_t lastChunk = (end - 1) / layout.chunkSize + 1;
+
+  std::string result(end - offset, '\0');
+  uint8_t* out = reinterpret_cast<uint8_t*>(result.data());
+  size_t batchSize = workerCount() * kChunksPerWorker;
+  std::vector<uint8_t> sealed;
+  for (uint64_t batch = firstChunk; batch < lastChunk;) {
+    uint64_t batchEnd = std::min<uint64_t>(lastChunk, batch + batchSize);
+    // Chunks are contiguous in the file, one read covers the batch
+    uint64_t batchFileOffset = layout.chunkOffset(batch);
+    uint64_t batchFileEnd = layout.chunkOffset(batchEnd - 1) + kNonceSize + layout.chunkLength(batchEnd - 1) + layout.tagSize();
+    sealed.resize(batchFileEnd - batchFileOffset);
+    preadAll(fd.get(), sealed.data(), sealed.size(), batchFileOffset);
+
+    parallelFor(batchEnd - batch, 1, [&](size_t rangeBegin, size_t rangeEnd) {
+      Krypt::BlockCipher::AES aes(keys.aesKey.data(), keys.aesKey.size());
+      HmacSha256 hmac(keys.macKey, sizeof(keys.macKey));
+      for (uint64_t index = batch + rangeBegin; index < batch + rangeEnd; index++) {
+        const uint8_t* chunk = sealed.data() + (index - batch) * layout.stride();
+        size_t chunkLength = layout.chunkLength(index);
+        verifyChunk(hmac, layout, index, chunk, chunkLength);
+        // CTR can start anywhere, only the requested part of a chunk is decrypted
+        uint64_t chunkStart = index * layout.chunkSize;
+        uint64_t copyFrom = std::max(offset, chunkStart);
+        uint64_t copyTo = std::min(end, chunkStart + chunkLength);
+        aesCtrXor(aes, chunk, copyFrom - chunkStart, chunk + kNonceSize + (copyFrom - chunkStart), out + (copyFrom - offset), copyTo - copyFrom);
+      }
+    });
+    batch = batchEnd;
+  }
+  return result;
+}
+
+}
+
+#endif
@@ -0,0 +1,51 @@
+//
+//  chunked-encryption.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+#ifdef RNFSTURBO_USE_ENCRYPTION
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+// Encrypted file of independently encrypted 64 KB chunks, so parts of it can be read and
+// appended without touching the rest. All integers little-endian:
+//
+//   header  "RFEC", u8 version, u8 flags (bit 0 = MAC), u16 reserved, u32 chunk size, u32 reserved,
+//           16 byte random file id, 16 byte key check (truncated HMAC of the first 32 header bytes)
+//   chunks  16 byte random nonce, AES-CTR ciphertext, 32 byte HMAC-SHA256 tag when MAC is on
+//
+// Every chunk has the same size on disk except the last one, so chunk offsets follow from the index.
+// A file has at least one chunk, an empty file is a single empty chunk. The tag covers the file id, the
+// chunk index, whether the chunk is the last one, the nonce and the ciphertext: chunks can't be swapped
+// or moved to another file unnoticed. The tag of the last chunk is checked on every open, so with MAC
+// a file cut off at the end (even at a chunk boundary, or down to the header) is rejected.
+// A chunk gets a fresh nonce every time it is written. The passphrase is the AES key (16, 24 or 32 bytes).
+
+// Appending re-encrypts only the last chunk when it isn't full
+void writeChunkedEncryptedFile(
+  const char* filePath,
+  std::string_view content,
+  const std::vector<unsigned char>& passphrase,
+  bool mac,
+  bool isAppend
+);
+
+// Decrypts only the chunks covering [offset, offset + length), length 0 means up to the end.
+// The MAC setting comes from the header, which the key check protects.
+std::string readChunkedEncryptedFile(
+  const char* filePath,
+  const std::vector<unsigned char>& passphrase,
+  uint64_t offset,
+  uint64_t length
+);
+
+}
+
+#endif
@@ -0,0 +1,46 @@
+//
+//  decrypt-stage.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+#ifdef RNFSTURBO_USE_ENCRYPTION
+#include <cstring>
+#include "decrypt-stage.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kAesBlockSize = 16;
+
+DecryptStage::DecryptStage(std::unique_ptr<Mode::MODE> cipher, const std::vector<unsigned char>& iv)
+  : cipher(std::move(cipher)) {
+  if (iv.size() == kAesBlockSize) {
+    memcpy(this->iv, iv.data(), kAesBlockSize);
+  }
+}
+
+void DecryptStage::process(const uint8_t* data, size_t length, const ByteSink& emit) {
+  pending.insert(pending.end(), data, data + length);
+  if (pending.size() <= kAesBlockSize) {
+    return;
+  }
+  // Keep at least one full block for finish()
+  size_t ready = ((pending.size() - 1) / kAesBlockSize) * kAesBlockSize;
+  cipher->decryptBlocksInPlace(pending.data(), ready, iv);
+  emit(pending.data(), ready);
+  pending.erase(pending.begin(), pending.begin() + ready);
+}
+
+void DecryptStage::finish(const ByteSink& emit) {
+  if (pending.size() != kAesBlockSize) {
+    throw "Wrong encrypted data length";
+  }
+  cipher->decryptBlocksInPlace(pending.data(), kAesBlockSize, iv);
+  size_t length = cipher->PaddingScheme->UnpaddedLength(pending.data(), kAesBlockSize, kAesBlockSize);
+  emit(pending.data(), length);
+  pending.clear();
+}
+
+}
+
+#endif
@@ -0,0 +1,37 @@
+//
+//  decrypt-stage.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+#ifdef RNFSTURBO_USE_ENCRYPTION
+#include <memory>
+#include <vector>
+#include "../algorithms/Krypt/mode.hpp"
+#include "../filesystem/transform-pipeline.h"
+
+namespace cmpayc::rnfsturbo {
+
+using namespace Krypt;
+
+// Block by block AES decryption for pipelines, produces the same output as Mode::MODE::decrypt
+// on the whole input. The last block is held back until finish() so the padding can be removed.
+class DecryptStage : public TransformStage {
+public:
+  DecryptStage(std::unique_ptr<Mode::MODE> cipher, const std::vector<unsigned char>& iv);
+
+  void process(const uint8_t* data, size_t length, const ByteSink& emit) override;
+  void finish(const ByteSink& emit) override;
+
+private:
+  std::unique_ptr<Mode::MODE> cipher;
+  Bytes iv[16]{};
+  // Input that doesn't fill a block yet, plus the held back last block. Decrypted in place
+  std::vector<Bytes> pending;
+};
+
+}
+
+#endif
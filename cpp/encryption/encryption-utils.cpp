@@ -5,7 +5,11 @@
 //  Created by Sergei Kazakov on 16.09.24.
 //
 #ifdef RNFSTURBO_USE_ENCRYPTION
+#include <cerrno>
+#include <cstring>
+#include <fstream>
 #include "encryption-utils.h"
+#include "RNFSTurboKeyHostObject.h"
 #include "RNFSTurboLogger.h"
 
 namespace cmpayc::rnfsturbo {
@@ -61,6 +65,7 @@ std::unique_ptr<Mode::MODE> createCipherMode(
 void processEncryptionOptions(
   jsi::Runtime& runtime,
   const std::string& propName,
+  const RNFSTurboPropNames& propNames,
   jsi::Object& optionsObject,
   bool &encrypted,
   int &passphraseLength,
@@ -68,20 +73,25 @@ void processEncryptionOptions(
   int &ivLength,
   std::vector<unsigned char> &iv,
   std::string &mode,
-  std::string &padding
+  std::string &padding,
+  bool &mac
 ) {
-  if (optionsObject.hasProperty(runtime, "encrypted")) {
-    auto encryptedOption = optionsObject.getProperty(runtime, "encrypted");
-    if (encryptedOption.isBool()) {
-      encrypted = encryptedOption.asBool();
-    }
+  auto encryptedOption = optionsObject.getProperty(runtime, propNames[PropKey::Encrypted]);
+  if (encryptedOption.isBool()) {
+    encrypted = encryptedOption.asBool();
   }
-  if (optionsObject.hasProperty(runtime, "passphrase")) {
-    auto passphraseOption = optionsObject.getProperty(runtime, "passphrase");
+  auto passphraseOption = optionsObject.getProperty(runtime, propNames[PropKey::Passphrase]);
+  bool derivedKey{false};
+  if (!passphraseOption.isUndefined()) {
     if (passphraseOption.isString()) {
       std::string passphraseString = passphraseOption.asString(runtime).utf8(runtime);
       passphraseLength = passphraseString.size();
       passphrase.assign(passphraseString.begin(), passphraseString.end());
+    } else if (passphraseOption.isObject() && passphraseOption.asObject(runtime).isHostObject<RNFSTurboKeyHostObject>(runtime)) {
+      // Returned by deriveKey, used as is
+      passphrase = passphraseOption.asObject(runtime).getHostObject<RNFSTurboKeyHostObject>(runtime)->key();
+      passphraseLength = passphrase.size();
+      derivedKey = true;
     } else if (passphraseOption.isObject()) {
       jsi::Array passphraseArr = passphraseOption.asObject(runtime).asArray(runtime);
       if (!passphraseArr.isArray(runtime)) {
@@ -94,17 +104,22 @@ void processEncryptionOptions(
         ));
       }
     } else {
-      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Passphrase has to be of type string or number[]"));
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Passphrase has to be of type string, number[] or a derived key"));
     }
   }
-  if (encrypted && propName != "readFile" && propName != "writeFile") {
-    throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Encryption is only available for the readFile and writeFile methods"));
+  auto kdfOption = optionsObject.getProperty(runtime, propNames[PropKey::Kdf]);
+  if (kdfOption.isObject() && !passphraseOption.isUndefined()) {
+    if (derivedKey) {
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "A derived key can't be derived again"));
+    }
+    passphrase = deriveKey(passphrase, parseKdfOptions(runtime, propName, propNames, kdfOption.asObject(runtime)));
+    passphraseLength = passphrase.size();
   }
-  if (encrypted && passphraseLength != 16 && passphraseLength != 25 && passphraseLength != 32) {
+  if (encrypted && passphraseLength != 16 && passphraseLength != 24 && passphraseLength != 32) {
     throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Passphrase length should be 16, 24 or 32"));
   }
-  if (optionsObject.hasProperty(runtime, "iv")) {
-    auto ivOption = optionsObject.getProperty(runtime, "iv");
+  auto ivOption = optionsObject.getProperty(runtime, propNames[PropKey::Iv]);
+  if (!ivOption.isUndefined()) {
     if (ivOption.isString()) {
       std::string ivString = ivOption.asString(runtime).utf8(runtime);
       ivLength = ivString.size();
@@ -128,20 +143,20 @@ void processEncryptionOptions(
       throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "IV length should be equal 16"));
     }
   }
-  if (optionsObject.hasProperty(runtime, "mode")) {
-    auto modeOption = optionsObject.getProperty(runtime, "mode");
+  auto modeOption = optionsObject.getProperty(runtime, propNames[PropKey::Mode]);
+  if (!modeOption.isUndefined()) {
     if (modeOption.isString()) {
       mode = modeOption.asString(runtime).utf8(runtime);
     }
-    if (mode != "ecb" && mode != "cbc" && mode != "cfb") {
-      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Only ecb, cbc and cfb modes allowed"));
+    if (mode != "ecb" && mode != "cbc" && mode != "cfb" && mode != "chunked") {
+      throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Only ecb, cbc, cfb and chunked modes allowed"));
     }
     if ((mode == "cbc" || mode == "cfb") && ivLength == 0) {
       throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "IV required for cbc and cfb"));
     }
   }
-  if (optionsObject.hasProperty(runtime, "padding")) {
-    auto paddingOption = optionsObject.getProperty(runtime, "padding");
+  auto paddingOption = optionsObject.getProperty(runtime, propNames[PropKey::Padding]);
+  if (!paddingOption.isUndefined()) {
     if (paddingOption.isString()) {
       padding = paddingOption.asString(runtime).utf8(runtime);
     }
@@ -155,6 +170,73 @@ void processEncryptionOptions(
       throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Only ansi_x9.23, iso/iec_7816-4, pkcs5/pkcs7, zero and no paddings allowed"));
     }
   }
+  auto macOption = optionsObject.getProperty(runtime, propNames[PropKey::Mac]);
+  if (macOption.isBool()) {
+    mac = macOption.asBool();
+  }
+  // The chunked format can be read partially and appended to, the others only as a whole
+  if (encrypted && propName != "readFile" && propName != "writeFile" && !(mode == "chunked" && (propName == "read" || propName == "appendFile"))) {
+    throw jsi::JSError(runtime, RNFSTurboLogger::sprintf("%s: %s", propName.c_str(), "Encryption is only available for the readFile and writeFile methods, and for read and appendFile in chunked mode"));
+  }
+}
+
+void writeEncryptedFile(
+  const char* filePath,
+  std::string& content,
+  Mode::MODE& cipher,
+  const std::vector<unsigned char>& iv,
+  bool isAppend
+) {
+  const size_t blockSize = cipher.Encryption->BLOCK_SIZE;
+  Bytes chain[16]{};
+  if (iv.size() == blockSize) {
+    memcpy(chain, iv.data(), blockSize);
+  }
+  // Growing the buffer by the padding would reallocate and copy it, so the tail block is encrypted apart
+  size_t blocksLength = content.size() - content.size() % blockSize;
+  Bytes *data = reinterpret_cast<Bytes*>(content.data());
+  cipher.encryptBlocksInPlace(data, blocksLength, chain);
+  Bytes tail[16];
+  size_t tailLength = cipher.encryptInto(data + blocksLength, content.size() - blocksLength, tail, chain);
+
+  std::ofstream outputFile(filePath, isAppend ? std::ios::ate|std::ios::app|std::ios::binary : std::ios::binary);
+  if (!outputFile.is_open()) {
+    throw strerror(errno);
+  }
+  outputFile.write(content.data(), blocksLength);
+  outputFile.write(reinterpret_cast<const char*>(tail), tailLength);
+  outputFile.close();
+  if (outputFile.fail()) {
+    throw "Failed to write the file";
+  }
+}
+
+size_t encryptBuffer(
+  Mode::MODE& cipher,
+  const uint8_t* plain,
+  size_t length,
+  uint8_t* out,
+  const std::vector<unsigned char>& iv
+) {
+  // Krypt takes a mutable IV, ECB has none
+  Bytes chain[16]{};
+  if (iv.size() == cipher.Encryption->BLOCK_SIZE) {
+    memcpy(chain, iv.data(), iv.size());
+  }
+  return cipher.encryptInto(const_cast<Bytes*>(plain), length, out, chain);
+}
+
+size_t decryptBuffer(
+  Mode::MODE& cipher,
+  uint8_t* buffer,
+  size_t length,
+  const std::vector<unsigned char>& iv
+) {
+  Bytes chain[16]{};
+  if (iv.size() == cipher.Encryption->BLOCK_SIZE) {
+    memcpy(chain, iv.data(), iv.size());
+  }
+  return cipher.decryptInPlace(buffer, length, chain);
 }
 
 }
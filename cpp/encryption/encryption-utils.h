@@ -10,6 +10,7 @@
 #include <jsi/jsi.h>
 #include "../algorithms/Krypt/AES.hpp"
 #include "../algorithms/Krypt/mode.hpp"
+#include "../RNFSTurboPropNames.h"
 
 namespace cmpayc::rnfsturbo {
 
@@ -28,6 +29,7 @@ std::unique_ptr<Mode::MODE> createCipherMode(
 void processEncryptionOptions(
   jsi::Runtime& runtime,
   const std::string& propName,
+  const RNFSTurboPropNames& propNames,
   jsi::Object& optionsObject,
   bool &encrypted,
   int &passphraseLength,
@@ -35,7 +37,35 @@ void processEncryptionOptions(
   int &ivLength,
   std::vector<unsigned char> &iv,
   std::string &mode,
-  std::string &padding
+  std::string &padding,
+  bool &mac
+);
+
+// Encrypts the content in its own buffer and writes it, only the padded last block is encrypted on the stack
+void writeEncryptedFile(
+  const char* filePath,
+  std::string& content,
+  Mode::MODE& cipher,
+  const std::vector<unsigned char>& iv,
+  bool isAppend
+);
+
+// Encrypts length bytes of plain into out, which needs cipher.encryptedLength(length) bytes and may be plain itself.
+// Returns the encrypted length
+size_t encryptBuffer(
+  Mode::MODE& cipher,
+  const uint8_t* plain,
+  size_t length,
+  uint8_t* out,
+  const std::vector<unsigned char>& iv
+);
+
+// Decrypts in place, returns the length without the padding
+size_t decryptBuffer(
+  Mode::MODE& cipher,
+  uint8_t* buffer,
+  size_t length,
+  const std::vector<unsigned char>& iv
 );
 
 }
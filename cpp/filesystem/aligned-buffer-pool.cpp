@@ -0,0 +1,59 @@
+//
+//  aligned-buffer-pool.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <cstdlib>
+#include <cstring>
+#include <errno.h>
+#include "aligned-buffer-pool.h"
+#include "worker-pool.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kDirectIoBufferSize = 1024 * 1024;
+
+AlignedBufferPool::AlignedBufferPool(size_t bufferSize, size_t maxIdle) : bufferSize(bufferSize), maxIdle(maxIdle) {}
+
+AlignedBufferPool::~AlignedBufferPool() {
+  for (uint8_t* buffer : idle) {
+    free(buffer);
+  }
+}
+
+AlignedBufferPool::Lease AlignedBufferPool::acquire() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!idle.empty()) {
+      uint8_t* buffer = idle.back();
+      idle.pop_back();
+      return Lease(this, buffer);
+    }
+  }
+  void* buffer = nullptr;
+  if (posix_memalign(&buffer, kAlignment, bufferSize) != 0) {
+    throw strerror(ENOMEM);
+  }
+  return Lease(this, static_cast<uint8_t*>(buffer));
+}
+
+void AlignedBufferPool::release(uint8_t* buffer) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (idle.size() < maxIdle) {
+      idle.push_back(buffer);
+      return;
+    }
+  }
+  free(buffer);
+}
+
+AlignedBufferPool& AlignedBufferPool::directIo() {
+  // One buffer per copy worker
+  static AlignedBufferPool pool(kDirectIoBufferSize, workerCount());
+  return pool;
+}
+
+}
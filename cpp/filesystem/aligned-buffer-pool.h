@@ -0,0 +1,67 @@
+//
+//  aligned-buffer-pool.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+// Page aligned buffers for O_DIRECT I/O. Released buffers are kept for reuse
+// (up to maxIdle), so bulk transfers don't allocate per file.
+class AlignedBufferPool {
+public:
+  static constexpr size_t kAlignment = 4096;
+
+  class Lease {
+  public:
+    Lease(AlignedBufferPool* pool, uint8_t* buffer) : pool(pool), buffer(buffer) {}
+    Lease(Lease&& other) noexcept : pool(other.pool), buffer(std::exchange(other.buffer, nullptr)) {}
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+    ~Lease() {
+      if (buffer != nullptr) {
+        pool->release(buffer);
+      }
+    }
+
+    uint8_t* data() const {
+      return buffer;
+    }
+
+    size_t size() const {
+      return pool->bufferSize;
+    }
+
+  private:
+    AlignedBufferPool* pool;
+    uint8_t* buffer;
+  };
+
+  AlignedBufferPool(size_t bufferSize, size_t maxIdle);
+  ~AlignedBufferPool();
+
+  // Throws strerror(ENOMEM) when a new buffer can't be allocated
+  Lease acquire();
+
+  // Shared by the uncached copies, 1 MB buffers
+  static AlignedBufferPool& directIo();
+
+private:
+  void release(uint8_t* buffer);
+
+  const size_t bufferSize;
+  const size_t maxIdle;
+  std::mutex mutex;
+  std::vector<uint8_t*> idle;
+};
+
+}
@@ -0,0 +1,108 @@
+//
+//  allocate-utils.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "allocate-utils.h"
+#include "unique-fd.h"
+
+namespace cmpayc::rnfsturbo {
+
+static bool isNotSupported(int error) {
+  return error == EOPNOTSUPP || error == ENOTSUP || error == ENOSYS;
+}
+
+bool allocateRange(int fd, uint64_t offset, uint64_t length) {
+  if (length == 0) {
+    return true;
+  }
+#if defined(__linux__)
+  int res;
+  do {
+    res = fallocate(fd, FALLOC_FL_KEEP_SIZE, static_cast<off_t>(offset), static_cast<off_t>(length));
+  } while (res != 0 && errno == EINTR);
+  if (res == 0) {
+    return true;
+  }
+  if (isNotSupported(errno)) {
+    return false;
+  }
+  throw strerror(errno);
+#elif defined(__APPLE__)
+  // F_PREALLOCATE works from the physical end of file, so allocate what's missing up to offset + length
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    throw strerror(errno);
+  }
+  uint64_t allocated = static_cast<uint64_t>(st.st_blocks) * 512;
+  if (offset + length <= allocated) {
+    return true;
+  }
+  fstore_t store = {F_ALLOCATECONTIG | F_ALLOCATEALL, F_PEOFPOSMODE, 0, static_cast<off_t>(offset + length - allocated), 0};
+  if (fcntl(fd, F_PREALLOCATE, &store) == 0) {
+    return true;
+  }
+  // No contiguous run of that size, any blocks will do
+  store.fst_flags = F_ALLOCATEALL;
+  if (fcntl(fd, F_PREALLOCATE, &store) == 0) {
+    return true;
+  }
+  if (isNotSupported(errno)) {
+    return false;
+  }
+  throw strerror(errno);
+#else
+  return false;
+#endif
+}
+
+void allocateFile(const std::string& path, uint64_t size, bool keepSize) {
+  UniqueFd fd(open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0666));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  struct stat st;
+  if (fstat(fd.get(), &st) != 0) {
+    throw strerror(errno);
+  }
+  uint64_t currentSize = static_cast<uint64_t>(st.st_size);
+  [[maybe_unused]] bool allocated = allocateRange(fd.get(), 0, size);
+  if (keepSize || size <= currentSize) {
+    return;
+  }
+#if !defined(__APPLE__)
+  if (!allocated) {
+    // posix_fallocate falls back to writing zeros where the filesystem has no fallocate
+    int res = posix_fallocate(fd.get(), static_cast<off_t>(currentSize), static_cast<off_t>(size - currentSize));
+    if (res == 0) {
+      return;
+    }
+    if (!isNotSupported(res) && res != EINVAL) {
+      throw strerror(res);
+    }
+  }
+#endif
+  if (ftruncate(fd.get(), static_cast<off_t>(size)) != 0) {
+    throw strerror(errno);
+  }
+}
+
+void reserveFileSpace(const std::string& path, uint64_t length, bool truncate) {
+  UniqueFd fd(open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0666));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  struct stat st;
+  if (fstat(fd.get(), &st) != 0) {
+    throw strerror(errno);
+  }
+  allocateRange(fd.get(), static_cast<uint64_t>(st.st_size), length);
+}
+
+}
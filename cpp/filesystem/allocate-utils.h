@@ -0,0 +1,28 @@
+//
+//  allocate-utils.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace cmpayc::rnfsturbo {
+
+// Reserves disk space for [0, size) of the file, creating it if needed. With keepSize the
+// reported file size doesn't change, otherwise the file grows to `size` (never shrinks).
+// Throws strerror(ENOSPC) right away when the space isn't available.
+void allocateFile(const std::string& path, uint64_t size, bool keepSize);
+
+// Allocates blocks for [offset, offset + length) of an open file without touching the file size.
+// Returns false when the filesystem can't preallocate, the space is then allocated by the writes.
+bool allocateRange(int fd, uint64_t offset, uint64_t length);
+
+// Reserves `length` bytes for an upcoming write without changing the file size.
+// With truncate the file is emptied first, so the write has to append afterwards.
+void reserveFileSpace(const std::string& path, uint64_t length, bool truncate);
+
+}
@@ -0,0 +1,757 @@
+//
+//  archive-utils.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <fcntl.h>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <zlib.h>
+#include "../algorithms/crc32.h"
+#include "archive-utils.h"
+#include "dir-traversal.h"
+#include "unique-fd.h"
+#include "worker-pool.h"
+#include "zip-format.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kArchiveChunkSize = 256 * 1024;
+// Deflate window, every chunk after the first one is primed with this much of the previous chunk
+static constexpr size_t kDeflateDictionarySize = 32 * 1024;
+// Entries from this size on get zip64 sizes in the local header, which is written before the
+// compressed size is known, leaving room for the deflate overhead on incompressible data
+static constexpr uint64_t kZip64LocalThreshold = 0xff000000;
+static constexpr size_t kTarBlockSize = 512;
+// Largest value of the 11 octal digits of a ustar size field
+static constexpr uint64_t kTarMaxUstarSize = 077777777777ULL;
+
+namespace {
+
+struct ArchiveEntry {
+  // Relative path inside the archive, '/' separated
+  std::string name;
+  std::string path;
+  bool isDirectory;
+  uint64_t size;
+  mode_t mode;
+  time_t mtime;
+};
+
+// A chunk of an entry, the unit of work of the compressing workers
+struct ArchiveItem {
+  size_t entry;
+  uint64_t offset;
+  size_t length;
+  bool first;
+  bool last;
+};
+
+struct ArchiveChunk {
+  std::vector<uint8_t> data;
+  // CRC-32 of the original bytes of the chunk
+  uint32_t crc{0};
+  // Deflate didn't make the entry smaller, data holds the original bytes (single chunk entries only)
+  bool stored{false};
+  bool ready{false};
+};
+
+// Raw deflate of one chunk of an entry. Chunks other than the last one end with a sync flush
+// instead of a final block, so their outputs concatenate into a single deflate stream.
+class ChunkDeflater {
+public:
+  explicit ChunkDeflater(int level) {
+    if (deflateInit2(&stream, level, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+      throw "Failed to initialize compression";
+    }
+  }
+  ~ChunkDeflater() {
+    deflateEnd(&stream);
+  }
+  ChunkDeflater(const ChunkDeflater&) = delete;
+  ChunkDeflater& operator=(const ChunkDeflater&) = delete;
+
+  void compress(const uint8_t* dictionary, size_t dictionaryLength, const uint8_t* data, size_t length, bool last, std::vector<uint8_t>& out) {
+    deflateReset(&stream);
+    if (dictionaryLength > 0) {
+      deflateSetDictionary(&stream, dictionary, static_cast<uInt>(dictionaryLength));
+    }
+    out.resize(deflateBound(&stream, static_cast<uLong>(length)) + 16);
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = static_cast<uInt>(length);
+    stream.next_out = out.data();
+    stream.avail_out = static_cast<uInt>(out.size());
+    while (true) {
+      int status = deflate(&stream, last ? Z_FINISH : Z_SYNC_FLUSH);
+      if (status == Z_STREAM_ERROR) {
+        throw "Compression failed";
+      }
+      if (last ? status == Z_STREAM_END : (stream.avail_in == 0 && stream.avail_out > 0)) {
+        break;
+      }
+      size_t used = out.size() - stream.avail_out;
+      out.resize(out.size() * 2);
+      stream.next_out = out.data() + used;
+      stream.avail_out = static_cast<uInt>(out.size() - used);
+    }
+    out.resize(out.size() - stream.avail_out);
+  }
+
+private:
+  z_stream stream{};
+};
+
+struct WorkerState {
+  std::vector<uint8_t> input;
+  std::optional<ChunkDeflater> deflater;
+};
+
+}
+
+static void writeExact(int fd, const uint8_t* data, size_t length) {
+  while (length > 0) {
+    ssize_t written = write(fd, data, length);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    data += written;
+    length -= written;
+  }
+}
+
+static void pwriteExact(int fd, const uint8_t* data, size_t length, uint64_t offset) {
+  while (length > 0) {
+    ssize_t written = pwrite(fd, data, length, static_cast<off_t>(offset));
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    data += written;
+    length -= written;
+    offset += written;
+  }
+}
+
+namespace {
+
+// Archive file being written, headers and small entries are gathered into one buffer
+class ArchiveOutput {
+public:
+  explicit ArchiveOutput(int fd) : fd(fd) {
+    buffer.reserve(kArchiveChunkSize);
+  }
+
+  void append(const uint8_t* data, size_t length) {
+    if (buffer.size() + length > kArchiveChunkSize) {
+      flush();
+      if (length >= kArchiveChunkSize) {
+        writeExact(fd, data, length);
+        flushedSize += length;
+        return;
+      }
+    }
+    buffer.insert(buffer.end(), data, data + length);
+  }
+
+  void append(const std::vector<uint8_t>& data) {
+    append(data.data(), data.size());
+  }
+
+  // Overwrites bytes appended before, used for fields only known once an entry is complete
+  void patch(uint64_t offset, const std::vector<uint8_t>& data) {
+    flush();
+    pwriteExact(fd, data.data(), data.size(), offset);
+  }
+
+  void flush() {
+    writeExact(fd, buffer.data(), buffer.size());
+    flushedSize += buffer.size();
+    buffer.clear();
+  }
+
+  uint64_t offset() const {
+    return flushedSize + buffer.size();
+  }
+
+private:
+  int fd;
+  uint64_t flushedSize{0};
+  std::vector<uint8_t> buffer;
+};
+
+// Format specific part: which entries are deflated and how headers are laid out around the data
+class ArchiveWriter {
+public:
+  ArchiveWriter(ArchiveOutput& output, const std::vector<ArchiveEntry>& entries) : output(output), entries(entries) {}
+  virtual ~ArchiveWriter() = default;
+
+  // Called on the worker threads
+  virtual bool compresses(const ArchiveEntry& entry) const = 0;
+  virtual int level() const {
+    return Z_NO_COMPRESSION;
+  }
+
+  // Called on the writing thread for every chunk, in order
+  virtual void writeChunk(const ArchiveItem& item, const ArchiveChunk& chunk) = 0;
+  virtual void finish() = 0;
+
+protected:
+  ArchiveOutput& output;
+  const std::vector<ArchiveEntry>& entries;
+};
+
+class ZipWriter : public ArchiveWriter {
+public:
+  ZipWriter(ArchiveOutput& output, const std::vector<ArchiveEntry>& entries, const ZipOptions& options)
+    : ArchiveWriter(output, entries), compressionLevel(std::clamp(options.level, 0, 9)) {
+    for (std::string extension : options.storeExtensions) {
+      if (!extension.empty() && extension.front() == '.') {
+        extension.erase(0, 1);
+      }
+      std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+      storeExtensions.insert(std::move(extension));
+    }
+  }
+
+  bool compresses(const ArchiveEntry& entry) const override {
+    if (compressionLevel == 0 || entry.isDirectory) {
+      return false;
+    }
+    size_t dot = entry.name.rfind('.');
+    if (dot == std::string::npos || entry.name.find('/', dot) != std::string::npos) {
+      return true;
+    }
+    std::string extension = entry.name.substr(dot + 1);
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) { return std::tolower(c); });
+    return storeExtensions.count(extension) == 0;
+  }
+
+  int level() const override {
+    return compressionLevel;
+  }
+
+  void writeChunk(const ArchiveItem& item, const ArchiveChunk& chunk) override {
+    const ArchiveEntry& entry = entries[item.entry];
+    if (item.first) {
+      current = {};
+      current.headerOffset = output.offset();
+      current.method = compresses(entry) && !chunk.stored ? kZipMethodDeflated : kZipMethodStored;
+      current.zip64 = entry.size >= kZip64LocalThreshold;
+      current.name = entry.isDirectory ? entry.name + "/" : entry.name;
+      zipUnixTimeToDos(entry.mtime, current.dosDate, current.dosTime);
+      // Single chunk entries are complete, the others get their sizes patched in at the end
+      if (item.last) {
+        current.crc = chunk.crc;
+        current.compressedSize = chunk.data.size();
+      }
+      writeLocalHeader(entry);
+      current.compressedSize = 0;
+    }
+    current.crc = item.first ? chunk.crc : crc32_combine(current.crc, chunk.crc, static_cast<z_off_t>(item.length));
+    current.compressedSize += chunk.data.size();
+    output.append(chunk.data);
+    if (!item.last) {
+      return;
+    }
+
+    if (!current.zip64 && current.compressedSize >= kZip64Marker) {
+      throw "File is too large";
+    }
+    if (!item.first) {
+      patchLocalHeader(entry);
+    }
+    appendCentralHeader(entry);
+    entryCount++;
+  }
+
+  void finish() override {
+    uint64_t directoryOffset = output.offset();
+    uint64_t directorySize = centralDirectory.size();
+    output.append(centralDirectory);
+
+    std::vector<uint8_t> record;
+    if (entryCount >= kZip64CountMarker || directoryOffset >= kZip64Marker || directorySize >= kZip64Marker) {
+      uint64_t record64Offset = output.offset();
+      zipWrite32(record, kZip64EndOfCentralDirSignature);
+      zipWrite64(record, kZip64EndOfCentralDirSize - 12);
+      zipWrite16(record, (kZipHostUnix << 8) | kZipVersionZip64);
+      zipWrite16(record, kZipVersionZip64);
+      zipWrite32(record, 0);
+      zipWrite32(record, 0);
+      zipWrite64(record, entryCount);
+      zipWrite64(record, entryCount);
+      zipWrite64(record, directorySize);
+      zipWrite64(record, directoryOffset);
+      zipWrite32(record, kZip64LocatorSignature);
+      zipWrite32(record, 0);
+      zipWrite64(record, record64Offset);
+      zipWrite32(record, 1);
+    }
+    zipWrite32(record, kZipEndOfCentralDirSignature);
+    zipWrite16(record, 0);
+    zipWrite16(record, 0);
+    zipWrite16(record, static_cast<uint16_t>(std::min<uint64_t>(entryCount, kZip64CountMarker)));
+    zipWrite16(record, static_cast<uint16_t>(std::min<uint64_t>(entryCount, kZip64CountMarker)));
+    zipWrite32(record, static_cast<uint32_t>(std::min<uint64_t>(directorySize, kZip64Marker)));
+    zipWrite32(record, static_cast<uint32_t>(std::min<uint64_t>(directoryOffset, kZip64Marker)));
+    zipWrite16(record, 0);
+    output.append(record);
+    output.flush();
+  }
+
+private:
+  void writeLocalHeader(const ArchiveEntry& entry) {
+    std::vector<uint8_t> header;
+    zipWrite32(header, kZipLocalHeaderSignature);
+    zipWrite16(header, current.zip64 ? kZipVersionZip64 : kZipVersionDeflate);
+    zipWrite16(header, kZipFlagUtf8);
+    zipWrite16(header, current.method);
+    zipWrite16(header, current.dosTime);
+    zipWrite16(header, current.dosDate);
+    zipWrite32(header, current.crc);
+    zipWrite32(header, current.zip64 ? kZip64Marker : static_cast<uint32_t>(current.compressedSize));
+    zipWrite32(header, current.zip64 ? kZip64Marker : static_cast<uint32_t>(entry.size));
+    zipWrite16(header, static_cast<uint16_t>(current.name.size()));
+    zipWrite16(header, current.zip64 ? 20 : 0);
+    header.insert(header.end(), current.name.begin(), current.name.end());
+    if (current.zip64) {
+      zipWrite16(header, kZip64ExtraFieldId);
+      zipWrite16(header, 16);
+      zipWrite64(header, entry.size);
+      zipWrite64(header, current.compressedSize);
+    }
+    output.append(header);
+  }
+
+  void patchLocalHeader(const ArchiveEntry& entry) {
+    std::vector<uint8_t> crc;
+    zipWrite32(crc, current.crc);
+    output.patch(current.headerOffset + 14, crc);
+    std::vector<uint8_t> sizes;
+    if (current.zip64) {
+      zipWrite64(sizes, entry.size);
+      zipWrite64(sizes, current.compressedSize);
+      output.patch(current.headerOffset + kZipLocalHeaderSize + current.name.size() + 4, sizes);
+    } else {
+      zipWrite32(sizes, static_cast<uint32_t>(current.compressedSize));
+      output.patch(current.headerOffset + 18, sizes);
+    }
+  }
+
+  void appendCentralHeader(const ArchiveEntry& entry) {
+    // Fields that don't fit go to the zip64 extra field, in this order
+    bool sizesInExtra = current.zip64 || current.compressedSize >= kZip64Marker;
+    bool offsetInExtra = current.headerOffset >= kZip64Marker;
+    std::vector<uint8_t> extra;
+    if (sizesInExtra || offsetInExtra) {
+      zipWrite16(extra, kZip64ExtraFieldId);
+      zipWrite16(extra, (sizesInExtra ? 16 : 0) + (offsetInExtra ? 8 : 0));
+      if (sizesInExtra) {
+        zipWrite64(extra, entry.size);
+        zipWrite64(extra, current.compressedSize);
+      }
+      if (offsetInExtra) {
+        zipWrite64(extra, current.headerOffset);
+      }
+    }
+    uint16_t version = extra.empty() ? kZipVersionDeflate : kZipVersionZip64;
+    uint32_t unixMode = (entry.isDirectory ? S_IFDIR : S_IFREG) | (entry.mode & 07777);
+
+    std::vector<uint8_t>& header = centralDirectory;
+    zipWrite32(header, kZipCentralHeaderSignature);
+    zipWrite16(header, (kZipHostUnix << 8) | version);
+    zipWrite16(header, version);
+    zipWrite16(header, kZipFlagUtf8);
+    zipWrite16(header, current.method);
+    zipWrite16(header, current.dosTime);
+    zipWrite16(header, current.dosDate);
+    zipWrite32(header, current.crc);
+    zipWrite32(header, sizesInExtra ? kZip64Marker : static_cast<uint32_t>(current.compressedSize));
+    zipWrite32(header, sizesInExtra ? kZip64Marker : static_cast<uint32_t>(entry.size));
+    zipWrite16(header, static_cast<uint16_t>(current.name.size()));
+    zipWrite16(header, static_cast<uint16_t>(extra.size()));
+    zipWrite16(header, 0);
+    zipWrite16(header, 0);
+    zipWrite16(header, 0);
+    zipWrite32(header, (unixMode << 16) | (entry.isDirectory ? kZipDosDirectory : 0));
+    zipWrite32(header, offsetInExtra ? kZip64Marker : static_cast<uint32_t>(current.headerOffset));
+    header.insert(header.end(), current.name.begin(), current.name.end());
+    header.insert(header.end(), extra.begin(), extra.end());
+  }
+
+  struct CurrentEntry {
+    std::string name;
+    uint64_t headerOffset;
+    uint64_t compressedSize;
+    uint32_t crc;
+    uint16_t method;
+    uint16_t dosDate;
+    uint16_t dosTime;
+    bool zip64;
+  };
+
+  int compressionLevel;
+  std::set<std::string> storeExtensions;
+  CurrentEntry current{};
+  std::vector<uint8_t> centralDirectory;
+  uint64_t entryCount{0};
+};
+
+class TarWriter : public ArchiveWriter {
+public:
+  using ArchiveWriter::ArchiveWriter;
+
+  bool compresses(const ArchiveEntry& entry) const override {
+    return false;
+  }
+
+  void writeChunk(const ArchiveItem& item, const ArchiveChunk& chunk) override {
+    const ArchiveEntry& entry = entries[item.entry];
+    if (item.first) {
+      writeHeaders(entry);
+    }
+    output.append(chunk.data);
+    if (item.last && entry.size % kTarBlockSize != 0) {
+      appendZeros(kTarBlockSize - entry.size % kTarBlockSize);
+    }
+  }
+
+  void finish() override {
+    // End of archive: two zero blocks
+    appendZeros(2 * kTarBlockSize);
+    output.flush();
+  }
+
+private:
+  void appendZeros(size_t length) {
+    static const uint8_t zeros[2 * kTarBlockSize]{};
+    output.append(zeros, length);
+  }
+
+  static void writeOctal(uint8_t* field, size_t width, uint64_t value) {
+    for (size_t i = width - 1; i-- > 0;) {
+      field[i] = static_cast<uint8_t>('0' + (value & 7));
+      value >>= 3;
+    }
+  }
+
+  // "<length> key=value\n", where the length includes its own digits
+  static void appendPaxRecord(std::string& records, std::string_view key, std::string_view value) {
+    size_t length = key.size() + value.size() + 3;
+    size_t digits = std::to_string(length).size();
+    while (std::to_string(length + digits).size() != digits) {
+      digits++;
+    }
+    records.append(std::to_string(length + digits)).append(" ").append(key).append("=").append(value).append("\n");
+  }
+
+  void appendHeader(std::string_view name, std::string_view prefix, char type, uint64_t size, mode_t mode, time_t mtime) {
+    uint8_t header[kTarBlockSize]{};
+    name.copy(reinterpret_cast<char*>(header), 100);
+    writeOctal(header + 100, 8, mode & 07777);
+    writeOctal(header + 108, 8, 0);
+    writeOctal(header + 116, 8, 0);
+    writeOctal(header + 124, 12, size <= kTarMaxUstarSize ? size : 0);
+    writeOctal(header + 136, 12, static_cast<uint64_t>(std::max<time_t>(mtime, 0)));
+    header[156] = static_cast<uint8_t>(type);
+    memcpy(header + 257, "ustar", 6);
+    memcpy(header + 263, "00", 2);
+    prefix.copy(reinterpret_cast<char*>(header + 345), 155);
+    // The checksum is computed with its own field set to spaces
+    memset(header + 148, ' ', 8);
+    uint32_t checksum = 0;
+    for (uint8_t byte : header) {
+      checksum += byte;
+    }
+    writeOctal(header + 148, 7, checksum);
+    output.append(header, sizeof(header));
+  }
+
+  void writeHeaders(const ArchiveEntry& entry) {
+    std::string name = entry.isDirectory ? entry.name + "/" : entry.name;
+    std::string_view ustarName = name;
+    std::string_view prefix;
+    if (name.size() > 100) {
+      // ustar fits up to 155 + 100 characters when the path can be split at a slash
+      size_t slash = name.find('/', name.size() - 101);
+      if (slash != std::string::npos && slash <= 155 && slash + 1 < name.size()) {
+        prefix = std::string_view(name).substr(0, slash);
+        ustarName = std::string_view(name).substr(slash + 1);
+      }
+    }
+
+    std::string records;
+    if (prefix.empty() && name.size() > 100) {
+      appendPaxRecord(records, "path", name);
+      ustarName = std::string_view(name).substr(0, 100);
+    }
+    if (entry.size > kTarMaxUstarSize) {
+      appendPaxRecord(records, "size", std::to_string(entry.size));
+    }
+    if (!records.empty()) {
+      appendHeader("PaxHeader", "", 'x', records.size(), 0644, entry.mtime);
+      output.append(reinterpret_cast<const uint8_t*>(records.data()), records.size());
+      if (records.size() % kTarBlockSize != 0) {
+        appendZeros(kTarBlockSize - records.size() % kTarBlockSize);
+      }
+    }
+    appendHeader(ustarName, prefix, entry.isDirectory ? '5' : '0', entry.isDirectory ? 0 : entry.size, entry.mode, entry.mtime);
+  }
+};
+
+}
+
+// Pre-order with sorted names, so archives of the same tree are identical
+static void listArchiveTree(const std::string& root, const std::string& relativeDir, const struct stat& archiveStat, std::vector<ArchiveEntry>& entries) {
+  std::string dirPath = relativeDir.empty() ? root : root + "/" + relativeDir;
+  UniqueFd dirFd(open(dirPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+  if (!dirFd.valid()) {
+    throw strerror(errno);
+  }
+  std::vector<std::string> names;
+  readDirectoryEntries(dirFd.get(), [&](const char* name, unsigned char type) {
+    names.emplace_back(name);
+  });
+  std::sort(names.begin(), names.end());
+  for (const std::string& name : names) {
+    struct stat st;
+    if (fstatat(dirFd.get(), name.c_str(), &st, AT_SYMLINK_NOFOLLOW) != 0) {
+      continue;
+    }
+    // Links, sockets and the archive itself when it is written into the tree are skipped
+    if ((!S_ISREG(st.st_mode) && !S_ISDIR(st.st_mode)) || (st.st_dev == archiveStat.st_dev && st.st_ino == archiveStat.st_ino)) {
+      continue;
+    }
+    ArchiveEntry entry;
+    entry.name = relativeDir.empty() ? name : relativeDir + "/" + name;
+    entry.path = root + "/" + entry.name;
+    entry.isDirectory = S_ISDIR(st.st_mode);
+    entry.size = entry.isDirectory ? 0 : static_cast<uint64_t>(st.st_size);
+    entry.mode = st.st_mode & 07777;
+    entry.mtime = st.st_mtime;
+    entries.push_back(entry);
+    if (entry.isDirectory) {
+      listArchiveTree(root, entry.name, archiveStat, entries);
+    }
+  }
+}
+
+static void readChunk(const std::string& path, uint64_t offset, size_t length, std::vector<uint8_t>& data) {
+  data.resize(length);
+  UniqueFd fd(open(path.c_str(), O_RDONLY | O_CLOEXEC | O_NOFOLLOW));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  for (size_t done = 0; done < length;) {
+    ssize_t bytesRead = pread(fd.get(), data.data() + done, length - done, static_cast<off_t>(offset + done));
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    if (bytesRead == 0) {
+      throw "File was modified while archiving";
+    }
+    done += bytesRead;
+  }
+}
+
+// Deflates (or only reads) the chunk of an entry on a worker thread
+static void produceChunk(const ArchiveWriter& writer, const ArchiveEntry& entry, const ArchiveItem& item, ArchiveChunk& chunk, WorkerState& state) {
+  chunk.stored = false;
+  bool compress = writer.compresses(entry);
+  size_t dictionaryLength = compress ? static_cast<size_t>(std::min<uint64_t>(item.offset, kDeflateDictionarySize)) : 0;
+  if (item.length > 0) {
+    readChunk(entry.path, item.offset - dictionaryLength, dictionaryLength + item.length, state.input);
+  } else {
+    state.input.clear();
+  }
+  const uint8_t* data = state.input.data() + dictionaryLength;
+  chunk.crc = crc32Update(0, data, item.length);
+  if (!compress) {
+    std::swap(chunk.data, state.input);
+    return;
+  }
+
+  if (!state.deflater.has_value()) {
+    state.deflater.emplace(writer.level());
+  }
+  state.deflater->compress(state.input.data(), dictionaryLength, data, item.length, item.last, chunk.data);
+  // Incompressible single chunk entries are stored, bigger ones are already committed to deflate
+  if (item.first && item.last && chunk.data.size() >= item.length) {
+    chunk.data.assign(data, data + item.length);
+    chunk.stored = true;
+  }
+}
+
+// Produces the chunks on the worker threads and hands them to the writer in order on the calling thread.
+// Workers don't start a chunk more than `window` chunks ahead of the writer, which bounds the memory.
+static void runArchivePipeline(const std::vector<ArchiveEntry>& entries, const std::vector<ArchiveItem>& items, ArchiveWriter& writer) {
+  size_t window = workerCount() * 2;
+  std::vector<ArchiveChunk> slots(window);
+  std::mutex mutex;
+  std::condition_variable changed;
+  size_t nextItem{0};
+  size_t nextWrite{0};
+  bool failed{false};
+  std::exception_ptr error = nullptr;
+
+  auto fail = [&](std::exception_ptr exception) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (error == nullptr) {
+        error = exception;
+      }
+      failed = true;
+    }
+    changed.notify_all();
+  };
+
+  std::thread producers([&]() {
+    parallelFor(workerCount(), 1, [&](size_t begin, size_t end) {
+      WorkerState state;
+      ArchiveChunk chunk;
+      while (true) {
+        size_t index;
+        {
+          std::unique_lock<std::mutex> lock(mutex);
+          changed.wait(lock, [&] { return failed || nextItem >= items.size() || nextItem < nextWrite + window; });
+          if (failed || nextItem >= items.size()) {
+            return;
+          }
+          index = nextItem++;
+        }
+        try {
+          produceChunk(writer, entries[items[index].entry], items[index], chunk, state);
+        } catch (...) {
+          fail(std::current_exception());
+          return;
+        }
+        {
+          std::lock_guard<std::mutex> lock(mutex);
+          // The previous chunk of this slot is consumed, its buffer is reused for the next one
+          std::swap(slots[index % window], chunk);
+          slots[index % window].ready = true;
+        }
+        changed.notify_all();
+      }
+    });
+  });
+
+  try {
+    bool stopped = false;
+    for (size_t index = 0; index < items.size(); index++) {
+      ArchiveChunk& chunk = slots[index % window];
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        changed.wait(lock, [&] { return failed || chunk.ready; });
+        if (failed) {
+          stopped = true;
+          break;
+        }
+      }
+      writer.writeChunk(items[index], chunk);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        chunk.ready = false;
+        nextWrite++;
+      }
+      changed.notify_all();
+    }
+    if (!stopped) {
+      writer.finish();
+    }
+  } catch (...) {
+    fail(std::current_exception());
+  }
+  producers.join();
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+static ArchiveResult createArchive(
+  const std::string& srcDir,
+  const std::string& archivePath,
+  const std::function<std::unique_ptr<ArchiveWriter>(ArchiveOutput&, const std::vector<ArchiveEntry>&)>& makeWriter
+) {
+  struct stat rootStat;
+  if (stat(srcDir.c_str(), &rootStat) != 0) {
+    throw strerror(errno);
+  }
+  if (!S_ISDIR(rootStat.st_mode)) {
+    throw "Not a directory";
+  }
+  UniqueFd fd(open(archivePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+
+  try {
+    struct stat archiveStat;
+    if (fstat(fd.get(), &archiveStat) != 0) {
+      throw strerror(errno);
+    }
+    std::vector<ArchiveEntry> entries;
+    listArchiveTree(srcDir, "", archiveStat, entries);
+
+    ArchiveResult result;
+    std::vector<ArchiveItem> items;
+    for (size_t i = 0; i < entries.size(); i++) {
+      const ArchiveEntry& entry = entries[i];
+      if (!entry.isDirectory) {
+        result.files++;
+      }
+      uint64_t offset = 0;
+      do {
+        size_t length = static_cast<size_t>(std::min<uint64_t>(entry.size - offset, kArchiveChunkSize));
+        items.push_back({i, offset, length, offset == 0, offset + length == entry.size});
+        offset += length;
+      } while (offset < entry.size);
+    }
+
+    ArchiveOutput output(fd.get());
+    std::unique_ptr<ArchiveWriter> writer = makeWriter(output, entries);
+    runArchivePipeline(entries, items, *writer);
+    result.size = output.offset();
+    return result;
+  } catch (...) {
+    fd.reset();
+    unlink(archivePath.c_str());
+    throw;
+  }
+}
+
+ArchiveResult zipDirectory(const std::string& srcDir, const std::string& archivePath, const ZipOptions& options) {
+  return createArchive(srcDir, archivePath, [&options](ArchiveOutput& output, const std::vector<ArchiveEntry>& entries) {
+    return std::make_unique<ZipWriter>(output, entries, options);
+  });
+}
+
+ArchiveResult tarDirectory(const std::string& srcDir, const std::string& archivePath) {
+  return createArchive(srcDir, archivePath, [](ArchiveOutput& output, const std::vector<ArchiveEntry>& entries) {
+    return std::make_unique<TarWriter>(output, entries);
+  });
+}
+
+}
@@ -0,0 +1,42 @@
+//
+//  archive-utils.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+struct ZipOptions {
+  // zlib compression level, 0 stores every entry
+  int level{6};
+  // Extensions (case-insensitive, without the dot) of already compressed formats that are stored as is
+  std::vector<std::string> storeExtensions{
+    "7z", "aac", "avif", "br", "bz2", "gif", "gz", "heic", "jpeg", "jpg", "lz4", "m4a",
+    "mov", "mp3", "mp4", "ogg", "png", "rar", "webm", "webp", "xz", "zip", "zst",
+  };
+};
+
+struct ArchiveResult {
+  // Number of archived files, directories not included
+  uint64_t files{0};
+  // Size of the written archive in bytes
+  uint64_t size{0};
+};
+
+// Packs the regular files and directories below srcDir into a zip archive (zip64 when needed).
+// Files are split into chunks that are deflated in parallel, every chunk after the first one is primed
+// with the end of the previous one, and the results are written in order through a small reorder window,
+// so only a few chunks are held in memory whatever the size of the tree. Symlinks are skipped.
+ArchiveResult zipDirectory(const std::string& srcDir, const std::string& archivePath, const ZipOptions& options);
+
+// Packs srcDir into an uncompressed POSIX (pax) tar archive, file chunks are read ahead in parallel
+ArchiveResult tarDirectory(const std::string& srcDir, const std::string& archivePath);
+
+}
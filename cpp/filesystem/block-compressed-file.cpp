@@ -0,0 +1,295 @@
+//
+//  block-compressed-file.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "../algorithms/lz4-block.h"
+#include "block-compressed-file.h"
+#include "unique-fd.h"
+#include "worker-pool.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr char kBlockFileMagic[4] = {'R', 'F', 'L', '4'};
+static constexpr uint8_t kBlockFileVersion = 1;
+static constexpr uint8_t kBlockCodecLz4 = 1;
+static constexpr size_t kBlockFileHeaderSize = 8;
+static constexpr size_t kBlockFileTrailerSize = 16;
+static constexpr size_t kBlockIndexEntrySize = 8;
+static constexpr uint32_t kStoredBlockFlag = 0x80000000u;
+static constexpr size_t kBlockSize = 64 * 1024;
+// Blocks handed to the workers at once, bounds the memory of large writes and reads
+static constexpr size_t kBlocksPerWorker = 16;
+
+namespace {
+
+struct BlockEntry {
+  uint32_t compressedSize;
+  uint32_t size;
+  bool stored;
+  // Offsets of the block in the file and in the uncompressed data
+  uint64_t fileOffset;
+  uint64_t dataOffset;
+};
+
+struct BlockIndex {
+  std::vector<BlockEntry> blocks;
+  uint64_t indexOffset{kBlockFileHeaderSize};
+
+  uint64_t dataSize() const {
+    return blocks.empty() ? 0 : blocks.back().dataOffset + blocks.back().size;
+  }
+};
+
+}
+
+static void putLe32(uint8_t* p, uint32_t value) {
+  for (int i = 0; i < 4; i++) {
+    p[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+static void putLe64(uint8_t* p, uint64_t value) {
+  for (int i = 0; i < 8; i++) {
+    p[i] = static_cast<uint8_t>(value >> (8 * i));
+  }
+}
+
+static uint32_t getLe32(const uint8_t* p) {
+  uint32_t value = 0;
+  for (int i = 0; i < 4; i++) {
+    value |= static_cast<uint32_t>(p[i]) << (8 * i);
+  }
+  return value;
+}
+
+static uint64_t getLe64(const uint8_t* p) {
+  uint64_t value = 0;
+  for (int i = 0; i < 8; i++) {
+    value |= static_cast<uint64_t>(p[i]) << (8 * i);
+  }
+  return value;
+}
+
+static void preadAll(int fd, uint8_t* data, size_t length, uint64_t offset) {
+  while (length > 0) {
+    ssize_t bytesRead = pread(fd, data, length, offset);
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    if (bytesRead == 0) {
+      throw "Unexpected end of file";
+    }
+    data += bytesRead;
+    length -= bytesRead;
+    offset += bytesRead;
+  }
+}
+
+static void pwriteAll(int fd, const uint8_t* data, size_t length, uint64_t offset) {
+  while (length > 0) {
+    ssize_t written = pwrite(fd, data, length, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    data += written;
+    length -= written;
+    offset += written;
+  }
+}
+
+static void appendBlock(BlockIndex& index, uint32_t compressedSize, uint32_t size, bool stored) {
+  uint64_t fileOffset = index.blocks.empty()
+    ? kBlockFileHeaderSize
+    : index.blocks.back().fileOffset + index.blocks.back().compressedSize;
+  index.blocks.push_back({compressedSize, size, stored, fileOffset, index.dataSize()});
+}
+
+static BlockIndex readBlockIndex(int fd) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    throw strerror(errno);
+  }
+  uint64_t fileSize = st.st_size;
+  if (fileSize < kBlockFileHeaderSize + kBlockFileTrailerSize) {
+    throw "Not an lz4 compressed file";
+  }
+  uint8_t header[kBlockFileHeaderSize];
+  preadAll(fd, header, sizeof(header), 0);
+  uint8_t trailer[kBlockFileTrailerSize];
+  preadAll(fd, trailer, sizeof(trailer), fileSize - kBlockFileTrailerSize);
+  if (memcmp(header, kBlockFileMagic, 4) != 0 || memcmp(trailer + 12, kBlockFileMagic, 4) != 0) {
+    throw "Not an lz4 compressed file";
+  }
+  if (header[4] != kBlockFileVersion || header[5] != kBlockCodecLz4) {
+    throw "Unsupported compressed file version";
+  }
+
+  BlockIndex index;
+  index.indexOffset = getLe64(trailer);
+  uint32_t blockCount = getLe32(trailer + 8);
+  if (index.indexOffset + static_cast<uint64_t>(blockCount) * kBlockIndexEntrySize + kBlockFileTrailerSize != fileSize) {
+    throw "Corrupt compressed file index";
+  }
+  std::vector<uint8_t> entries(static_cast<size_t>(blockCount) * kBlockIndexEntrySize);
+  preadAll(fd, entries.data(), entries.size(), index.indexOffset);
+  index.blocks.reserve(blockCount);
+  for (uint32_t i = 0; i < blockCount; i++) {
+    uint32_t compressedSize = getLe32(entries.data() + i * kBlockIndexEntrySize);
+    uint32_t size = getLe32(entries.data() + i * kBlockIndexEntrySize + 4);
+    appendBlock(index, compressedSize & ~kStoredBlockFlag, size, (compressedSize & kStoredBlockFlag) != 0);
+  }
+  if (!index.blocks.empty() && index.blocks.back().fileOffset + index.blocks.back().compressedSize != index.indexOffset) {
+    throw "Corrupt compressed file index";
+  }
+  return index;
+}
+
+static void writeBlockIndex(int fd, const BlockIndex& index) {
+  std::vector<uint8_t> tail(index.blocks.size() * kBlockIndexEntrySize + kBlockFileTrailerSize);
+  uint8_t* p = tail.data();
+  for (const BlockEntry& block : index.blocks) {
+    putLe32(p, block.compressedSize | (block.stored ? kStoredBlockFlag : 0));
+    putLe32(p + 4, block.size);
+    p += kBlockIndexEntrySize;
+  }
+  putLe64(p, index.indexOffset);
+  putLe32(p + 8, static_cast<uint32_t>(index.blocks.size()));
+  memcpy(p + 12, kBlockFileMagic, 4);
+  pwriteAll(fd, tail.data(), tail.size(), index.indexOffset);
+}
+
+void writeBlockCompressedFile(const char* filePath, std::string_view content, bool isAppend) {
+  UniqueFd fd(open(filePath, O_RDWR | O_CREAT | O_CLOEXEC | (isAppend ? 0 : O_TRUNC), 0644));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  BlockIndex index;
+  if (isAppend && lseek(fd.get(), 0, SEEK_END) > 0) {
+    index = readBlockIndex(fd.get());
+  } else {
+    uint8_t header[kBlockFileHeaderSize] = {0};
+    memcpy(header, kBlockFileMagic, 4);
+    header[4] = kBlockFileVersion;
+    header[5] = kBlockCodecLz4;
+    pwriteAll(fd.get(), header, sizeof(header), 0);
+  }
+
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(content.data());
+  size_t blockCount = (content.size() + kBlockSize - 1) / kBlockSize;
+  size_t batchSize = workerCount() * kBlocksPerWorker;
+  std::vector<std::vector<uint8_t>> compressed(std::min(blockCount, batchSize));
+  std::vector<size_t> compressedSizes(compressed.size());
+  uint64_t fileOffset = index.indexOffset;
+  for (size_t first = 0; first < blockCount; first += batchSize) {
+    size_t count = std::min(batchSize, blockCount - first);
+    parallelFor(count, 1, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        size_t offset = (first + i) * kBlockSize;
+        size_t size = std::min(kBlockSize, content.size() - offset);
+        compressed[i].resize(lz4CompressBound(size));
+        compressedSizes[i] = lz4Compress(data + offset, size, compressed[i].data());
+      }
+    });
+    for (size_t i = 0; i < count; i++) {
+      size_t offset = (first + i) * kBlockSize;
+      size_t size = std::min(kBlockSize, content.size() - offset);
+      bool stored = compressedSizes[i] >= size;
+      const uint8_t* blockData = stored ? data + offset : compressed[i].data();
+      size_t blockLength = stored ? size : compressedSizes[i];
+      pwriteAll(fd.get(), blockData, blockLength, fileOffset);
+      fileOffset += blockLength;
+      appendBlock(index, static_cast<uint32_t>(blockLength), static_cast<uint32_t>(size), stored);
+    }
+  }
+  index.indexOffset = fileOffset;
+  writeBlockIndex(fd.get(), index);
+  // Appends may leave the old index behind the new one
+  if (ftruncate(fd.get(), index.indexOffset + index.blocks.size() * kBlockIndexEntrySize + kBlockFileTrailerSize) != 0) {
+    throw strerror(errno);
+  }
+}
+
+std::string readBlockCompressedFile(const char* filePath, uint64_t offset, uint64_t length) {
+  UniqueFd fd(open(filePath, O_RDONLY | O_CLOEXEC));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  BlockIndex index = readBlockIndex(fd.get());
+  uint64_t dataSize = index.dataSize();
+  if (offset >= dataSize) {
+    return {};
+  }
+  uint64_t end = length == 0 ? dataSize : std::min(dataSize, offset + length);
+
+  // First block ending after offset, last block starting before end
+  auto firstBlock = std::upper_bound(index.blocks.begin(), index.blocks.end(), offset, [](uint64_t value, const BlockEntry& block) {
+    return value < block.dataOffset + block.size;
+  });
+  auto lastBlock = std::lower_bound(firstBlock, index.blocks.end(), end, [](const BlockEntry& block, uint64_t value) {
+    return block.dataOffset < value;
+  });
+
+  std::string result(end - offset, '\0');
+  uint8_t* out = reinterpret_cast<uint8_t*>(result.data());
+  size_t batchSize = workerCount() * kBlocksPerWorker;
+  std::vector<uint8_t> compressed;
+  for (auto batch = firstBlock; batch != lastBlock;) {
+    auto batchEnd = batch + std::min<size_t>(batchSize, lastBlock - batch);
+    // Blocks are contiguous in the file, one read covers the batch
+    uint64_t batchFileOffset = batch->fileOffset;
+    uint64_t batchFileEnd = (batchEnd - 1)->fileOffset + (batchEnd - 1)->compressedSize;
+    compressed.resize(batchFileEnd - batchFileOffset);
+    preadAll(fd.get(), compressed.data(), compressed.size(), batchFileOffset);
+
+    parallelFor(batchEnd - batch, 1, [&](size_t rangeBegin, size_t rangeEnd) {
+      std::vector<uint8_t> scratch;
+      for (auto block = batch + rangeBegin; block != batch + rangeEnd; block++) {
+        const uint8_t* blockData = compressed.data() + (block->fileOffset - batchFileOffset);
+        uint64_t copyFrom = std::max(offset, block->dataOffset);
+        uint64_t copyTo = std::min(end, block->dataOffset + block->size);
+        uint8_t* target = out + (copyFrom - offset);
+        // Blocks cut by the range go through a scratch buffer, the others are decompressed in place
+        bool whole = copyFrom == block->dataOffset && copyTo == block->dataOffset + block->size;
+        const uint8_t* decoded;
+        if (block->stored) {
+          if (block->compressedSize != block->size) {
+            throw "Corrupt compressed file index";
+          }
+          decoded = blockData;
+        } else if (whole) {
+          if (lz4Decompress(blockData, block->compressedSize, target, block->size) != block->size) {
+            throw "Invalid compressed data";
+          }
+          continue;
+        } else {
+          scratch.resize(block->size);
+          if (lz4Decompress(blockData, block->compressedSize, scratch.data(), block->size) != block->size) {
+            throw "Invalid compressed data";
+          }
+          decoded = scratch.data();
+        }
+        memcpy(target, decoded + (copyFrom - block->dataOffset), copyTo - copyFrom);
+      }
+    });
+    batch = batchEnd;
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,31 @@
+//
+//  block-compressed-file.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace cmpayc::rnfsturbo {
+
+// Seekable file of independently LZ4 compressed 64 KB blocks, all integers little-endian:
+//
+//   header   "RFL4", u8 version, u8 codec, u16 reserved
+//   blocks   compressed data, a block that doesn't shrink is stored as is
+//   index    per block: u32 compressed size (bit 31 set = stored), u32 uncompressed size
+//   trailer  u64 index offset, u32 block count, "RFL4"
+//
+// Blocks are compressed and decompressed on the worker threads.
+
+// Appending compresses only the new data and rewrites the index
+void writeBlockCompressedFile(const char* filePath, std::string_view content, bool isAppend);
+
+// Decompresses only the blocks covering [offset, offset + length), length 0 means up to the end
+std::string readBlockCompressedFile(const char* filePath, uint64_t offset, uint64_t length);
+
+}
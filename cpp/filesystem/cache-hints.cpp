@@ -0,0 +1,69 @@
+//
+//  cache-hints.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "cache-hints.h"
+#include "unique-fd.h"
+
+namespace cmpayc::rnfsturbo {
+
+// Linux caps a single WILLNEED at the device readahead window, so ranges are advised piece by piece
+static constexpr uint64_t kAdviseChunkSize = 2 * 1024 * 1024;
+
+static void prefetchFile(const std::string& path, uint64_t offset, uint64_t length) {
+  UniqueFd fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+  if (!fd.valid()) {
+    return;
+  }
+  struct stat st;
+  if (fstat(fd.get(), &st) != 0 || !S_ISREG(st.st_mode)) {
+    return;
+  }
+  uint64_t size = static_cast<uint64_t>(st.st_size);
+  uint64_t end = length == 0 ? size : std::min(size, offset + length);
+  while (offset < end) {
+    uint64_t count = std::min(end - offset, kAdviseChunkSize);
+#if defined(__APPLE__)
+    struct radvisory advisory{static_cast<off_t>(offset), static_cast<int>(count)};
+    if (fcntl(fd.get(), F_RDADVISE, &advisory) != 0) {
+      return;
+    }
+#else
+    // Queues the reads and returns without waiting for them
+    if (posix_fadvise(fd.get(), static_cast<off_t>(offset), static_cast<off_t>(count), POSIX_FADV_WILLNEED) != 0) {
+      return;
+    }
+#endif
+    offset += count;
+  }
+}
+
+void prefetchFiles(const std::vector<std::string>& paths, uint64_t offset, uint64_t length) {
+  for (const std::string& path : paths) {
+    prefetchFile(path, offset, length);
+  }
+}
+
+void evictFile(const std::string& path) {
+#if !defined(__APPLE__)
+  UniqueFd fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  fdatasync(fd.get());
+  int res = posix_fadvise(fd.get(), 0, 0, POSIX_FADV_DONTNEED);
+  if (res != 0) {
+    throw strerror(res);
+  }
+#endif
+}
+
+}
@@ -0,0 +1,46 @@
+//
+//  cache-hints.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+// Asks the kernel to start reading [offset, offset + length) of every file into the page cache
+// (length 0 means up to the end). Blocks only for open(), missing files are skipped.
+void prefetchFiles(const std::vector<std::string>& paths, uint64_t offset, uint64_t length);
+
+// Drops the cached pages of a file, e.g. after a large one-shot read.
+// Dirty pages are written back first, they can't be dropped otherwise. No-op on iOS.
+void evictFile(const std::string& path);
+
+// Evicts the file when it goes out of scope (if active), errors are ignored
+class ScopedEvict {
+public:
+  ScopedEvict(std::string path, bool active) : path(std::move(path)), active(active) {}
+  ScopedEvict(const ScopedEvict&) = delete;
+  ScopedEvict& operator=(const ScopedEvict&) = delete;
+  ~ScopedEvict() {
+    if (!active) {
+      return;
+    }
+    try {
+      evictFile(path);
+    } catch (const char*) {
+    }
+  }
+
+private:
+  std::string path;
+  bool active;
+};
+
+}
@@ -0,0 +1,97 @@
+//
+//  compressed-io.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <vector>
+#include "block-compressed-file.h"
+#include "compressed-io.h"
+#include "unique-fd.h"
+#include "zlib-stream.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kCompressedChunkSize = 256 * 1024;
+
+std::optional<Compression> parseCompression(std::string_view compression) {
+  if (compression == "gzip") {
+    return Compression::Gzip;
+  } else if (compression == "deflate") {
+    return Compression::Deflate;
+  } else if (compression == "lz4") {
+    return Compression::Lz4;
+  }
+  return std::nullopt;
+}
+
+void writeFileCompressed(const char* filePath, std::string_view content, Compression compression, bool isAppend) {
+  if (compression == Compression::Lz4) {
+    return writeBlockCompressedFile(filePath, content, isAppend);
+  }
+  UniqueFd fd(open(filePath, O_WRONLY | O_CREAT | O_CLOEXEC | (isAppend ? O_APPEND : O_TRUNC), 0644));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  ZlibDeflater deflater(compression == Compression::Gzip ? ZlibFormat::Gzip : ZlibFormat::Deflate);
+  ByteSink sink = [&fd](const uint8_t* data, size_t length) {
+    while (length > 0) {
+      ssize_t written = write(fd.get(), data, length);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        throw strerror(errno);
+      }
+      data += written;
+      length -= written;
+    }
+  };
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(content.data());
+  for (size_t offset = 0; offset < content.size(); offset += kCompressedChunkSize) {
+    deflater.write(data + offset, std::min(kCompressedChunkSize, content.size() - offset), sink);
+  }
+  deflater.finish(sink);
+}
+
+std::string readFileCompressed(const char* filePath, Compression compression, uint64_t offset, uint64_t length) {
+  if (compression == Compression::Lz4) {
+    return readBlockCompressedFile(filePath, offset, length);
+  }
+  UniqueFd fd(open(filePath, O_RDONLY | O_CLOEXEC));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+#ifdef POSIX_FADV_SEQUENTIAL
+  posix_fadvise(fd.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  std::string result;
+  ZlibInflater inflater;
+  ByteSink sink = [&result](const uint8_t* data, size_t length) {
+    result.append(reinterpret_cast<const char*>(data), length);
+  };
+  std::vector<uint8_t> chunk(kCompressedChunkSize);
+  while (true) {
+    ssize_t bytesRead = read(fd.get(), chunk.data(), chunk.size());
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    if (bytesRead == 0) {
+      break;
+    }
+    inflater.write(chunk.data(), bytesRead, sink);
+  }
+  inflater.finish();
+  return result;
+}
+
+}
@@ -0,0 +1,37 @@
+//
+//  compressed-io.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace cmpayc::rnfsturbo {
+
+enum class Compression : uint8_t {
+  None,
+  Gzip,
+  Deflate,
+  // Seekable block format, see block-compressed-file.h
+  Lz4,
+};
+
+std::optional<Compression> parseCompression(std::string_view compression);
+
+// Compresses content chunk by chunk straight into the file, the compressed data is never held
+// in memory as a whole. Appending adds a new gzip member (or zlib stream) after the existing ones,
+// or new blocks for lz4.
+void writeFileCompressed(const char* filePath, std::string_view content, Compression compression, bool isAppend);
+
+// Reads and decompresses the file chunk by chunk. For gzip and deflate both formats are accepted,
+// concatenated members are decompressed one after another. offset and length (0 = up to the end)
+// address the uncompressed data and are only supported by lz4, which decompresses just the blocks they cover.
+std::string readFileCompressed(const char* filePath, Compression compression, uint64_t offset = 0, uint64_t length = 0);
+
+}
@@ -0,0 +1,581 @@
+//
+//  copy-utils.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <condition_variable>
+#include <cstring>
+#include <errno.h>
+#include <exception>
+#include <fcntl.h>
+#include <filesystem>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#include <sys/syscall.h>
+#endif
+#include "aligned-buffer-pool.h"
+#include "copy-utils.h"
+#include "dir-traversal.h"
+#include "unique-fd.h"
+#include "worker-pool.h"
+
+namespace cmpayc::rnfsturbo {
+
+namespace fs = std::filesystem;
+
+// Bytes per copy syscall, small enough for smooth progress
+static constexpr size_t kCopyChunkSize = 8 * 1024 * 1024;
+static constexpr size_t kReadWriteBufferSize = 1024 * 1024;
+
+static ssize_t readWriteChunk(int srcFd, int destFd, size_t length, std::vector<char>& buffer) {
+  if (buffer.empty()) {
+    buffer.resize(kReadWriteBufferSize);
+  }
+  ssize_t bytesRead = read(srcFd, buffer.data(), std::min(length, buffer.size()));
+  if (bytesRead <= 0) {
+    return bytesRead;
+  }
+  for (ssize_t written = 0; written < bytesRead;) {
+    ssize_t res = write(destFd, buffer.data() + written, bytesRead - written);
+    if (res < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return -1;
+    }
+    written += res;
+  }
+  return bytesRead;
+}
+
+// Copies `length` bytes from the current offset of srcFd to the current offset of destFd
+static void copyRange(int srcFd, int destFd, uint64_t length, CopyProgress& progress) {
+  std::vector<char> buffer;
+#ifdef __linux__
+  // Data stays in the kernel (or on the storage with reflinks), each method falls back to the next one
+  // when the filesystems don't support it
+#ifdef SYS_copy_file_range
+  bool useCopyFileRange{true};
+#else
+  bool useCopyFileRange{false};
+#endif
+  bool useSendfile{true};
+#endif
+  uint64_t remaining = length;
+  while (remaining > 0) {
+    size_t chunk = static_cast<size_t>(std::min<uint64_t>(remaining, kCopyChunkSize));
+    ssize_t copied;
+#ifdef __linux__
+    if (useCopyFileRange) {
+#ifdef SYS_copy_file_range
+      copied = syscall(SYS_copy_file_range, srcFd, nullptr, destFd, nullptr, chunk, 0);
+#else
+      copied = -1;
+#endif
+      if (copied < 0 && (errno == EXDEV || errno == ENOSYS || errno == EINVAL || errno == EOPNOTSUPP || errno == EPERM)) {
+        useCopyFileRange = false;
+        continue;
+      }
+    } else if (useSendfile) {
+      copied = sendfile(destFd, srcFd, nullptr, chunk);
+      if (copied < 0 && (errno == EINVAL || errno == ENOSYS)) {
+        useSendfile = false;
+        continue;
+      }
+    } else {
+      copied = readWriteChunk(srcFd, destFd, chunk, buffer);
+    }
+#else
+    copied = readWriteChunk(srcFd, destFd, chunk, buffer);
+#endif
+    if (copied < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    if (copied == 0) {
+      // The source got shorter while copying
+      break;
+    }
+    remaining -= copied;
+    progress.bytesCopied.fetch_add(copied, std::memory_order_relaxed);
+  }
+}
+
+// Copies only the data extents of a sparse file, the destination is empty so skipped ranges stay holes.
+// Returns false when the filesystem can't report extents, nothing is copied then.
+static bool copySparseData(int srcFd, int destFd, uint64_t size, CopyProgress& progress) {
+#if defined(SEEK_DATA) && defined(SEEK_HOLE)
+  off_t offset = 0;
+  off_t end = static_cast<off_t>(size);
+  while (offset < end) {
+    off_t dataStart = lseek(srcFd, offset, SEEK_DATA);
+    if (dataStart < 0) {
+      if (errno == ENXIO) {
+        // Only a hole is left
+        break;
+      }
+      if (offset == 0 && (errno == EINVAL || errno == ENOTSUP)) {
+        return false;
+      }
+      throw strerror(errno);
+    }
+    off_t dataEnd = lseek(srcFd, dataStart, SEEK_HOLE);
+    if (dataEnd < 0) {
+      throw strerror(errno);
+    }
+    dataEnd = std::min(dataEnd, end);
+    progress.bytesCopied.fetch_add(dataStart - offset, std::memory_order_relaxed);
+    if (lseek(srcFd, dataStart, SEEK_SET) < 0 || lseek(destFd, dataStart, SEEK_SET) < 0) {
+      throw strerror(errno);
+    }
+    copyRange(srcFd, destFd, dataEnd - dataStart, progress);
+    offset = dataEnd;
+  }
+  progress.bytesCopied.fetch_add(end - std::min(offset, end), std::memory_order_relaxed);
+  // Recreates a trailing hole
+  if (ftruncate(destFd, end) != 0) {
+    throw strerror(errno);
+  }
+  return true;
+#else
+  return false;
+#endif
+}
+
+// Opens with O_DIRECT when `direct` is set and the filesystem supports it, clears `direct` otherwise
+static int openFile(const std::string& path, int flags, mode_t mode, bool& direct) {
+#ifdef O_DIRECT
+  if (direct) {
+    int fd = open(path.c_str(), flags | O_DIRECT, mode);
+    if (fd >= 0 || errno != EINVAL) {
+      return fd;
+    }
+  }
+#endif
+  direct = false;
+  return open(path.c_str(), flags, mode);
+}
+
+static void disableDirect(int fd) {
+#ifdef O_DIRECT
+  int flags = fcntl(fd, F_GETFL);
+  if (flags >= 0) {
+    fcntl(fd, F_SETFL, flags & ~O_DIRECT);
+  }
+#endif
+}
+
+// Writes the copied range back and drops it from the page cache of both files
+static void dropCopiedPages(int srcFd, int destFd, uint64_t offset, uint64_t length) {
+#ifdef __linux__
+  if (length == 0) {
+    return;
+  }
+  // Dirty pages can't be dropped, so wait for the writeback of this range first
+  sync_file_range(destFd, offset, length, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+  posix_fadvise(destFd, offset, length, POSIX_FADV_DONTNEED);
+  posix_fadvise(srcFd, offset, length, POSIX_FADV_DONTNEED);
+#endif
+}
+
+static bool writeAll(int fd, const uint8_t* data, size_t length, uint64_t offset) {
+  for (size_t written = 0; written < length;) {
+    ssize_t res = pwrite(fd, data + written, length - written, offset + written);
+    if (res < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    written += res;
+  }
+  return true;
+}
+
+// Copies the whole file around the page cache, so bulk copies don't evict the working set of the app.
+// With O_DIRECT the data goes straight between the disk and an aligned pooled buffer, otherwise
+// (filesystems without O_DIRECT, misaligned I/O) the pages are written back and dropped every chunk.
+static void copyDataUncached(int srcFd, int destFd, bool direct, uint64_t size, CopyProgress& progress) {
+  constexpr size_t kAlignment = AlignedBufferPool::kAlignment;
+  AlignedBufferPool::Lease buffer = AlignedBufferPool::directIo().acquire();
+  uint64_t offset = 0;
+  uint64_t droppedUpTo = 0;
+  while (offset < size) {
+    size_t wanted = static_cast<size_t>(std::min<uint64_t>(size - offset, buffer.size()));
+    // O_DIRECT needs block multiples, a read past the end of file is just short
+    size_t readLength = direct ? (wanted + kAlignment - 1) / kAlignment * kAlignment : wanted;
+    ssize_t bytesRead = pread(srcFd, buffer.data(), std::min(readLength, buffer.size()), offset);
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      if (direct && errno == EINVAL) {
+        direct = false;
+        disableDirect(srcFd);
+        disableDirect(destFd);
+        continue;
+      }
+      throw strerror(errno);
+    }
+    if (bytesRead == 0) {
+      // The source got shorter while copying
+      break;
+    }
+    size_t count = std::min(static_cast<size_t>(bytesRead), wanted);
+    size_t writeLength = count;
+    if (direct && count % kAlignment != 0) {
+      // The last block is padded with zeros and cut off by the ftruncate below
+      writeLength = (count + kAlignment - 1) / kAlignment * kAlignment;
+      memset(buffer.data() + count, 0, writeLength - count);
+    }
+    if (!writeAll(destFd, buffer.data(), writeLength, offset)) {
+      if (direct && errno == EINVAL) {
+        direct = false;
+        disableDirect(srcFd);
+        disableDirect(destFd);
+        continue;
+      }
+      throw strerror(errno);
+    }
+    offset += count;
+    progress.bytesCopied.fetch_add(count, std::memory_order_relaxed);
+    if (!direct && offset - droppedUpTo >= kCopyChunkSize) {
+      dropCopiedPages(srcFd, destFd, droppedUpTo, offset - droppedUpTo);
+      droppedUpTo = offset;
+    }
+  }
+  if (ftruncate(destFd, static_cast<off_t>(offset)) != 0) {
+    throw strerror(errno);
+  }
+  if (!direct) {
+    dropCopiedPages(srcFd, destFd, droppedUpTo, offset - droppedUpTo);
+  }
+}
+
+static void copyFileInternal(const std::string& srcPath, const std::string& destPath, const struct stat& srcStat, const CopyOptions& options, CopyProgress& progress) {
+  bool srcDirect = options.uncached;
+  UniqueFd srcFd(openFile(srcPath, O_RDONLY | O_CLOEXEC, 0, srcDirect));
+  if (!srcFd.valid()) {
+    throw strerror(errno);
+  }
+  bool destDirect = options.uncached;
+  // An existing destination is truncated only once it is known not to be the source itself
+  // (same path, a hard link, a symlinked or bind mounted directory)
+  int destFlags = O_WRONLY | O_CREAT | O_CLOEXEC | (options.overwrite ? 0 : O_EXCL);
+  UniqueFd destFd(openFile(destPath, destFlags, srcStat.st_mode & 07777, destDirect));
+  if (!destFd.valid()) {
+    throw strerror(errno);
+  }
+  if (options.overwrite) {
+    struct stat destStat;
+    if (fstat(destFd.get(), &destStat) != 0) {
+      throw strerror(errno);
+    }
+    if (destStat.st_dev == srcStat.st_dev && destStat.st_ino == srcStat.st_ino) {
+      throw "Source and destination are the same file";
+    }
+    if (ftruncate(destFd.get(), 0) != 0) {
+      throw strerror(errno);
+    }
+  }
+  uint64_t size = static_cast<uint64_t>(srcStat.st_size);
+  if (options.uncached) {
+    // Aligned I/O only works when both sides are direct
+    if (srcDirect != destDirect) {
+      disableDirect(srcFd.get());
+      disableDirect(destFd.get());
+    }
+#ifdef __APPLE__
+    // Apple's O_DIRECT, without alignment requirements
+    fcntl(srcFd.get(), F_NOCACHE, 1);
+    fcntl(destFd.get(), F_NOCACHE, 1);
+#endif
+    copyDataUncached(srcFd.get(), destFd.get(), srcDirect && destDirect, size, progress);
+  } else {
+    // Fewer allocated blocks than the size means the file has holes
+    bool isSparse = static_cast<uint64_t>(srcStat.st_blocks) * 512 < size;
+    if (!isSparse || !copySparseData(srcFd.get(), destFd.get(), size, progress)) {
+      copyRange(srcFd.get(), destFd.get(), size, progress);
+    }
+  }
+
+#ifdef __APPLE__
+  struct timespec times[2] = {srcStat.st_atimespec, srcStat.st_mtimespec};
+#else
+  struct timespec times[2] = {srcStat.st_atim, srcStat.st_mtim};
+#endif
+  futimens(destFd.get(), times);
+  if (options.sync && fsync(destFd.get()) != 0) {
+    throw strerror(errno);
+  }
+}
+
+void copyFileNative(const std::string& srcPath, const std::string& destPath, const CopyOptions& options, CopyProgress& progress) {
+  struct stat srcStat;
+  if (stat(srcPath.c_str(), &srcStat) != 0) {
+    throw strerror(errno);
+  }
+  if (!S_ISREG(srcStat.st_mode)) {
+    throw "Not a file";
+  }
+  progress.totalBytes.fetch_add(srcStat.st_size, std::memory_order_relaxed);
+  copyFileInternal(srcPath, destPath, srcStat, options, progress);
+}
+
+namespace {
+
+struct TreeItem {
+  std::string relativePath;
+  struct stat st;
+};
+
+}
+
+// Pre-order, so every directory comes before its content. Throws for entries that can't be stat'ed
+// and for anything but files, directories and symlinks, a copy must not skip anything silently.
+static void listTree(const std::string& root, const std::string& relativeDir, std::vector<TreeItem>& items) {
+  std::string dirPath = relativeDir.empty() ? root : root + "/" + relativeDir;
+  UniqueFd dirFd(open(dirPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+  if (!dirFd.valid()) {
+    throw strerror(errno);
+  }
+  std::vector<std::string> subdirs;
+  const char* error = nullptr;
+  bool complete = readDirectoryEntries(dirFd.get(), [&](const char* name, unsigned char type) {
+    if (error != nullptr) {
+      return;
+    }
+    TreeItem item;
+    item.relativePath = relativeDir.empty() ? std::string(name) : relativeDir + "/" + name;
+    if (fstatat(dirFd.get(), name, &item.st, AT_SYMLINK_NOFOLLOW) != 0) {
+      error = strerror(errno);
+      return;
+    }
+    if (!S_ISDIR(item.st.st_mode) && !S_ISREG(item.st.st_mode) && !S_ISLNK(item.st.st_mode)) {
+      error = "Unsupported file type";
+      return;
+    }
+    if (S_ISDIR(item.st.st_mode)) {
+      subdirs.push_back(item.relativePath);
+    }
+    items.push_back(std::move(item));
+  });
+  if (!complete) {
+    throw strerror(errno);
+  }
+  if (error != nullptr) {
+    throw error;
+  }
+  dirFd.reset();
+  for (const std::string& subdir : subdirs) {
+    listTree(root, subdir, items);
+  }
+}
+
+void copyTreeNative(const std::string& srcPath, const std::string& destPath, const CopyOptions& options, CopyProgress& progress) {
+  struct stat rootStat;
+  if (stat(srcPath.c_str(), &rootStat) != 0) {
+    throw strerror(errno);
+  }
+  if (!S_ISDIR(rootStat.st_mode)) {
+    throw "Not a directory";
+  }
+  // Copying a directory into itself would read what it has just written
+  fs::path destRoot = fs::weakly_canonical(destPath);
+  for (fs::path dir = destRoot; ; dir = dir.parent_path()) {
+    struct stat dirStat;
+    if (stat(dir.c_str(), &dirStat) == 0 && dirStat.st_dev == rootStat.st_dev && dirStat.st_ino == rootStat.st_ino) {
+      throw dir == destRoot ? "Source and destination are the same directory" : "Destination is inside the source directory";
+    }
+    if (!dir.has_relative_path()) {
+      break;
+    }
+  }
+
+  std::vector<TreeItem> items;
+  listTree(srcPath, "", items);
+  std::vector<size_t> files;
+  uint64_t totalBytes{0};
+  for (size_t i = 0; i < items.size(); i++) {
+    if (S_ISREG(items[i].st.st_mode)) {
+      files.push_back(i);
+      totalBytes += items[i].st.st_size;
+    }
+  }
+  progress.totalBytes.fetch_add(totalBytes, std::memory_order_relaxed);
+
+  // Directories and links are cheap and have to exist before the files, so they are created first
+  if (mkdir(destPath.c_str(), (rootStat.st_mode & 07777) | S_IRWXU) != 0 && errno != EEXIST) {
+    throw strerror(errno);
+  }
+  std::vector<std::string> createdDirs{destPath};
+  for (const TreeItem& item : items) {
+    std::string itemPath = destPath + "/" + item.relativePath;
+    if (S_ISDIR(item.st.st_mode)) {
+      if (mkdir(itemPath.c_str(), (item.st.st_mode & 07777) | S_IRWXU) != 0 && errno != EEXIST) {
+        throw strerror(errno);
+      }
+      createdDirs.push_back(std::move(itemPath));
+    } else if (S_ISLNK(item.st.st_mode)) {
+      std::string target(item.st.st_size > 0 ? item.st.st_size : PATH_MAX, '\0');
+      ssize_t length = readlink((srcPath + "/" + item.relativePath).c_str(), target.data(), target.size());
+      if (length < 0) {
+        throw strerror(errno);
+      }
+      target.resize(length);
+      unlink(itemPath.c_str());
+      if (symlink(target.c_str(), itemPath.c_str()) != 0) {
+        throw strerror(errno);
+      }
+    }
+  }
+
+  // Workers pick the next file dynamically, a few big files would unbalance fixed ranges
+  std::atomic<size_t> nextFile{0};
+  parallelFor(std::min(workerCount(), files.size()), 1, [&](size_t begin, size_t end) {
+    size_t index;
+    while ((index = nextFile.fetch_add(1, std::memory_order_relaxed)) < files.size()) {
+      const TreeItem& item = items[files[index]];
+      copyFileInternal(srcPath + "/" + item.relativePath, destPath + "/" + item.relativePath, item.st, options, progress);
+    }
+  });
+
+  if (!options.sync) {
+    return;
+  }
+  // Make the new directory entries durable as well
+  for (const std::string& dir : createdDirs) {
+    UniqueFd dirFd(open(dir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+    if (dirFd.valid()) {
+      fsync(dirFd.get());
+    }
+  }
+}
+
+// Unused name next to path, on the same filesystem so it can be renamed into place
+static std::string temporarySibling(const std::string& path) {
+  static std::atomic<uint64_t> counter{0};
+  return path + ".rnfsturbo-move-" + std::to_string(getpid()) + "-" + std::to_string(counter.fetch_add(1));
+}
+
+void moveAcrossDevices(const std::string& srcPath, const std::string& destPath, bool uncached, CopyProgress& progress) {
+  struct stat srcStat;
+  if (lstat(srcPath.c_str(), &srcStat) != 0) {
+    throw strerror(errno);
+  }
+  bool isDirectory = S_ISDIR(srcStat.st_mode);
+  if (!isDirectory && !S_ISREG(srcStat.st_mode) && !S_ISLNK(srcStat.st_mode)) {
+    throw "Unsupported file type";
+  }
+  // Same rules as rename(2): a directory only replaces an empty directory, anything else only a non-directory
+  struct stat destStat;
+  if (lstat(destPath.c_str(), &destStat) == 0) {
+    if (S_ISDIR(destStat.st_mode) != isDirectory) {
+      throw strerror(isDirectory ? ENOTDIR : EISDIR);
+    }
+    std::error_code ec;
+    if (isDirectory && !fs::is_empty(destPath, ec)) {
+      throw strerror(ec ? ec.value() : ENOTEMPTY);
+    }
+  } else if (errno != ENOENT) {
+    throw strerror(errno);
+  }
+
+  // Everything is copied to a new path first and renamed over the destination at the end, so a failed
+  // copy only removes what it created. The source is removed right after, so the copy has to be on disk.
+  std::string tempPath = temporarySibling(destPath);
+  CopyOptions options{false, true, uncached};
+  try {
+    if (isDirectory) {
+      copyTreeNative(srcPath, tempPath, options, progress);
+    } else if (S_ISLNK(srcStat.st_mode)) {
+      std::string target(PATH_MAX, '\0');
+      ssize_t length = readlink(srcPath.c_str(), target.data(), target.size());
+      if (length < 0) {
+        throw strerror(errno);
+      }
+      target.resize(length);
+      if (symlink(target.c_str(), tempPath.c_str()) != 0) {
+        throw strerror(errno);
+      }
+    } else {
+      progress.totalBytes.fetch_add(srcStat.st_size, std::memory_order_relaxed);
+      copyFileInternal(srcPath, tempPath, srcStat, options, progress);
+    }
+    if (rename(tempPath.c_str(), destPath.c_str()) != 0) {
+      throw strerror(errno);
+    }
+  } catch (...) {
+    std::error_code ec;
+    fs::remove_all(tempPath, ec);
+    throw;
+  }
+  // Makes the rename durable before the source goes away
+  std::string parentPath = fs::path(destPath).parent_path().string();
+  UniqueFd parentFd(open(parentPath.empty() ? "." : parentPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC));
+  if (parentFd.valid()) {
+    fsync(parentFd.get());
+  }
+
+  std::error_code ec;
+  fs::remove_all(srcPath, ec);
+  if (ec) {
+    throw strerror(ec.value());
+  }
+}
+
+void runWithProgress(
+  const std::function<void(CopyProgress& progress)>& job,
+  const CopyProgressCallback& onProgress,
+  int intervalMs
+) {
+  CopyProgress progress;
+  std::mutex mutex;
+  std::condition_variable doneCondition;
+  bool done{false};
+  std::exception_ptr error = nullptr;
+
+  std::thread worker([&]() {
+    try {
+      job(progress);
+    } catch (...) {
+      error = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    done = true;
+    doneCondition.notify_one();
+  });
+
+  try {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (!doneCondition.wait_for(lock, std::chrono::milliseconds(intervalMs), [&done]() { return done; })) {
+      lock.unlock();
+      onProgress(progress.bytesCopied.load(std::memory_order_relaxed), progress.totalBytes.load(std::memory_order_relaxed));
+      lock.lock();
+    }
+  } catch (...) {
+    worker.join();
+    throw;
+  }
+  worker.join();
+
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+  onProgress(progress.bytesCopied.load(std::memory_order_relaxed), progress.totalBytes.load(std::memory_order_relaxed));
+}
+
+}
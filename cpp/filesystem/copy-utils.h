@@ -0,0 +1,55 @@
+//
+//  copy-utils.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+namespace cmpayc::rnfsturbo {
+
+// Shared by the copying threads and the thread reporting progress
+struct CopyProgress {
+  std::atomic<uint64_t> bytesCopied{0};
+  std::atomic<uint64_t> totalBytes{0};
+};
+
+using CopyProgressCallback = std::function<void(uint64_t bytesCopied, uint64_t totalBytes)>;
+
+struct CopyOptions {
+  bool overwrite{true}; // Replace existing files, otherwise fail with EEXIST
+  bool sync{false}; // fsync copied files and created directories
+  bool uncached{false}; // Bypass the page cache (O_DIRECT, F_NOCACHE on Apple), sparse files are copied densely
+};
+
+// Copies a regular file in the kernel where possible (copy_file_range, then sendfile) and keeps
+// its mode and mtime. Sparse files are copied extent by extent (SEEK_DATA/SEEK_HOLE),
+// so holes stay holes at the destination. Fails when destPath is the source file itself.
+void copyFileNative(const std::string& srcPath, const std::string& destPath, const CopyOptions& options, CopyProgress& progress);
+
+// Copies a directory tree into destPath, which may already exist. Files are copied in parallel on the
+// worker pool. Fails for entries that can't be read or reproduced (FIFOs, sockets, devices),
+// and when destPath is the source directory or inside it
+void copyTreeNative(const std::string& srcPath, const std::string& destPath, const CopyOptions& options, CopyProgress& progress);
+
+// rename() for different filesystems: copies a file or a tree next to the destination, syncs it, renames it
+// into place and only then removes the source. Fails like rename(2) when the destination is a non-empty
+// directory or of the other kind. A failed copy removes only what it created and keeps the source.
+// Anything but files, directories and symlinks (FIFOs, sockets, devices) fails the move.
+void moveAcrossDevices(const std::string& srcPath, const std::string& destPath, bool uncached, CopyProgress& progress);
+
+// Runs `job` on a separate thread and calls `onProgress` on the calling thread every `intervalMs`
+// until it is done. The job's exception is rethrown on the calling thread.
+void runWithProgress(
+  const std::function<void(CopyProgress& progress)>& job,
+  const CopyProgressCallback& onProgress,
+  int intervalMs
+);
+
+}
@@ -0,0 +1,152 @@
+//
+//  dir-cursor.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include "dir-cursor.h"
+#include "stat-utils.h"
+
+namespace cmpayc::rnfsturbo {
+
+std::optional<DirSort> parseDirSort(std::string_view sort) {
+  if (sort == "name") {
+    return DirSort::Name;
+  }
+  if (sort == "mtime") {
+    return DirSort::Mtime;
+  }
+  if (sort == "size") {
+    return DirSort::Size;
+  }
+  return std::nullopt;
+}
+
+DirCursor::DirCursor(const std::string& path, DirSort sort, bool descending, size_t limit)
+  : dirPath(path), sort(sort), descending(descending), limit(limit) {
+  dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    throw strerror(errno);
+  }
+  if (dirPath.back() != '/') {
+    dirPath.push_back('/');
+  }
+}
+
+DirCursor::~DirCursor() {
+  close();
+}
+
+void DirCursor::close() {
+  if (dir != nullptr) {
+    closedir(dir);
+    dir = nullptr;
+  }
+  sortedEntries.clear();
+  sortedEntries.shrink_to_fit();
+}
+
+bool DirCursor::readEntry(WalkEntry& entry) {
+  while (struct dirent* item = readdir(dir)) {
+    const char* name = item->d_name;
+    if (name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'))) {
+      continue;
+    }
+    struct stat st;
+    if (fstatat(dirfd(dir), name, &st, 0) != 0) {
+      continue;
+    }
+    entry.path.assign(dirPath).append(name);
+    entry.nameOffset = dirPath.size();
+    entry.size = static_cast<double>(st.st_size);
+    entry.mtime = mtimeSeconds(st);
+    entry.isDirectory = S_ISDIR(st.st_mode);
+    entry.isFile = S_ISREG(st.st_mode);
+    return true;
+  }
+  return false;
+}
+
+bool DirCursor::isBefore(const WalkEntry& a, const WalkEntry& b) const {
+  const WalkEntry& first = descending ? b : a;
+  const WalkEntry& second = descending ? a : b;
+  switch (sort) {
+    case DirSort::Name:
+      return std::string_view(first.path).substr(first.nameOffset) < std::string_view(second.path).substr(second.nameOffset);
+    case DirSort::Mtime:
+      return first.mtime < second.mtime;
+    case DirSort::Size:
+      return first.size < second.size;
+    case DirSort::None:
+      break;
+  }
+  return false;
+}
+
+void DirCursor::sortEntries() {
+  sorted = true;
+  auto compare = [this](const WalkEntry& a, const WalkEntry& b) {
+    return isBefore(a, b);
+  };
+  WalkEntry entry;
+  if (limit == 0) {
+    while (readEntry(entry)) {
+      sortedEntries.push_back(std::move(entry));
+    }
+    std::sort(sortedEntries.begin(), sortedEntries.end(), compare);
+  } else {
+    // Max-heap of the `limit` best entries: the worst kept one is on top and gets replaced
+    sortedEntries.reserve(limit);
+    while (readEntry(entry)) {
+      if (sortedEntries.size() < limit) {
+        sortedEntries.push_back(std::move(entry));
+        std::push_heap(sortedEntries.begin(), sortedEntries.end(), compare);
+      } else if (compare(entry, sortedEntries.front())) {
+        std::pop_heap(sortedEntries.begin(), sortedEntries.end(), compare);
+        sortedEntries.back() = std::move(entry);
+        std::push_heap(sortedEntries.begin(), sortedEntries.end(), compare);
+      }
+    }
+    std::sort_heap(sortedEntries.begin(), sortedEntries.end(), compare);
+  }
+  closedir(dir);
+  dir = nullptr;
+}
+
+std::vector<WalkEntry> DirCursor::next(size_t count) {
+  std::vector<WalkEntry> result;
+  if (sort != DirSort::None) {
+    if (!sorted && dir != nullptr) {
+      sortEntries();
+    }
+    size_t end = std::min(returned + count, sortedEntries.size());
+    result.reserve(end - std::min(returned, end));
+    for (; returned < end; returned++) {
+      result.push_back(std::move(sortedEntries[returned]));
+    }
+    return result;
+  }
+
+  if (dir == nullptr) {
+    return result;
+  }
+  result.reserve(count);
+  WalkEntry entry;
+  while (result.size() < count && (limit == 0 || returned < limit) && readEntry(entry)) {
+    result.push_back(std::move(entry));
+    returned++;
+  }
+  if (result.size() < count) {
+    closedir(dir);
+    dir = nullptr;
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,54 @@
+//
+//  dir-cursor.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <dirent.h>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "walk-utils.h"
+
+namespace cmpayc::rnfsturbo {
+
+enum class DirSort : uint8_t { None, Name, Mtime, Size };
+
+std::optional<DirSort> parseDirSort(std::string_view sort);
+
+// Reads a directory page by page. Unsorted cursors stream straight from the DIR*,
+// sorted ones read the directory on the first page keeping at most `limit` best entries.
+class DirCursor {
+public:
+  DirCursor(const std::string& path, DirSort sort, bool descending, size_t limit);
+  ~DirCursor();
+
+  DirCursor(const DirCursor&) = delete;
+  DirCursor& operator=(const DirCursor&) = delete;
+
+  // Up to `count` entries, an empty result means the cursor is exhausted
+  std::vector<WalkEntry> next(size_t count);
+  void close();
+
+private:
+  bool readEntry(WalkEntry& entry);
+  void sortEntries();
+  bool isBefore(const WalkEntry& a, const WalkEntry& b) const;
+
+private:
+  std::string dirPath;
+  DIR* dir{nullptr};
+  DirSort sort;
+  bool descending;
+  size_t limit; // 0 - no limit
+  size_t returned{0};
+  bool sorted{false};
+  std::vector<WalkEntry> sortedEntries;
+};
+
+}
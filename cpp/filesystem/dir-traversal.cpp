@@ -0,0 +1,88 @@
+//
+//  dir-traversal.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <chrono>
+#include <thread>
+#include "dir-traversal.h"
+#include "worker-pool.h"
+
+namespace cmpayc::rnfsturbo {
+
+DirTraversal::DirTraversal() {
+  size_t count = workerCount();
+  queues.reserve(count);
+  for (size_t i = 0; i < count; i++) {
+    queues.push_back(std::make_unique<WorkQueue>());
+  }
+}
+
+void DirTraversal::run() {
+  parallelFor(queues.size(), 1, [this](size_t begin, size_t end) {
+    for (size_t index = begin; index < end; index++) {
+      worker(index);
+    }
+  });
+}
+
+void DirTraversal::pushDirectory(size_t worker, DirTask&& dir) {
+  pending.fetch_add(1, std::memory_order_acq_rel);
+  WorkQueue& queue = *queues[worker % queues.size()];
+  std::lock_guard<std::mutex> lock(queue.mutex);
+  queue.tasks.push_back(std::move(dir));
+}
+
+bool DirTraversal::popDirectory(size_t index, DirTask& dir) {
+  {
+    WorkQueue& own = *queues[index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      dir = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      return true;
+    }
+  }
+  for (size_t i = 1; i < queues.size(); i++) {
+    WorkQueue& victim = *queues[(index + i) % queues.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      dir = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      return true;
+    }
+  }
+  return false;
+}
+
+void DirTraversal::worker(size_t index) {
+  DirTask dir;
+  unsigned int idleRounds = 0;
+  try {
+    while (!stopped.load(std::memory_order_relaxed)) {
+      if (popDirectory(index, dir)) {
+        idleRounds = 0;
+        visitDirectory(index, dir);
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+        continue;
+      }
+      if (pending.load(std::memory_order_acquire) == 0) {
+        break;
+      }
+      if (++idleRounds < 64) {
+        std::this_thread::yield();
+      } else {
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+      }
+    }
+    finishWorker(index);
+  } catch (...) {
+    // Let the other workers bail out instead of waiting for the failed directory
+    stopped.store(true, std::memory_order_relaxed);
+    throw;
+  }
+}
+
+}
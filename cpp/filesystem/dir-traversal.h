@@ -0,0 +1,127 @@
+//
+//  dir-traversal.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cerrno>
+#include <cstdint>
+#include <deque>
+#include <dirent.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unistd.h>
+#include <vector>
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+namespace cmpayc::rnfsturbo {
+
+struct DirTask {
+  std::string path;
+  int depth;
+  uint32_t tag; // Free for subclasses, e.g. the top level child a subtree belongs to
+};
+
+// Parallel directory traversal shared by walk and du.
+// Every worker owns a deque: it pushes and pops subdirectories at the back (depth first,
+// so its data stays local) and idle workers steal the oldest, usually biggest, subtree from the front.
+class DirTraversal {
+public:
+  DirTraversal();
+  virtual ~DirTraversal() = default;
+
+  // Processes every pushed directory and everything pushed while visiting them
+  void run();
+
+protected:
+  virtual void visitDirectory(size_t worker, const DirTask& dir) = 0;
+  // Called on the worker thread once the traversal is over
+  virtual void finishWorker(size_t worker) {}
+
+  void pushDirectory(size_t worker, DirTask&& dir);
+
+  size_t workers() const {
+    return queues.size();
+  }
+
+private:
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<DirTask> tasks;
+  };
+
+  void worker(size_t index);
+  bool popDirectory(size_t index, DirTask& dir);
+
+private:
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+  std::atomic<size_t> pending{0};
+  std::atomic<bool> stopped{false};
+};
+
+#ifdef __linux__
+struct LinuxDirent64 {
+  uint64_t d_ino;
+  int64_t d_off;
+  unsigned short d_reclen;
+  unsigned char d_type;
+  char d_name[];
+};
+#endif
+
+inline bool isDotEntry(const char* name) {
+  return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+// Calls `onEntry(name, d_type)` for every entry except `.` and `..`.
+// getdents64 fills a whole buffer per syscall instead of going through readdir's DIR* state.
+// Returns false (errno set) when the directory couldn't be read to the end.
+template <typename OnEntry>
+bool readDirectoryEntries(int dirFd, OnEntry&& onEntry) {
+#ifdef __linux__
+  alignas(LinuxDirent64) char buffer[32 * 1024];
+  while (true) {
+    long bytes = syscall(SYS_getdents64, dirFd, buffer, sizeof(buffer));
+    if (bytes <= 0) {
+      return bytes == 0;
+    }
+    for (long offset = 0; offset < bytes;) {
+      auto* entry = reinterpret_cast<LinuxDirent64*>(buffer + offset);
+      offset += entry->d_reclen;
+      if (!isDotEntry(entry->d_name)) {
+        onEntry(static_cast<const char*>(entry->d_name), entry->d_type);
+      }
+    }
+  }
+#else
+  int ownFd = dup(dirFd);
+  if (ownFd < 0) {
+    return false;
+  }
+  DIR* dir = fdopendir(ownFd);
+  if (dir == nullptr) {
+    close(ownFd);
+    return false;
+  }
+  errno = 0;
+  while (struct dirent* entry = readdir(dir)) {
+    if (!isDotEntry(entry->d_name)) {
+      onEntry(static_cast<const char*>(entry->d_name), entry->d_type);
+    }
+    errno = 0;
+  }
+  int readError = errno;
+  closedir(dir);
+  errno = readError;
+  return readError == 0;
+#endif
+}
+
+}
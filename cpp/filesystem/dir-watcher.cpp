@@ -0,0 +1,299 @@
+//
+//  dir-watcher.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <unordered_map>
+#include <unistd.h>
+#ifdef __linux__
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <sys/stat.h>
+#endif
+#include "dir-traversal.h"
+#include "dir-watcher.h"
+
+namespace cmpayc::rnfsturbo {
+
+// Upper bound for holding back a batch while events keep coming
+static constexpr int kMaxBatchDelayMs = 1000;
+
+static constexpr std::string_view kWatchEventNames[] = {"create", "modify", "delete", "move", "overflow"};
+
+std::optional<WatchEvents> parseWatchEvent(std::string_view event) {
+  for (size_t i = 0; i < std::size(kWatchEventNames); i++) {
+    if (kWatchEventNames[i] == event) {
+      return static_cast<WatchEvents>(1 << i);
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<std::string_view> watchEventNames(uint32_t events) {
+  std::vector<std::string_view> names;
+  for (size_t i = 0; i < std::size(kWatchEventNames); i++) {
+    if (events & (1 << i)) {
+      names.push_back(kWatchEventNames[i]);
+    }
+  }
+  return names;
+}
+
+struct DirWatcher::State {
+  std::string root;
+  WatchOptions options;
+  WatchCallback callback;
+  int inotifyFd{-1};
+  int wakeFd{-1};
+  uint32_t kernelMask{0};
+  std::unordered_map<int, std::string> watchedDirs;
+  std::unordered_map<std::string, size_t> pendingIndex;
+  std::vector<WatchChange> pending;
+
+  void addChange(const std::string& path, uint32_t events, bool isDirectory) {
+    events &= options.events | WatchEventOverflow;
+    if (events == 0) {
+      return;
+    }
+    auto [it, inserted] = pendingIndex.try_emplace(path, pending.size());
+    if (inserted) {
+      pending.push_back({path, events, isDirectory});
+    } else {
+      pending[it->second].events |= events;
+    }
+  }
+
+  void flush() {
+    pendingIndex.clear();
+    std::vector<WatchChange> changes;
+    changes.swap(pending);
+    callback(std::move(changes));
+  }
+
+#ifdef __linux__
+  // New directories may already have content by the time their watch is added, it is reported as created
+  void addWatchTree(const std::string& path, bool reportContent) {
+    int wd = inotify_add_watch(inotifyFd, path.c_str(), kernelMask | IN_ONLYDIR);
+    if (wd < 0) {
+      return;
+    }
+    watchedDirs[wd] = path;
+    if (!options.recursive && !reportContent) {
+      return;
+    }
+    int dirFd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+      return;
+    }
+    std::vector<std::string> subdirs;
+    readDirectoryEntries(dirFd, [&](const char* name, unsigned char type) {
+      if (type == DT_UNKNOWN) {
+        struct stat st;
+        if (fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+          return;
+        }
+        type = S_ISDIR(st.st_mode) ? DT_DIR : DT_REG;
+      }
+      std::string childPath = path + "/" + name;
+      if (reportContent) {
+        addChange(childPath, WatchEventCreate, type == DT_DIR);
+      }
+      if (options.recursive && type == DT_DIR) {
+        subdirs.push_back(std::move(childPath));
+      }
+    });
+    close(dirFd);
+    for (const std::string& subdir : subdirs) {
+      addWatchTree(subdir, reportContent);
+    }
+  }
+
+  void handleEvent(const struct inotify_event& event) {
+    if (event.mask & IN_Q_OVERFLOW) {
+      addChange(root, WatchEventOverflow, true);
+      return;
+    }
+    if (event.mask & IN_IGNORED) {
+      watchedDirs.erase(event.wd);
+      return;
+    }
+    auto dir = watchedDirs.find(event.wd);
+    if (dir == watchedDirs.end()) {
+      return;
+    }
+    bool isSelfEvent = event.mask & (IN_DELETE_SELF | IN_MOVE_SELF);
+    // Subdirectories are already reported by their parent
+    if (isSelfEvent && dir->second != root) {
+      return;
+    }
+    std::string path = dir->second;
+    if (event.len > 0 && event.name[0] != '\0') {
+      path.push_back('/');
+      path.append(event.name);
+    }
+    bool isDirectory = isSelfEvent || (event.mask & IN_ISDIR);
+
+    uint32_t events{0};
+    if (event.mask & IN_CREATE) {
+      events |= WatchEventCreate;
+    }
+    if (event.mask & (IN_MODIFY | IN_CLOSE_WRITE)) {
+      events |= WatchEventModify;
+    }
+    if (event.mask & (IN_DELETE | IN_DELETE_SELF)) {
+      events |= WatchEventDelete;
+    }
+    if (event.mask & (IN_MOVED_FROM | IN_MOVED_TO | IN_MOVE_SELF)) {
+      events |= WatchEventMove;
+    }
+    addChange(path, events, isDirectory);
+
+    if (options.recursive && isDirectory && (event.mask & (IN_CREATE | IN_MOVED_TO))) {
+      addWatchTree(path, true);
+    }
+  }
+#endif
+};
+
+bool DirWatcher::isSupported() {
+#ifdef __linux__
+  return true;
+#else
+  return false;
+#endif
+}
+
+DirWatcher::DirWatcher(const std::string& path, const WatchOptions& options, WatchCallback callback)
+  : state(std::make_unique<State>()) {
+#ifdef __linux__
+  state->root = path;
+  state->options = options;
+  state->callback = std::move(callback);
+
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0) {
+    throw strerror(errno);
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    throw "Not a directory";
+  }
+
+  state->kernelMask = IN_EXCL_UNLINK | IN_DELETE_SELF | IN_MOVE_SELF;
+  if (options.events & WatchEventCreate) {
+    state->kernelMask |= IN_CREATE;
+  }
+  if (options.events & WatchEventModify) {
+    state->kernelMask |= IN_MODIFY | IN_CLOSE_WRITE;
+  }
+  if (options.events & WatchEventDelete) {
+    state->kernelMask |= IN_DELETE;
+  }
+  if (options.events & WatchEventMove) {
+    state->kernelMask |= IN_MOVED_FROM | IN_MOVED_TO;
+  }
+  if (options.recursive) {
+    // Needed to follow new subdirectories even if their events are not reported
+    state->kernelMask |= IN_CREATE | IN_MOVED_TO;
+  }
+
+  state->inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (state->inotifyFd < 0) {
+    throw strerror(errno);
+  }
+  state->wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (state->wakeFd < 0) {
+    int error = errno;
+    close(state->inotifyFd);
+    throw strerror(error);
+  }
+  state->addWatchTree(path, false);
+  if (state->watchedDirs.empty()) {
+    close(state->inotifyFd);
+    close(state->wakeFd);
+    throw "Unable to watch the directory";
+  }
+
+  thread = std::thread(&DirWatcher::run, this);
+#else
+  throw "Command only for Android";
+#endif
+}
+
+DirWatcher::~DirWatcher() {
+#ifdef __linux__
+  if (thread.joinable()) {
+    uint64_t wake = 1;
+    write(state->wakeFd, &wake, sizeof(wake));
+    thread.join();
+  }
+  if (state->inotifyFd >= 0) {
+    close(state->inotifyFd);
+  }
+  if (state->wakeFd >= 0) {
+    close(state->wakeFd);
+  }
+#endif
+}
+
+void DirWatcher::run() {
+#ifdef __linux__
+  using Clock = std::chrono::steady_clock;
+  alignas(struct inotify_event) char buffer[64 * 1024];
+  Clock::time_point firstEvent;
+  Clock::time_point lastEvent;
+  int debounceMs = std::max(state->options.debounceMs, 0);
+  int maxDelayMs = std::max(debounceMs, kMaxBatchDelayMs);
+
+  struct pollfd fds[2];
+  fds[0] = {state->inotifyFd, POLLIN, 0};
+  fds[1] = {state->wakeFd, POLLIN, 0};
+  while (true) {
+    int timeout = -1;
+    if (!state->pending.empty()) {
+      auto now = Clock::now();
+      auto quietAt = lastEvent + std::chrono::milliseconds(debounceMs);
+      auto latestAt = firstEvent + std::chrono::milliseconds(maxDelayMs);
+      auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(std::min(quietAt, latestAt) - now).count();
+      timeout = static_cast<int>(std::max<long long>(wait, 0));
+    }
+    int res = poll(fds, 2, timeout);
+    if (res < 0 && errno != EINTR) {
+      return;
+    }
+    if (fds[1].revents & POLLIN) {
+      return;
+    }
+    if (res > 0 && (fds[0].revents & POLLIN)) {
+      bool hadPending = !state->pending.empty();
+      ssize_t bytes;
+      while ((bytes = read(state->inotifyFd, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t offset = 0; offset < bytes;) {
+          auto* event = reinterpret_cast<struct inotify_event*>(buffer + offset);
+          state->handleEvent(*event);
+          offset += sizeof(struct inotify_event) + event->len;
+        }
+      }
+      lastEvent = Clock::now();
+      if (!hadPending) {
+        firstEvent = lastEvent;
+      }
+    }
+    if (!state->pending.empty()) {
+      auto now = Clock::now();
+      if (now - lastEvent >= std::chrono::milliseconds(debounceMs) || now - firstEvent >= std::chrono::milliseconds(maxDelayMs)) {
+        state->flush();
+      }
+    }
+  }
+#endif
+}
+
+}
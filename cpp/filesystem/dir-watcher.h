@@ -0,0 +1,72 @@
+//
+//  dir-watcher.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+enum WatchEvents : uint32_t {
+  WatchEventCreate = 1 << 0,
+  WatchEventModify = 1 << 1,
+  WatchEventDelete = 1 << 2,
+  WatchEventMove = 1 << 3,
+  // The kernel queue overflowed and events were lost, the whole tree should be rescanned
+  WatchEventOverflow = 1 << 4,
+  WatchEventAll = WatchEventCreate | WatchEventModify | WatchEventDelete | WatchEventMove,
+};
+
+std::optional<WatchEvents> parseWatchEvent(std::string_view event);
+std::vector<std::string_view> watchEventNames(uint32_t events);
+
+struct WatchOptions {
+  bool recursive{false};
+  uint32_t events{WatchEventAll};
+  int debounceMs{100};
+};
+
+// All events of one path since the previous batch
+struct WatchChange {
+  std::string path;
+  uint32_t events;
+  bool isDirectory;
+};
+
+// Called on the watcher thread
+using WatchCallback = std::function<void(std::vector<WatchChange>&& changes)>;
+
+// Watches a directory with inotify on its own thread. Events are merged per path and
+// delivered once the directory has been quiet for debounceMs (or at least once a second
+// during a long burst), so a bulk copy ends up in a few batches.
+class DirWatcher {
+public:
+  DirWatcher(const std::string& path, const WatchOptions& options, WatchCallback callback);
+  ~DirWatcher();
+
+  DirWatcher(const DirWatcher&) = delete;
+  DirWatcher& operator=(const DirWatcher&) = delete;
+
+  static bool isSupported();
+
+private:
+  void run();
+
+private:
+  struct State;
+  std::unique_ptr<State> state;
+  std::thread thread;
+};
+
+}
@@ -0,0 +1,163 @@
+//
+//  du-utils.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <mutex>
+#include <set>
+#include <sys/stat.h>
+#include "dir-traversal.h"
+#include "du-utils.h"
+
+namespace cmpayc::rnfsturbo {
+
+std::optional<DiskUsageMode> parseDiskUsageMode(std::string_view mode) {
+  if (mode == "apparent") {
+    return DiskUsageMode::Apparent;
+  }
+  if (mode == "allocated") {
+    return DiskUsageMode::Allocated;
+  }
+  return std::nullopt;
+}
+
+namespace {
+
+// Totals are kept per worker and per top level child (DirTask::tag) and summed up at the end,
+// so workers only share the hardlink set
+class DiskUsageWalker : public DirTraversal {
+public:
+  DiskUsageWalker(DiskUsageMode mode) : mode(mode), workerTotals(workers()) {}
+
+  DiskUsage measure(const std::string& path, bool perChild) {
+    DiskUsage result;
+    struct stat rootStat;
+    if (lstat(path.c_str(), &rootStat) != 0) {
+      throw strerror(errno);
+    }
+    result.size = sizeOf(rootStat);
+    if (!S_ISDIR(rootStat.st_mode)) {
+      result.files = 1;
+      return result;
+    }
+
+    // The top level is read here so every subtree can be tagged with its child
+    int dirFd = open(path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+      throw strerror(errno);
+    }
+    std::string childPath = path;
+    if (childPath.back() != '/') {
+      childPath.push_back('/');
+    }
+    size_t nameOffset = childPath.size();
+    std::vector<uint64_t> childSizes;
+    readDirectoryEntries(dirFd, [&](const char* name, unsigned char type) {
+      struct stat st;
+      if (fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+        return;
+      }
+      uint32_t tag = static_cast<uint32_t>(result.children.size());
+      result.children.push_back({name, 0});
+      childSizes.push_back(countEntry(st) ? sizeOf(st) : 0);
+      if (S_ISDIR(st.st_mode)) {
+        childPath.resize(nameOffset);
+        childPath.append(name);
+        pushDirectory(tag, {childPath, 1, tag});
+      } else if (!S_ISLNK(st.st_mode)) {
+        result.files++;
+      }
+    });
+    close(dirFd);
+
+    for (WorkerTotals& totals : workerTotals) {
+      totals.children.assign(result.children.size(), 0);
+    }
+    run();
+
+    for (size_t i = 0; i < result.children.size(); i++) {
+      for (const WorkerTotals& totals : workerTotals) {
+        childSizes[i] += totals.children[i];
+      }
+      result.children[i].size = childSizes[i];
+      result.size += childSizes[i];
+    }
+    for (const WorkerTotals& totals : workerTotals) {
+      result.files += totals.files;
+    }
+    if (!perChild) {
+      result.children.clear();
+    }
+    return result;
+  }
+
+protected:
+  void visitDirectory(size_t worker, const DirTask& dir) override {
+    int dirFd = open(dir.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+      return;
+    }
+    WorkerTotals& totals = workerTotals[worker];
+    std::string childPath;
+    readDirectoryEntries(dirFd, [&](const char* name, unsigned char type) {
+      struct stat st;
+      if (fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+        return;
+      }
+      if (countEntry(st)) {
+        totals.children[dir.tag] += sizeOf(st);
+      }
+      if (S_ISDIR(st.st_mode)) {
+        childPath.assign(dir.path).push_back('/');
+        childPath.append(name);
+        pushDirectory(worker, {childPath, dir.depth + 1, dir.tag});
+      } else if (!S_ISLNK(st.st_mode)) {
+        totals.files++;
+      }
+    });
+    close(dirFd);
+  }
+
+private:
+  uint64_t sizeOf(const struct stat& st) const {
+    if (mode == DiskUsageMode::Allocated) {
+      // st_blocks is always in 512 byte units, whatever the filesystem block size is
+      return static_cast<uint64_t>(st.st_blocks) * 512;
+    }
+    return S_ISDIR(st.st_mode) ? 0 : static_cast<uint64_t>(st.st_size);
+  }
+
+  // False for the second and later links of a hardlinked file
+  bool countEntry(const struct stat& st) {
+    if (S_ISDIR(st.st_mode) || st.st_nlink <= 1) {
+      return true;
+    }
+    std::lock_guard<std::mutex> lock(hardlinksMutex);
+    return hardlinks.emplace(st.st_dev, st.st_ino).second;
+  }
+
+private:
+  struct WorkerTotals {
+    std::vector<uint64_t> children;
+    uint64_t files{0};
+  };
+
+  DiskUsageMode mode;
+  std::vector<WorkerTotals> workerTotals;
+  std::mutex hardlinksMutex;
+  std::set<std::pair<dev_t, ino_t>> hardlinks;
+};
+
+}
+
+DiskUsage diskUsage(const std::string& path, DiskUsageMode mode, bool perChild) {
+  DiskUsageWalker walker(mode);
+  return walker.measure(path, perChild);
+}
+
+}
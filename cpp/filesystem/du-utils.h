@@ -0,0 +1,39 @@
+//
+//  du-utils.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+enum class DiskUsageMode : uint8_t {
+  Apparent, // Sum of file sizes
+  Allocated, // Blocks actually taken on disk, directories included
+};
+
+std::optional<DiskUsageMode> parseDiskUsageMode(std::string_view mode);
+
+struct DiskUsageChild {
+  std::string name;
+  uint64_t size;
+};
+
+struct DiskUsage {
+  uint64_t size{0};
+  uint64_t files{0};
+  std::vector<DiskUsageChild> children; // Only filled with perChild
+};
+
+// Hardlinked files are counted once, symlinks are not followed
+DiskUsage diskUsage(const std::string& path, DiskUsageMode mode, bool perChild);
+
+}
@@ -5,10 +5,31 @@
 //  Created by Sergei Kazakov on 16.09.24.
 //
 
+#include <cmath>
+#include <cstring>
 #include "filesystem-utils.h"
 
 namespace cmpayc::rnfsturbo {
 
+std::optional<Encoding> parseEncoding(std::string_view encoding) {
+  if (encoding == "utf8") {
+    return Encoding::Utf8;
+  } else if (encoding == "base64") {
+    return Encoding::Base64;
+  } else if (encoding == "uint8") {
+    return Encoding::Uint8;
+  } else if (encoding == "uint16") {
+    return Encoding::Uint16;
+  } else if (encoding == "uint32") {
+    return Encoding::Uint32;
+  } else if (encoding == "float32") {
+    return Encoding::Float32;
+  } else if (encoding == "ascii") {
+    return Encoding::Ascii;
+  }
+  return std::nullopt;
+}
+
 std::string readFile(const char* filePath, int offset, int length) {
   std::ifstream inputFile(filePath, std::ios::binary);
   if (!inputFile.is_open()) {
@@ -83,15 +104,15 @@ std::vector<T> readFileUint(const char* filePath, int offset, int length) {
   return vBuffer;
 }
 
-FileBuffer readFileUintUniversal(const std::string& encoding, const char* filePath, int offset, int length) {
-  if (encoding == "uint8") {
+FileBuffer readFileUintUniversal(Encoding encoding, const char* filePath, int offset, int length) {
+  if (encoding == Encoding::Uint8) {
     return readFileUint<uint8_t>(filePath, offset, length);
-  } else if (encoding == "uint16") {
+  } else if (encoding == Encoding::Uint16) {
     return readFileUint<uint16_t>(filePath, offset, length);
-  } else if (encoding == "uint32") {
+  } else if (encoding == Encoding::Uint32) {
     return readFileUint<uint32_t>(filePath, offset, length);
   } else {
-    throw std::invalid_argument("Unsupported encoding: " + encoding);
+    throw std::invalid_argument("Unsupported encoding");
   }
 }
 
@@ -161,7 +182,7 @@ void writeFileUint(const char* filePath, const T *contentUint, size_t length, bo
 }
 
 void writeFileUintUniversal(
-  const std::string& encoding,
+  Encoding encoding,
   const char* filePath,
   const uint8_t *contentUint8,
   const uint16_t *contentUint16,
@@ -169,14 +190,14 @@ void writeFileUintUniversal(
   size_t length,
   bool isAppend
 ) {
-  if (encoding == "uint8") {
+  if (encoding == Encoding::Uint8) {
     return writeFileUint<uint8_t>(filePath, contentUint8, length, isAppend);
-  } else if (encoding == "uint16") {
+  } else if (encoding == Encoding::Uint16) {
     return writeFileUint<uint16_t>(filePath, contentUint16, length, isAppend);
-  } else if (encoding == "uint32") {
+  } else if (encoding == Encoding::Uint32) {
     return writeFileUint<uint32_t>(filePath, contentUint32, length, isAppend);
   } else {
-    throw std::invalid_argument("Unsupported encoding: " + encoding);
+    throw std::invalid_argument("Unsupported encoding");
   }
 }
 
@@ -209,11 +230,10 @@ void writeWithOffset(const char* filePath, std::string_view content, int offset)
 }
 
 std::string cleanPath(std::string filePath) {
-  return std::regex_replace(
-    filePath,
-    std::regex("^file://"),
-    ""
-  );
+  if (filePath.compare(0, 7, "file://") == 0) {
+    filePath.erase(0, 7);
+  }
+  return filePath;
 }
 
 }
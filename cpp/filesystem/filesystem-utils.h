@@ -9,12 +9,23 @@
 
 #include <fstream>
 #include <iostream>
-#include <regex>
+#include <optional>
+#include <string_view>
 #include <vector>
 #include <variant>
 
 namespace cmpayc::rnfsturbo {
 
+enum class Encoding : uint8_t {
+  Utf8,
+  Ascii,
+  Base64,
+  Uint8,
+  Uint16,
+  Uint32,
+  Float32,
+};
+
 using FileBuffer = std::variant<
     std::vector<uint8_t>,
     std::vector<uint16_t>,
@@ -46,12 +57,18 @@ T fromBigEndian(T value) {
   }
 }
 
+std::optional<Encoding> parseEncoding(std::string_view encoding);
+
+inline bool isNumericEncoding(Encoding encoding) {
+  return encoding == Encoding::Uint8 || encoding == Encoding::Uint16 || encoding == Encoding::Uint32 || encoding == Encoding::Float32;
+}
+
 std::string readFile(const char* filePath, int offset, int length);
 
 template <typename T>
 std::vector<T> readFileUint(const char* filePath, int offset, int length);
 
-FileBuffer readFileUintUniversal(const std::string& encoding, const char* filePath, int offset, int length);
+FileBuffer readFileUintUniversal(Encoding encoding, const char* filePath, int offset, int length);
 
 std::vector<float> readFileFloat32(const char* filePath, int offset, int length);
 
@@ -61,7 +78,7 @@ template <typename T>
 void writeFileUint(const char* filePath, const T *contentUint, size_t length, bool isAppend);
 
 void writeFileUintUniversal(
-  const std::string& encoding,
+  Encoding encoding,
   const char* filePath,
   const uint8_t *contentUint8,
   const uint16_t *contentUint16,
@@ -0,0 +1,302 @@
+//
+//  glob-matcher.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include "glob-matcher.h"
+
+namespace cmpayc::rnfsturbo {
+
+// Position of the `}` closing the brace at `open`, or npos
+static size_t findClosingBrace(std::string_view pattern, size_t open) {
+  int depth = 0;
+  for (size_t i = open; i < pattern.size(); i++) {
+    if (pattern[i] == '\\') {
+      i++;
+    } else if (pattern[i] == '{') {
+      depth++;
+    } else if (pattern[i] == '}' && --depth == 0) {
+      return i;
+    }
+  }
+  return std::string_view::npos;
+}
+
+// `a{b,c{d,e}}` -> `ab`, `acd`, `ace`
+static void expandBraces(std::string_view pattern, std::vector<std::string>& result) {
+  for (size_t i = 0; i < pattern.size(); i++) {
+    if (pattern[i] == '\\') {
+      i++;
+      continue;
+    }
+    if (pattern[i] != '{') {
+      continue;
+    }
+    size_t close = findClosingBrace(pattern, i);
+    if (close == std::string_view::npos) {
+      break;
+    }
+    std::vector<std::string_view> alternatives;
+    int depth = 0;
+    size_t start = i + 1;
+    for (size_t j = i + 1; j < close; j++) {
+      if (pattern[j] == '\\') {
+        j++;
+      } else if (pattern[j] == '{') {
+        depth++;
+      } else if (pattern[j] == '}') {
+        depth--;
+      } else if (pattern[j] == ',' && depth == 0) {
+        alternatives.push_back(pattern.substr(start, j - start));
+        start = j + 1;
+      }
+    }
+    if (alternatives.empty()) {
+      // `{abc}` without a comma is a literal
+      i = close;
+      continue;
+    }
+    alternatives.push_back(pattern.substr(start, close - start));
+    std::string_view prefix = pattern.substr(0, i);
+    std::string_view suffix = pattern.substr(close + 1);
+    for (std::string_view alternative : alternatives) {
+      std::string expanded;
+      expanded.reserve(prefix.size() + alternative.size() + suffix.size());
+      expanded.append(prefix).append(alternative).append(suffix);
+      expandBraces(expanded, result);
+    }
+    return;
+  }
+  result.emplace_back(pattern);
+}
+
+GlobMatcher::GlobMatcher(std::string_view pattern) {
+  if (pattern.empty()) {
+    return;
+  }
+  nameOnly = pattern.find('/') == std::string_view::npos;
+  std::vector<std::string> expanded;
+  expandBraces(pattern, expanded);
+  patterns.reserve(expanded.size());
+  for (const std::string& item : expanded) {
+    patterns.push_back(compile(item));
+  }
+}
+
+GlobMatcher::Pattern GlobMatcher::compile(std::string_view pattern) {
+  Pattern result;
+  size_t start = 0;
+  while (start <= pattern.size()) {
+    size_t end = pattern.find('/', start);
+    if (end == std::string_view::npos) {
+      end = pattern.size();
+    }
+    std::string_view part = pattern.substr(start, end - start);
+    start = end + 1;
+    if (part.empty()) {
+      continue;
+    }
+
+    Segment segment;
+    if (part == "**") {
+      segment.globstar = true;
+      result.push_back(std::move(segment));
+      continue;
+    }
+    for (size_t i = 0; i < part.size(); i++) {
+      char c = part[i];
+      if (c == '*') {
+        if (segment.tokens.empty() || segment.tokens.back().kind != Token::Kind::Star) {
+          segment.tokens.push_back({Token::Kind::Star, {}, {}});
+        }
+        continue;
+      }
+      if (c == '?') {
+        segment.tokens.push_back({Token::Kind::AnyChar, {}, {}});
+        continue;
+      }
+      if (c == '[') {
+        size_t j = i + 1;
+        bool negated = j < part.size() && (part[j] == '!' || part[j] == '^');
+        if (negated) {
+          j++;
+        }
+        size_t classStart = j;
+        // `]` right after `[` or `[!` is a member of the class
+        if (j < part.size() && part[j] == ']') {
+          j++;
+        }
+        while (j < part.size() && part[j] != ']') {
+          j++;
+        }
+        if (j < part.size()) {
+          Token token{Token::Kind::Class, {}, {}};
+          for (size_t k = classStart; k < j; k++) {
+            unsigned char from = part[k];
+            if (k + 2 < j && part[k + 1] == '-') {
+              unsigned char to = part[k + 2];
+              for (unsigned int ch = from; ch <= to; ch++) {
+                token.chars.set(ch);
+              }
+              k += 2;
+            } else {
+              token.chars.set(from);
+            }
+          }
+          if (negated) {
+            token.chars.flip();
+          }
+          segment.tokens.push_back(std::move(token));
+          i = j;
+          continue;
+        }
+      }
+      if (c == '\\' && i + 1 < part.size()) {
+        c = part[++i];
+      }
+      if (segment.tokens.empty() || segment.tokens.back().kind != Token::Kind::Literal) {
+        segment.tokens.push_back({Token::Kind::Literal, {}, {}});
+      }
+      segment.tokens.back().literal.push_back(c);
+    }
+    result.push_back(std::move(segment));
+  }
+  return result;
+}
+
+bool GlobMatcher::matchSegment(const std::vector<Token>& tokens, std::string_view text) {
+  size_t token = 0;
+  size_t pos = 0;
+  size_t starToken = std::string_view::npos;
+  size_t starPos = 0;
+  while (pos < text.size() || token < tokens.size()) {
+    if (token < tokens.size()) {
+      const Token& current = tokens[token];
+      bool matched{false};
+      switch (current.kind) {
+        case Token::Kind::Star:
+          starToken = token++;
+          starPos = pos;
+          continue;
+        case Token::Kind::Literal:
+          matched = text.compare(pos, current.literal.size(), current.literal) == 0;
+          if (matched) {
+            pos += current.literal.size();
+          }
+          break;
+        case Token::Kind::AnyChar:
+          matched = pos < text.size();
+          if (matched) {
+            pos++;
+          }
+          break;
+        case Token::Kind::Class:
+          matched = pos < text.size() && current.chars.test(static_cast<unsigned char>(text[pos]));
+          if (matched) {
+            pos++;
+          }
+          break;
+      }
+      if (matched) {
+        token++;
+        continue;
+      }
+    }
+    // Let the last `*` swallow one more character and retry
+    if (starToken != std::string_view::npos && starPos < text.size()) {
+      pos = ++starPos;
+      token = starToken + 1;
+      continue;
+    }
+    return false;
+  }
+  return true;
+}
+
+bool GlobMatcher::matchPath(const Pattern& pattern, size_t segment, const std::vector<std::string_view>& parts, size_t part) {
+  if (segment == pattern.size()) {
+    return part == parts.size();
+  }
+  if (pattern[segment].globstar) {
+    for (size_t next = part; next <= parts.size(); next++) {
+      if (matchPath(pattern, segment + 1, parts, next)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  if (part == parts.size()) {
+    return false;
+  }
+  return matchSegment(pattern[segment].tokens, parts[part]) && matchPath(pattern, segment + 1, parts, part + 1);
+}
+
+static std::vector<std::string_view> splitPath(std::string_view path) {
+  std::vector<std::string_view> parts;
+  size_t start = 0;
+  while (start < path.size()) {
+    size_t end = path.find('/', start);
+    if (end == std::string_view::npos) {
+      end = path.size();
+    }
+    if (end > start) {
+      parts.push_back(path.substr(start, end - start));
+    }
+    start = end + 1;
+  }
+  return parts;
+}
+
+bool GlobMatcher::matches(std::string_view relativePath, std::string_view name) const {
+  if (patterns.empty()) {
+    return true;
+  }
+  if (nameOnly) {
+    for (const Pattern& pattern : patterns) {
+      if (pattern.size() == 1 && matchSegment(pattern[0].tokens, name)) {
+        return true;
+      }
+    }
+    return false;
+  }
+  std::vector<std::string_view> parts = splitPath(relativePath);
+  for (const Pattern& pattern : patterns) {
+    if (matchPath(pattern, 0, parts, 0)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool GlobMatcher::couldMatchBelow(std::string_view relativeDir) const {
+  if (patterns.empty() || nameOnly) {
+    return true;
+  }
+  std::vector<std::string_view> parts = splitPath(relativeDir);
+  for (const Pattern& pattern : patterns) {
+    size_t segment = 0;
+    bool possible{true};
+    for (std::string_view part : parts) {
+      if (segment == pattern.size()) {
+        possible = false;
+        break;
+      }
+      if (pattern[segment].globstar) {
+        break;
+      }
+      if (!matchSegment(pattern[segment].tokens, part)) {
+        possible = false;
+        break;
+      }
+      segment++;
+    }
+    if (possible && (segment < pattern.size())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}
@@ -0,0 +1,62 @@
+//
+//  glob-matcher.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <bitset>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+// Glob pattern compiled once and matched against many paths.
+// Supports `*`, `?`, `[abc]`, `[!a-z]`, `{a,b}` and `**` as a whole path segment.
+// A pattern without `/` is matched against the item name only (like `find -name`),
+// otherwise against the path relative to the walk root.
+class GlobMatcher {
+public:
+  GlobMatcher() = default;
+  explicit GlobMatcher(std::string_view pattern);
+
+  bool empty() const {
+    return patterns.empty();
+  }
+
+  bool matchesNameOnly() const {
+    return nameOnly;
+  }
+
+  bool matches(std::string_view relativePath, std::string_view name) const;
+
+  // False when nothing below the directory `relativeDir` can match, so the walk can skip it
+  bool couldMatchBelow(std::string_view relativeDir) const;
+
+private:
+  struct Token {
+    enum class Kind : uint8_t { Literal, AnyChar, Star, Class };
+    Kind kind;
+    std::string literal;
+    std::bitset<256> chars;
+  };
+  // Tokens of a single path segment, an empty vector with `globstar` set stands for `**`
+  struct Segment {
+    bool globstar{false};
+    std::vector<Token> tokens;
+  };
+  using Pattern = std::vector<Segment>;
+
+  static Pattern compile(std::string_view pattern);
+  static bool matchSegment(const std::vector<Token>& tokens, std::string_view text);
+  static bool matchPath(const Pattern& pattern, size_t segment, const std::vector<std::string_view>& parts, size_t part);
+
+private:
+  std::vector<Pattern> patterns;
+  bool nameOnly{false};
+};
+
+}
@@ -0,0 +1,243 @@
+//
+//  hash-utils.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "../algorithms/blake3.h"
+#include "../algorithms/hmac-sha256.h"
+#include "hash-utils.h"
+#include "unique-fd.h"
+#include "worker-pool.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kHashChunkSize = 256 * 1024;
+// 1024 chunks, a power of two as the tree needs. Each worker gets at least a few of them,
+// smaller ranges are hashed sequentially
+static constexpr size_t kBlake3SubtreeSize = 1024 * kBlake3ChunkLen;
+static constexpr size_t kMinBlake3SubtreesPerWorker = 4;
+// Part of the file read at once by buildChunkManifest
+static constexpr size_t kManifestWindowSize = 8 * 1024 * 1024;
+
+// Fills buffer from position, stops early only at the end of the file. Returns the bytes read
+static size_t preadFully(int fd, uint8_t* buffer, size_t length, uint64_t position) {
+  size_t total = 0;
+  while (total < length) {
+    ssize_t bytesRead = pread(fd, buffer + total, length - total, static_cast<off_t>(position + total));
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    if (bytesRead == 0) {
+      break;
+    }
+    total += bytesRead;
+  }
+  return total;
+}
+
+static void hashFd(int fd, Hasher& hasher, uint64_t offset, uint64_t length) {
+#ifdef POSIX_FADV_SEQUENTIAL
+  posix_fadvise(fd, static_cast<off_t>(offset), static_cast<off_t>(length), POSIX_FADV_SEQUENTIAL);
+#endif
+  std::vector<uint8_t> buffer(kHashChunkSize);
+  uint64_t remaining = length == 0 ? UINT64_MAX : length;
+  while (remaining > 0) {
+    size_t bytesRead = preadFully(fd, buffer.data(), std::min<uint64_t>(buffer.size(), remaining), offset);
+    if (bytesRead == 0) {
+      return;
+    }
+    hasher.update(buffer.data(), bytesRead);
+    offset += bytesRead;
+    remaining -= bytesRead;
+  }
+}
+
+static UniqueFd openForHashing(const std::string& path) {
+  UniqueFd fd(open(path.c_str(), O_RDONLY | O_CLOEXEC));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  return fd;
+}
+
+static uint64_t fileSizeOf(int fd) {
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    throw strerror(errno);
+  }
+  return static_cast<uint64_t>(st.st_size);
+}
+
+void hashFile(const std::string& path, Hasher& hasher, uint64_t offset, uint64_t length) {
+  UniqueFd fd = openForHashing(path);
+  hashFd(fd.get(), hasher, offset, length);
+}
+
+std::string hashFileBlake3(const std::string& path, uint64_t offset, uint64_t length) {
+  UniqueFd fd = openForHashing(path);
+  uint64_t fileSize = fileSizeOf(fd.get());
+  uint64_t rangeSize = offset < fileSize ? fileSize - offset : 0;
+  if (length != 0) {
+    rangeSize = std::min(rangeSize, length);
+  }
+  std::unique_ptr<Hasher> sequential = Hasher::create("blake3");
+  if (rangeSize == 0) {
+    return sequential->hexDigest();
+  }
+
+  uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  uint64_t alignedOffset = offset - offset % pageSize;
+  uint64_t mappedLength = rangeSize + (offset - alignedOffset);
+  if (rangeSize < 2 * kMinBlake3SubtreesPerWorker * kBlake3SubtreeSize || mappedLength > SIZE_MAX) {
+    hashFd(fd.get(), *sequential, offset, rangeSize);
+    return sequential->hexDigest();
+  }
+  void* mapped = mmap(nullptr, static_cast<size_t>(mappedLength), PROT_READ, MAP_PRIVATE, fd.get(), static_cast<off_t>(alignedOffset));
+  if (mapped == MAP_FAILED) {
+    // Not enough address space on 32-bit devices
+    hashFd(fd.get(), *sequential, offset, rangeSize);
+    return sequential->hexDigest();
+  }
+  madvise(mapped, static_cast<size_t>(mappedLength), MADV_SEQUENTIAL);
+  const uint8_t* data = static_cast<const uint8_t*>(mapped) + (offset - alignedOffset);
+  size_t size = static_cast<size_t>(rangeSize);
+
+  size_t subtrees = (size + kBlake3SubtreeSize - 1) / kBlake3SubtreeSize;
+  std::vector<uint8_t> cvs(subtrees * kBlake3OutLen);
+  try {
+    parallelFor(subtrees, kMinBlake3SubtreesPerWorker, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        size_t subtreeOffset = i * kBlake3SubtreeSize;
+        blake3SubtreeCv(
+          data + subtreeOffset,
+          std::min(kBlake3SubtreeSize, size - subtreeOffset),
+          static_cast<uint64_t>(subtreeOffset / kBlake3ChunkLen),
+          cvs.data() + i * kBlake3OutLen
+        );
+      }
+    }, computeWorkerCount());
+  } catch (...) {
+    munmap(mapped, static_cast<size_t>(mappedLength));
+    throw;
+  }
+  munmap(mapped, static_cast<size_t>(mappedLength));
+
+  uint8_t digest[kBlake3OutLen];
+  blake3RootFromSubtrees(cvs.data(), subtrees, digest);
+  return toHex(digest, kBlake3OutLen);
+}
+
+ChunkManifest buildChunkManifest(const std::string& path, const std::string& algorithm, uint64_t chunkSize) {
+  std::unique_ptr<Hasher> fileHasher = Hasher::create(algorithm);
+  if (fileHasher == nullptr) {
+    throw "Wrong algorithm";
+  }
+  UniqueFd fd = openForHashing(path);
+  uint64_t fileSize = fileSizeOf(fd.get());
+#ifdef POSIX_FADV_SEQUENTIAL
+  posix_fadvise(fd.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+
+  ChunkManifest manifest;
+  manifest.size = fileSize;
+  manifest.digestSize = fileHasher->digestSize();
+  uint64_t chunkCount = (fileSize + chunkSize - 1) / chunkSize;
+  manifest.chunkDigests.resize(static_cast<size_t>(chunkCount) * manifest.digestSize);
+
+  // Part of one chunk inside the window, pieces of the same chunk are fed to its hasher window after window
+  struct Piece {
+    uint64_t chunk;
+    size_t begin;
+    size_t end;
+    bool completesChunk;
+    std::unique_ptr<Hasher> hasher;
+  };
+  std::unique_ptr<Hasher> openChunkHasher;
+  std::vector<uint8_t> window(static_cast<size_t>(std::min<uint64_t>(kManifestWindowSize, fileSize)));
+  // The file digest can only be computed front to back, so it gets a worker of its own
+  // and the chunks are spread over the others
+  size_t workers = computeWorkerCount();
+  size_t chunkWorkers = std::max<size_t>(workers - 1, 1);
+  size_t firstChunkWorker = workers - chunkWorkers;
+
+  for (uint64_t windowStart = 0; windowStart < fileSize; windowStart += window.size()) {
+    size_t windowLength = static_cast<size_t>(std::min<uint64_t>(window.size(), fileSize - windowStart));
+    if (preadFully(fd.get(), window.data(), windowLength, windowStart) != windowLength) {
+      throw "File was truncated while hashing";
+    }
+
+    std::vector<Piece> pieces;
+    for (size_t position = 0; position < windowLength;) {
+      uint64_t chunk = (windowStart + position) / chunkSize;
+      uint64_t chunkEnd = std::min((chunk + 1) * chunkSize, fileSize);
+      size_t end = static_cast<size_t>(std::min<uint64_t>(windowLength, chunkEnd - windowStart));
+      std::unique_ptr<Hasher> hasher = openChunkHasher != nullptr ? std::move(openChunkHasher) : Hasher::create(algorithm);
+      pieces.push_back({chunk, position, end, windowStart + end == chunkEnd, std::move(hasher)});
+      position = end;
+    }
+
+    parallelFor(workers, 1, [&](size_t begin, size_t end) {
+      for (size_t worker = begin; worker < end; worker++) {
+        if (worker == 0) {
+          fileHasher->update(window.data(), windowLength);
+        }
+        if (worker < firstChunkWorker) {
+          continue;
+        }
+        for (size_t i = worker - firstChunkWorker; i < pieces.size(); i += chunkWorkers) {
+          Piece& piece = pieces[i];
+          piece.hasher->update(window.data() + piece.begin, piece.end - piece.begin);
+          if (piece.completesChunk) {
+            piece.hasher->digest(manifest.chunkDigests.data() + piece.chunk * manifest.digestSize);
+          }
+        }
+      }
+    }, workers);
+    if (!pieces.back().completesChunk) {
+      openChunkHasher = std::move(pieces.back().hasher);
+    }
+  }
+
+  manifest.fileDigest.resize(manifest.digestSize);
+  fileHasher->digest(manifest.fileDigest.data());
+  return manifest;
+}
+
+bool verifyFileHmac(
+  const std::string& path,
+  const std::string& algorithm,
+  const std::vector<uint8_t>& key,
+  const std::vector<uint8_t>& expected,
+  int64_t expectedFileSize
+) {
+  std::unique_ptr<Hasher> hmac = Hasher::createHmac(algorithm, key.data(), key.size());
+  if (hmac == nullptr) {
+    throw "Wrong algorithm";
+  }
+  if (expected.size() != hmac->digestSize()) {
+    return false;
+  }
+  UniqueFd fd = openForHashing(path);
+  if (expectedFileSize >= 0 && fileSizeOf(fd.get()) != static_cast<uint64_t>(expectedFileSize)) {
+    return false;
+  }
+  hashFd(fd.get(), *hmac, 0, 0);
+  std::vector<uint8_t> actual(hmac->digestSize());
+  hmac->digest(actual.data());
+  return constantTimeEquals(actual.data(), expected.data(), actual.size());
+}
+
+}
@@ -0,0 +1,50 @@
+//
+//  hash-utils.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../algorithms/hasher.h"
+
+namespace cmpayc::rnfsturbo {
+
+// Feeds [offset, offset + length) of the file to hasher in 256 KB chunks, length 0 means up to the end.
+// Memory use doesn't depend on the file size
+void hashFile(const std::string& path, Hasher& hasher, uint64_t offset = 0, uint64_t length = 0);
+
+// BLAKE3 digest of [offset, offset + length) of the file as lowercase hex, length 0 means up to the end.
+// Larger ranges are mapped and split into aligned subtrees of 1 MB, which are hashed on all workers
+// and joined at the end.
+std::string hashFileBlake3(const std::string& path, uint64_t offset = 0, uint64_t length = 0);
+
+struct ChunkManifest {
+  uint64_t size;
+  size_t digestSize;
+  std::vector<uint8_t> fileDigest;
+  // Raw digests of the chunks back to back, the last chunk may be shorter. Empty for an empty file
+  std::vector<uint8_t> chunkDigests;
+};
+
+// Digests of every chunkSize bytes of the file and of the whole file, in one pass over it. The file is
+// read in 8 MB windows, the chunks of a window are hashed on the workers next to the file digest.
+// Throws for an unknown algorithm.
+ChunkManifest buildChunkManifest(const std::string& path, const std::string& algorithm, uint64_t chunkSize);
+
+// Computes the HMAC of the file and compares it with expected in constant time. A wrong expected
+// size for the algorithm, or a file size other than expectedFileSize (when >= 0), returns false
+// without reading the file. Throws for an unknown algorithm.
+bool verifyFileHmac(
+  const std::string& path,
+  const std::string& algorithm,
+  const std::vector<uint8_t>& key,
+  const std::vector<uint8_t>& expected,
+  int64_t expectedFileSize
+);
+
+}
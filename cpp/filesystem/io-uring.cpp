@@ -0,0 +1,173 @@
+//
+//  io-uring.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include "io-uring.h"
+
+#ifdef RNFSTURBO_HAS_IO_URING
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+// Set once setup or a probe failed, io_uring won't start working later in the process
+static std::atomic<bool> ioUringUnavailable{false};
+
+static int ioUringSetup(unsigned entries, io_uring_params* params) {
+  return static_cast<int>(syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int ioUringEnter(int fd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+  return static_cast<int>(syscall(__NR_io_uring_enter, fd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+static int ioUringRegister(int fd, unsigned opcode, void* arg, unsigned count) {
+  return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+IoUring::~IoUring() {
+  if (sqes != nullptr) {
+    munmap(sqes, sqesSize);
+  }
+  if (cqRing != nullptr && cqRing != sqRing) {
+    munmap(cqRing, cqRingSize);
+  }
+  if (sqRing != nullptr) {
+    munmap(sqRing, sqRingSize);
+  }
+  if (ringFd >= 0) {
+    close(ringFd);
+  }
+}
+
+bool IoUring::init(unsigned entries) {
+  io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  ringFd = ioUringSetup(entries, &params);
+  if (ringFd < 0) {
+    return false;
+  }
+  sqEntries = params.sq_entries;
+  sqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  cqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  bool singleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+  if (singleMmap) {
+    sqRingSize = cqRingSize = std::max(sqRingSize, cqRingSize);
+  }
+  sqRing = mmap(nullptr, sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQ_RING);
+  if (sqRing == MAP_FAILED) {
+    sqRing = nullptr;
+    return false;
+  }
+  if (singleMmap) {
+    cqRing = sqRing;
+  } else {
+    cqRing = mmap(nullptr, cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_CQ_RING);
+    if (cqRing == MAP_FAILED) {
+      cqRing = nullptr;
+      return false;
+    }
+  }
+  sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+  void* sqesMap = mmap(nullptr, sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ringFd, IORING_OFF_SQES);
+  if (sqesMap == MAP_FAILED) {
+    return false;
+  }
+  sqes = static_cast<io_uring_sqe*>(sqesMap);
+
+  char* sq = static_cast<char*>(sqRing);
+  sqHead = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+  sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+  sqMask = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+  sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+  char* cq = static_cast<char*>(cqRing);
+  cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+  cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+  cqMask = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+  cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+  sqeTail = *sqTail;
+  return true;
+}
+
+std::unique_ptr<IoUring> IoUring::create(unsigned entries, uint8_t opcode) {
+  if (ioUringUnavailable.load(std::memory_order_relaxed)) {
+    return nullptr;
+  }
+  std::unique_ptr<IoUring> ring(new IoUring());
+  if (!ring->init(entries)) {
+    // ENOSYS on old kernels, EPERM/EACCES where it is blocked
+    if (ring->ringFd < 0) {
+      ioUringUnavailable.store(true, std::memory_order_relaxed);
+    }
+    return nullptr;
+  }
+  // Kernels before 5.6 can't probe and don't have the file opcodes anyway
+  size_t probeSize = sizeof(io_uring_probe) + 256 * sizeof(io_uring_probe_op);
+  std::vector<uint8_t> probeBuffer(probeSize, 0);
+  auto* probe = reinterpret_cast<io_uring_probe*>(probeBuffer.data());
+  if (ioUringRegister(ring->ringFd, IORING_REGISTER_PROBE, probe, 256) < 0 || opcode > probe->last_op ||
+      (probe->ops[opcode].flags & IO_URING_OP_SUPPORTED) == 0) {
+    ioUringUnavailable.store(true, std::memory_order_relaxed);
+    return nullptr;
+  }
+  return ring;
+}
+
+io_uring_sqe* IoUring::nextSqe() {
+  unsigned head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+  if (sqeTail - head >= sqEntries) {
+    return nullptr;
+  }
+  unsigned index = sqeTail & *sqMask;
+  io_uring_sqe* sqe = &sqes[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqArray[index] = index;
+  sqeTail++;
+  pending++;
+  return sqe;
+}
+
+int IoUring::submitAndWait(unsigned waitCount) {
+  __atomic_store_n(sqTail, sqeTail, __ATOMIC_RELEASE);
+  unsigned toSubmit = pending;
+  while (true) {
+    int res = ioUringEnter(ringFd, toSubmit, waitCount, waitCount > 0 ? IORING_ENTER_GETEVENTS : 0);
+    if (res >= 0) {
+      unsigned submitted = std::min<unsigned>(pending, static_cast<unsigned>(res));
+      pending -= submitted;
+      inFlight += submitted;
+      return 0;
+    }
+    if (errno != EINTR) {
+      return -errno;
+    }
+  }
+}
+
+void IoUring::waitForInFlight() {
+  // Entries that never reached the kernel stay unsubmitted, nothing submits them anymore
+  while (true) {
+    drainCompletions([](uint64_t, int) {});
+    if (inFlight == 0) {
+      return;
+    }
+    if (ioUringEnter(ringFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+      // Only possible with a broken ring fd, no completion can be waited for then
+      return;
+    }
+  }
+}
+
+}
+
+#endif
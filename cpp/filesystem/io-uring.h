@@ -0,0 +1,96 @@
+//
+//  io-uring.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+// Opt-in (RNFSTURBO_USE_IO_URING): on typical metadata batches the ring is slower than
+// direct syscalls, because the kernel hands statx/openat to its io-wq workers anyway
+#if defined(RNFSTURBO_USE_IO_URING) && defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define RNFSTURBO_HAS_IO_URING 1
+#endif
+
+#ifdef RNFSTURBO_HAS_IO_URING
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <linux/io_uring.h>
+#include <memory>
+
+namespace cmpayc::rnfsturbo {
+
+// Minimal io_uring ring on top of the raw syscalls (liburing isn't available on Android).
+// A ring is used by one thread at a time.
+class IoUring {
+public:
+  ~IoUring();
+  IoUring(const IoUring&) = delete;
+  IoUring& operator=(const IoUring&) = delete;
+
+  // Returns nullptr when io_uring can't be used: old kernel, blocked by seccomp/SELinux
+  // (Android apps) or `opcode` not supported. Failures are remembered, so later calls are cheap.
+  static std::unique_ptr<IoUring> create(unsigned entries, uint8_t opcode);
+
+  unsigned capacity() const {
+    return sqEntries;
+  }
+
+  // Next free submission entry, zeroed, or nullptr when the submission queue is full
+  io_uring_sqe* nextSqe();
+
+  // Submits the queued entries and waits until at least `waitCount` completions are available.
+  // Returns 0 or -errno.
+  int submitAndWait(unsigned waitCount);
+
+  // Calls onCompletion(userData, res) for every available completion, returns their number
+  template <typename OnCompletion>
+  unsigned drainCompletions(OnCompletion&& onCompletion) {
+    unsigned head = *cqHead;
+    unsigned tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+    unsigned count = 0;
+    for (; head != tail; head++, count++) {
+      const io_uring_cqe& cqe = cqes[head & *cqMask];
+      onCompletion(cqe.user_data, cqe.res);
+    }
+    __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    inFlight -= std::min(inFlight, count);
+    return count;
+  }
+
+  // Waits for every submitted entry and discards the completions, so the memory the entries point
+  // to can be released. Needed after a failed submitAndWait: closing the ring doesn't wait for them.
+  void waitForInFlight();
+
+private:
+  IoUring() = default;
+  bool init(unsigned entries);
+
+  int ringFd{-1};
+  unsigned sqEntries{0};
+  unsigned pending{0};
+  // Submitted to the kernel and not drained yet
+  unsigned inFlight{0};
+  void* sqRing{nullptr};
+  size_t sqRingSize{0};
+  void* cqRing{nullptr};
+  size_t cqRingSize{0};
+  io_uring_sqe* sqes{nullptr};
+  size_t sqesSize{0};
+  unsigned* sqHead{nullptr};
+  unsigned* sqTail{nullptr};
+  unsigned* sqMask{nullptr};
+  unsigned* sqArray{nullptr};
+  unsigned* cqHead{nullptr};
+  unsigned* cqTail{nullptr};
+  unsigned* cqMask{nullptr};
+  io_uring_cqe* cqes{nullptr};
+  unsigned sqeTail{0};
+};
+
+}
+
+#endif
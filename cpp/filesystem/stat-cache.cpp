@@ -0,0 +1,111 @@
+//
+//  stat-cache.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <errno.h>
+#include "stat-cache.h"
+
+namespace cmpayc::rnfsturbo {
+
+void StatCache::configure(bool isEnabled, size_t newMaxEntries) {
+  std::lock_guard<std::mutex> lock(mutex);
+  maxEntries = newMaxEntries > 0 ? newMaxEntries : kDefaultMaxEntries;
+  if (!isEnabled) {
+    index.clear();
+    entries.clear();
+    hits = 0;
+    misses = 0;
+    generation++;
+  }
+  while (entries.size() > maxEntries) {
+    evict(std::prev(entries.end()));
+  }
+  enabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+int StatCache::stat(const std::string& path, struct stat& st) {
+  if (!isEnabled()) {
+    return ::stat(path.c_str(), &st) == 0 ? 0 : errno;
+  }
+  uint64_t startGeneration;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    auto it = index.find(path);
+    if (it != index.end()) {
+      hits++;
+      entries.splice(entries.begin(), entries, it->second);
+      st = it->second->st;
+      return it->second->error;
+    }
+    misses++;
+    startGeneration = generation;
+  }
+
+  // The syscall runs unlocked, a concurrent miss on the same path just stores it once.
+  // A write invalidating the path meanwhile may not be in the result, so it isn't stored then.
+  int error = ::stat(path.c_str(), &st) == 0 ? 0 : errno;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!isEnabled() || generation != startGeneration || index.find(path) != index.end()) {
+    return error;
+  }
+  entries.push_front({path, error, st});
+  index.emplace(entries.front().path, entries.begin());
+  if (entries.size() > maxEntries) {
+    evict(std::prev(entries.end()));
+  }
+  return error;
+}
+
+void StatCache::evict(std::list<Entry>::iterator entry) {
+  index.erase(entry->path);
+  entries.erase(entry);
+}
+
+void StatCache::invalidate(std::string_view path) {
+  if (!isEnabled()) {
+    return;
+  }
+  while (path.size() > 1 && path.back() == '/') {
+    path.remove_suffix(1);
+  }
+  std::lock_guard<std::mutex> lock(mutex);
+  generation++;
+  if (entries.empty()) {
+    return;
+  }
+  size_t slash = path.rfind('/');
+  if (slash != std::string_view::npos) {
+    auto parent = index.find(path.substr(0, slash == 0 ? 1 : slash));
+    if (parent != index.end()) {
+      evict(parent->second);
+    }
+  }
+  // Everything starting with path follows it in the index, siblings like "path-2" are skipped
+  bool isRoot = path == "/";
+  for (auto it = index.lower_bound(path); it != index.end() && it->first.substr(0, path.size()) == path;) {
+    std::string_view cached = it->first;
+    auto entry = it->second;
+    ++it;
+    if (isRoot || cached.size() == path.size() || cached[path.size()] == '/') {
+      evict(entry);
+    }
+  }
+}
+
+void StatCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex);
+  index.clear();
+  entries.clear();
+  generation++;
+}
+
+StatCacheStats StatCache::stats() {
+  std::lock_guard<std::mutex> lock(mutex);
+  return {hits, misses, entries.size(), maxEntries};
+}
+
+}
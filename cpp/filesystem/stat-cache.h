@@ -0,0 +1,73 @@
+//
+//  stat-cache.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <sys/stat.h>
+
+namespace cmpayc::rnfsturbo {
+
+struct StatCacheStats {
+  uint64_t hits;
+  uint64_t misses;
+  size_t size;
+  size_t maxEntries;
+};
+
+// Opt-in LRU cache of stat() results, missing paths included, so repeated
+// exists/stat calls on the same paths don't go to the kernel.
+// Thread safe: it is invalidated from watcher and background job threads.
+class StatCache {
+public:
+  static constexpr size_t kDefaultMaxEntries = 1024;
+
+  void configure(bool enabled, size_t maxEntries);
+
+  bool isEnabled() const {
+    return enabled.load(std::memory_order_relaxed);
+  }
+
+  // stat() through the cache, returns 0 or the errno of the failed call
+  int stat(const std::string& path, struct stat& st);
+
+  // Drops the path, everything below it and its parent directory (its mtime changes too)
+  void invalidate(std::string_view path);
+  void clear();
+
+  StatCacheStats stats();
+
+private:
+  struct Entry {
+    std::string path;
+    int error;
+    struct stat st;
+  };
+
+  void evict(std::list<Entry>::iterator entry);
+
+private:
+  std::atomic<bool> enabled{false};
+  std::mutex mutex;
+  size_t maxEntries{kDefaultMaxEntries};
+  uint64_t hits{0};
+  uint64_t misses{0};
+  // Bumped by every invalidation, a miss only stores its result when no invalidation ran during its stat()
+  uint64_t generation{0};
+  // Most recently used first. Index keys point into Entry::path, so every path is stored once.
+  // Ordered, so a path and everything below it are one contiguous range
+  std::list<Entry> entries;
+  std::map<std::string_view, std::list<Entry>::iterator> index;
+};
+
+}
@@ -0,0 +1,228 @@
+//
+//  stat-utils.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <memory>
+#include <numeric>
+#include <string_view>
+#include <unistd.h>
+#include "io-uring.h"
+#include "stat-utils.h"
+#include "worker-pool.h"
+
+#if defined(__linux__) && defined(STATX_BASIC_STATS) && (!defined(__ANDROID__) || __ANDROID_API__ >= 30)
+#define RNFSTURBO_HAS_STATX 1
+#endif
+
+namespace cmpayc::rnfsturbo {
+
+// Below this many paths per worker the thread start-up costs more than the syscalls
+static constexpr size_t kMinPathsPerWorker = 64;
+
+// Resolves paths relative to the fd of their parent directory.
+// Batches usually come from one folder, so the directory is opened once it repeats
+// and the kernel only has to walk the basename for every following entry.
+class ParentDirCache {
+public:
+  ~ParentDirCache() {
+    if (dirFd >= 0) {
+      close(dirFd);
+    }
+  }
+
+  // Returns the fd to resolve `name` against (AT_FDCWD for full paths)
+  int resolve(const std::string& path, const char*& name) {
+    name = path.c_str();
+    size_t slash = path.rfind('/');
+    if (slash == std::string::npos || slash == 0) {
+      return AT_FDCWD;
+    }
+    std::string_view parent(path.data(), slash);
+    if (dirFd >= 0 && parent == dirPath) {
+      name = path.c_str() + slash + 1;
+      return dirFd;
+    }
+    if (parent != lastParent) {
+      lastParent.assign(parent);
+      return AT_FDCWD;
+    }
+    if (dirFd >= 0) {
+      close(dirFd);
+      dirFd = -1;
+    }
+    dirPath.assign(parent);
+    dirFd = open(dirPath.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+      return AT_FDCWD;
+    }
+    name = path.c_str() + slash + 1;
+    return dirFd;
+  }
+
+private:
+  int dirFd{-1};
+  std::string dirPath;
+  std::string lastParent;
+};
+
+#if defined(RNFSTURBO_HAS_IO_URING) && defined(RNFSTURBO_HAS_STATX)
+// Requests in flight, the kernel runs them on its own workers
+static constexpr unsigned kIoUringQueueDepth = 64;
+
+// Stats all paths through one io_uring, keeping up to queueDepth requests in flight.
+// onResult(index, statx or nullptr) runs on the calling thread. Returns the indexes that got no result
+// and are left to the fallback: all of them when io_uring isn't usable, the rest when the ring fails part way.
+template <typename OnResult>
+static std::vector<size_t> statxManyIoUring(const std::vector<std::string>& paths, unsigned queueDepth, unsigned mask, OnResult&& onResult) {
+  std::vector<size_t> unreported;
+  std::unique_ptr<IoUring> ring = IoUring::create(queueDepth, IORING_OP_STATX);
+  if (ring == nullptr) {
+    unreported.resize(paths.size());
+    std::iota(unreported.begin(), unreported.end(), 0);
+    return unreported;
+  }
+  std::vector<uint8_t> reported(paths.size(), 0);
+  queueDepth = std::min(queueDepth, ring->capacity());
+  std::vector<struct statx> slots(queueDepth);
+  std::vector<size_t> slotIndex(queueDepth);
+  std::vector<unsigned> freeSlots(queueDepth);
+  for (unsigned i = 0; i < queueDepth; i++) {
+    freeSlots[i] = queueDepth - 1 - i;
+  }
+  size_t next = 0;
+  size_t done = 0;
+  while (done < paths.size()) {
+    while (next < paths.size() && !freeSlots.empty()) {
+      io_uring_sqe* sqe = ring->nextSqe();
+      if (sqe == nullptr) {
+        break;
+      }
+      unsigned slot = freeSlots.back();
+      freeSlots.pop_back();
+      slotIndex[slot] = next;
+      sqe->opcode = IORING_OP_STATX;
+      sqe->fd = AT_FDCWD;
+      sqe->addr = reinterpret_cast<uint64_t>(paths[next].c_str());
+      sqe->len = mask;
+      sqe->off = reinterpret_cast<uint64_t>(&slots[slot]);
+      sqe->statx_flags = AT_STATX_SYNC_AS_STAT;
+      sqe->user_data = slot;
+      next++;
+    }
+    int res = ring->submitAndWait(1);
+    if (res != 0) {
+      // The kernel may still write into slots and read the paths of submitted requests
+      ring->waitForInFlight();
+      for (size_t i = 0; i < paths.size(); i++) {
+        if (!reported[i]) {
+          unreported.push_back(i);
+        }
+      }
+      return unreported;
+    }
+    done += ring->drainCompletions([&](uint64_t userData, int res) {
+      unsigned slot = static_cast<unsigned>(userData);
+      onResult(slotIndex[slot], res == 0 ? &slots[slot] : nullptr);
+      reported[slotIndex[slot]] = 1;
+      freeSlots.push_back(slot);
+    });
+  }
+  return unreported;
+}
+#endif
+
+// Runs body(index, dirCache) on the worker pool for every path, or only for `indexes` when given
+template <typename Body>
+static void forEachPath(const std::vector<std::string>& paths, const std::vector<size_t>* indexes, Body&& body) {
+  size_t count = indexes != nullptr ? indexes->size() : paths.size();
+  parallelFor(count, kMinPathsPerWorker, [&](size_t begin, size_t end) {
+    ParentDirCache dirCache;
+    for (size_t k = begin; k < end; k++) {
+      body(indexes != nullptr ? (*indexes)[k] : k, dirCache);
+    }
+  });
+}
+
+static void setStatFlags(uint32_t mode, uint8_t& flags) {
+  flags = StatFlagExists;
+  if (S_ISREG(mode)) {
+    flags |= StatFlagFile;
+  } else if (S_ISDIR(mode)) {
+    flags |= StatFlagDirectory;
+  }
+}
+
+void statMany(
+  const std::vector<std::string>& paths,
+  double* size,
+  double* mtime,
+  uint32_t* mode,
+  uint8_t* flags
+) {
+  const std::vector<size_t>* indexes = nullptr;
+#if defined(RNFSTURBO_HAS_IO_URING) && defined(RNFSTURBO_HAS_STATX)
+  std::vector<size_t> unreported = statxManyIoUring(paths, kIoUringQueueDepth, STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME, [&](size_t i, const struct statx* st) {
+    if (st == nullptr) {
+      size[i] = 0;
+      mtime[i] = 0;
+      mode[i] = 0;
+      flags[i] = 0;
+      return;
+    }
+    size[i] = static_cast<double>(st->stx_size);
+    mtime[i] = static_cast<double>(st->stx_mtime.tv_sec) + st->stx_mtime.tv_nsec / 1e9;
+    mode[i] = st->stx_mode;
+    setStatFlags(mode[i], flags[i]);
+  });
+  indexes = &unreported;
+#endif
+  forEachPath(paths, indexes, [&](size_t i, ParentDirCache& dirCache) {
+    const char* name;
+    int dirFd = dirCache.resolve(paths[i], name);
+    size[i] = 0;
+    mtime[i] = 0;
+    mode[i] = 0;
+    flags[i] = 0;
+#ifdef RNFSTURBO_HAS_STATX
+    struct statx st;
+    if (statx(dirFd, name, AT_STATX_SYNC_AS_STAT, STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_MTIME, &st) != 0) {
+      return;
+    }
+    size[i] = static_cast<double>(st.stx_size);
+    mtime[i] = static_cast<double>(st.stx_mtime.tv_sec) + st.stx_mtime.tv_nsec / 1e9;
+    mode[i] = st.stx_mode;
+#else
+    struct stat st;
+    if (fstatat(dirFd, name, &st, 0) != 0) {
+      return;
+    }
+    size[i] = static_cast<double>(st.st_size);
+    mtime[i] = mtimeSeconds(st);
+    mode[i] = st.st_mode;
+#endif
+    setStatFlags(mode[i], flags[i]);
+  });
+}
+
+void existsMany(const std::vector<std::string>& paths, uint8_t* exists) {
+  const std::vector<size_t>* indexes = nullptr;
+#if defined(RNFSTURBO_HAS_IO_URING) && defined(RNFSTURBO_HAS_STATX)
+  std::vector<size_t> unreported = statxManyIoUring(paths, kIoUringQueueDepth, STATX_TYPE, [&](size_t i, const struct statx* st) {
+    exists[i] = st != nullptr ? 1 : 0;
+  });
+  indexes = &unreported;
+#endif
+  forEachPath(paths, indexes, [&](size_t i, ParentDirCache& dirCache) {
+    const char* name;
+    int dirFd = dirCache.resolve(paths[i], name);
+    exists[i] = faccessat(dirFd, name, F_OK, 0) == 0 ? 1 : 0;
+  });
+}
+
+}
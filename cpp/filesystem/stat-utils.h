@@ -0,0 +1,45 @@
+//
+//  stat-utils.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <sys/stat.h>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+enum StatFlags : uint8_t {
+  StatFlagExists = 1 << 0,
+  StatFlagFile = 1 << 1,
+  StatFlagDirectory = 1 << 2,
+};
+
+// Modification time in seconds including the nanosecond fraction
+inline double mtimeSeconds(const struct stat& st) {
+#ifdef __APPLE__
+  return static_cast<double>(st.st_mtimespec.tv_sec) + st.st_mtimespec.tv_nsec / 1e9;
+#else
+  return static_cast<double>(st.st_mtim.tv_sec) + st.st_mtim.tv_nsec / 1e9;
+#endif
+}
+
+// Stats every path into columnar arrays sized to paths.size().
+// Missing entries get zero size/mtime/mode and no StatFlagExists bit.
+void statMany(
+  const std::vector<std::string>& paths,
+  double* size,
+  double* mtime,
+  uint32_t* mode,
+  uint8_t* flags
+);
+
+// Writes 1 for each path that exists and 0 otherwise
+void existsMany(const std::vector<std::string>& paths, uint8_t* exists);
+
+}
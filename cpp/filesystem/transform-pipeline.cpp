@@ -0,0 +1,264 @@
+//
+//  transform-pipeline.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <cctype>
+#include <cerrno>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+#include "../algorithms/base64.h"
+#include "transform-pipeline.h"
+#include "unique-fd.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kPipelineChunkSize = 256 * 1024;
+static constexpr size_t kPipelineRingSize = 4;
+
+void GunzipStage::process(const uint8_t* data, size_t length, const ByteSink& emit) {
+  inflater.write(data, length, emit);
+}
+
+void GunzipStage::finish(const ByteSink&) {
+  inflater.finish();
+}
+
+static void decodeBase64Groups(std::string& pending, const ByteSink& emit) {
+  size_t usable = pending.size() - pending.size() % 4;
+  if (usable == 0) {
+    return;
+  }
+  std::string decoded = base64::from_base64(std::string_view(pending.data(), usable));
+  pending.erase(0, usable);
+  emit(reinterpret_cast<const uint8_t*>(decoded.data()), decoded.size());
+}
+
+void Base64DecodeStage::process(const uint8_t* data, size_t length, const ByteSink& emit) {
+  for (size_t i = 0; i < length; i++) {
+    if (!std::isspace(data[i])) {
+      pending.push_back(static_cast<char>(data[i]));
+    }
+  }
+  decodeBase64Groups(pending, emit);
+}
+
+void Base64DecodeStage::finish(const ByteSink& emit) {
+  if (pending.empty()) {
+    return;
+  }
+  // Unpadded input
+  pending.append(4 - pending.size() % 4, '=');
+  decodeBase64Groups(pending, emit);
+}
+
+void HashStage::process(const uint8_t* data, size_t length, const ByteSink& emit) {
+  hasher->update(data, length);
+  emit(data, length);
+}
+
+std::string HashStage::digest() {
+  return hasher->hexDigest();
+}
+
+namespace {
+
+// Fixed set of buffers passed between the reader and the stage thread, which
+// blocks the reader when the stages fall behind
+class BufferRing {
+public:
+  struct Chunk {
+    std::vector<uint8_t> data;
+    size_t length{0};
+  };
+
+  BufferRing() {
+    for (size_t i = 0; i < kPipelineRingSize; i++) {
+      free.push_back(std::make_unique<Chunk>());
+      free.back()->data.resize(kPipelineChunkSize);
+    }
+  }
+
+  // nullptr once the pipeline is aborted
+  std::unique_ptr<Chunk> takeFree() {
+    std::unique_lock<std::mutex> lock(mutex);
+    freeCondition.wait(lock, [this] { return !free.empty() || aborted; });
+    if (aborted) {
+      return nullptr;
+    }
+    auto chunk = std::move(free.front());
+    free.pop_front();
+    return chunk;
+  }
+
+  void putFree(std::unique_ptr<Chunk> chunk) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      free.push_back(std::move(chunk));
+    }
+    freeCondition.notify_one();
+  }
+
+  // Zero length marks the end of the input
+  void putFilled(std::unique_ptr<Chunk> chunk) {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      filled.push_back(std::move(chunk));
+    }
+    filledCondition.notify_one();
+  }
+
+  std::unique_ptr<Chunk> takeFilled() {
+    std::unique_lock<std::mutex> lock(mutex);
+    filledCondition.wait(lock, [this] { return !filled.empty(); });
+    auto chunk = std::move(filled.front());
+    filled.pop_front();
+    return chunk;
+  }
+
+  void abort() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      aborted = true;
+    }
+    freeCondition.notify_all();
+  }
+
+private:
+  std::mutex mutex;
+  std::condition_variable freeCondition;
+  std::condition_variable filledCondition;
+  std::deque<std::unique_ptr<Chunk>> free;
+  std::deque<std::unique_ptr<Chunk>> filled;
+  bool aborted{false};
+};
+
+}
+
+static void writeAllTo(int fd, const uint8_t* data, size_t length) {
+  while (length > 0) {
+    ssize_t written = write(fd, data, length);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    data += written;
+    length -= written;
+  }
+}
+
+PipelineResult runPipeline(
+  const std::string& srcPath,
+  const std::string& dstPath,
+  const std::vector<std::unique_ptr<TransformStage>>& stages
+) {
+  UniqueFd srcFd(open(srcPath.c_str(), O_RDONLY | O_CLOEXEC));
+  if (!srcFd.valid()) {
+    throw strerror(errno);
+  }
+#ifdef POSIX_FADV_SEQUENTIAL
+  posix_fadvise(srcFd.get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  // Truncate only after making sure the destination isn't the source itself,
+  // otherwise the input would be gone before the first read
+  UniqueFd dstFd(open(dstPath.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644));
+  if (!dstFd.valid()) {
+    throw strerror(errno);
+  }
+  struct stat srcStat;
+  struct stat dstStat;
+  if (fstat(srcFd.get(), &srcStat) < 0 || fstat(dstFd.get(), &dstStat) < 0) {
+    throw strerror(errno);
+  }
+  if (srcStat.st_dev == dstStat.st_dev && srcStat.st_ino == dstStat.st_ino) {
+    throw "Source and destination are the same file";
+  }
+  if (ftruncate(dstFd.get(), 0) < 0) {
+    throw strerror(errno);
+  }
+
+  PipelineResult result;
+
+  // sinks[i] feeds stage i, the last one writes to the destination
+  std::vector<ByteSink> sinks(stages.size() + 1);
+  sinks[stages.size()] = [&](const uint8_t* data, size_t length) {
+    writeAllTo(dstFd.get(), data, length);
+    result.bytesWritten += length;
+  };
+  for (size_t i = stages.size(); i-- > 0;) {
+    sinks[i] = [&, i](const uint8_t* data, size_t length) {
+      stages[i]->process(data, length, sinks[i + 1]);
+    };
+  }
+
+  BufferRing ring;
+  const char* readError = nullptr;
+  std::thread reader([&] {
+    while (true) {
+      auto chunk = ring.takeFree();
+      if (chunk == nullptr) {
+        return;
+      }
+      ssize_t bytesRead;
+      do {
+        bytesRead = read(srcFd.get(), chunk->data.data(), chunk->data.size());
+      } while (bytesRead < 0 && errno == EINTR);
+      if (bytesRead < 0) {
+        readError = strerror(errno);
+        bytesRead = 0;
+      }
+      chunk->length = bytesRead;
+      ring.putFilled(std::move(chunk));
+      if (bytesRead == 0) {
+        return;
+      }
+    }
+  });
+
+  try {
+    while (true) {
+      auto chunk = ring.takeFilled();
+      if (chunk->length == 0) {
+        break;
+      }
+      result.bytesRead += chunk->length;
+      sinks[0](chunk->data.data(), chunk->length);
+      ring.putFree(std::move(chunk));
+    }
+    reader.join();
+    if (readError != nullptr) {
+      throw readError;
+    }
+    // Each stage flushes into the next one before that one finishes
+    for (size_t i = 0; i < stages.size(); i++) {
+      stages[i]->finish(sinks[i + 1]);
+    }
+  } catch (...) {
+    ring.abort();
+    if (reader.joinable()) {
+      reader.join();
+    }
+    dstFd.reset();
+    unlink(dstPath.c_str());
+    throw;
+  }
+
+  for (const auto& stage : stages) {
+    if (stage->hasDigest()) {
+      result.digests.push_back(stage->digest());
+    }
+  }
+  return result;
+}
+
+}
@@ -0,0 +1,88 @@
+//
+//  transform-pipeline.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../algorithms/hasher.h"
+#include "zlib-stream.h"
+
+namespace cmpayc::rnfsturbo {
+
+// One streaming step of a pipeline. process() may emit any amount of output (or none),
+// finish() flushes whatever the stage still holds once the input has ended.
+class TransformStage {
+public:
+  virtual ~TransformStage() = default;
+
+  virtual void process(const uint8_t* data, size_t length, const ByteSink& emit) = 0;
+  virtual void finish(const ByteSink& emit) {}
+
+  // Only hash stages produce a digest
+  virtual bool hasDigest() const {
+    return false;
+  }
+  virtual std::string digest() {
+    return {};
+  }
+};
+
+class GunzipStage : public TransformStage {
+public:
+  void process(const uint8_t* data, size_t length, const ByteSink& emit) override;
+  void finish(const ByteSink& emit) override;
+
+private:
+  ZlibInflater inflater;
+};
+
+// Whitespace (e.g. line breaks of MIME base64) is skipped
+class Base64DecodeStage : public TransformStage {
+public:
+  void process(const uint8_t* data, size_t length, const ByteSink& emit) override;
+  void finish(const ByteSink& emit) override;
+
+private:
+  std::string pending;
+};
+
+// Passes the data through unchanged and hashes it on the way
+class HashStage : public TransformStage {
+public:
+  explicit HashStage(std::unique_ptr<Hasher> hasher) : hasher(std::move(hasher)) {}
+
+  void process(const uint8_t* data, size_t length, const ByteSink& emit) override;
+  bool hasDigest() const override {
+    return true;
+  }
+  std::string digest() override;
+
+private:
+  std::unique_ptr<Hasher> hasher;
+};
+
+struct PipelineResult {
+  uint64_t bytesRead{0};
+  uint64_t bytesWritten{0};
+  // Digests of the hash stages, in stage order
+  std::vector<std::string> digests;
+};
+
+// Streams srcPath through the stages into dstPath in a single pass. A reader thread fills a small
+// ring of buffers while the calling thread runs the stages, so memory stays bounded by the chunk
+// size whatever the file size. dstPath is removed if any stage fails.
+PipelineResult runPipeline(
+  const std::string& srcPath,
+  const std::string& dstPath,
+  const std::vector<std::unique_ptr<TransformStage>>& stages
+);
+
+}
@@ -0,0 +1,53 @@
+//
+//  unique-fd.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <unistd.h>
+#include <utility>
+
+namespace cmpayc::rnfsturbo {
+
+// Closes the file descriptor when it goes out of scope
+class UniqueFd {
+public:
+  UniqueFd() = default;
+  explicit UniqueFd(int fd) : fd(fd) {}
+  UniqueFd(UniqueFd&& other) noexcept : fd(std::exchange(other.fd, -1)) {}
+  UniqueFd& operator=(UniqueFd&& other) noexcept {
+    if (this != &other) {
+      reset(std::exchange(other.fd, -1));
+    }
+    return *this;
+  }
+  UniqueFd(const UniqueFd&) = delete;
+  UniqueFd& operator=(const UniqueFd&) = delete;
+
+  ~UniqueFd() {
+    reset();
+  }
+
+  int get() const {
+    return fd;
+  }
+
+  bool valid() const {
+    return fd >= 0;
+  }
+
+  void reset(int newFd = -1) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    fd = newFd;
+  }
+
+private:
+  int fd{-1};
+};
+
+}
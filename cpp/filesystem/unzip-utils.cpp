@@ -0,0 +1,416 @@
+//
+//  unzip-utils.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <optional>
+#include <set>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+#include "../algorithms/crc32.h"
+#include "allocate-utils.h"
+#include "unique-fd.h"
+#include "unzip-utils.h"
+#include "worker-pool.h"
+#include "zip-format.h"
+#include "zlib-stream.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kUnzipChunkSize = 256 * 1024;
+
+namespace {
+
+struct ZipEntry {
+  // Relative path inside the archive, without "." and empty segments
+  std::string name;
+  bool isDirectory;
+  uint16_t method;
+  uint16_t flags;
+  uint32_t crc;
+  uint64_t compressedSize;
+  uint64_t size;
+  uint64_t localHeaderOffset;
+  uint16_t dosDate;
+  uint16_t dosTime;
+  mode_t mode;
+};
+
+// Read-only mapping of [offset, offset + length) of a file
+class MappedRange {
+public:
+  MappedRange(int fd, uint64_t offset, size_t length) {
+    uint64_t pageSize = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+    uint64_t alignedOffset = offset - offset % pageSize;
+    mappedLength = length + (offset - alignedOffset);
+    mapped = mmap(nullptr, mappedLength, PROT_READ, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+    if (mapped == MAP_FAILED) {
+      throw strerror(errno);
+    }
+    start = static_cast<const uint8_t*>(mapped) + (offset - alignedOffset);
+  }
+  MappedRange(const MappedRange&) = delete;
+  MappedRange& operator=(const MappedRange&) = delete;
+  ~MappedRange() {
+    munmap(mapped, mappedLength);
+  }
+
+  const uint8_t* data() const {
+    return start;
+  }
+
+private:
+  void* mapped;
+  size_t mappedLength;
+  const uint8_t* start;
+};
+
+struct CentralDirectory {
+  uint64_t offset;
+  uint64_t size;
+  uint64_t entryCount;
+};
+
+}
+
+static void preadExact(int fd, uint8_t* data, size_t length, uint64_t offset) {
+  while (length > 0) {
+    ssize_t bytesRead = pread(fd, data, length, static_cast<off_t>(offset));
+    if (bytesRead < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    if (bytesRead == 0) {
+      throw "Corrupt zip archive";
+    }
+    data += bytesRead;
+    length -= bytesRead;
+    offset += bytesRead;
+  }
+}
+
+static void writeExact(int fd, const uint8_t* data, size_t length) {
+  while (length > 0) {
+    ssize_t written = write(fd, data, length);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw strerror(errno);
+    }
+    data += written;
+    length -= written;
+  }
+}
+
+static CentralDirectory findCentralDirectory(int fd, uint64_t fileSize) {
+  size_t tailSize = static_cast<size_t>(std::min<uint64_t>(fileSize, kZipMaxEndOfCentralDirSearch));
+  if (tailSize < kZipEndOfCentralDirSize) {
+    throw "Not a zip archive";
+  }
+  uint64_t tailOffset = fileSize - tailSize;
+  std::vector<uint8_t> tail(tailSize);
+  preadExact(fd, tail.data(), tail.size(), tailOffset);
+
+  // The record is followed by a comment of up to 64 KB, so search backwards
+  size_t pos = tailSize - kZipEndOfCentralDirSize + 1;
+  const uint8_t* record = nullptr;
+  while (pos-- > 0) {
+    if (zipRead32(tail.data() + pos) == kZipEndOfCentralDirSignature
+      && pos + kZipEndOfCentralDirSize + zipRead16(tail.data() + pos + 20) <= tailSize) {
+      record = tail.data() + pos;
+      break;
+    }
+  }
+  if (record == nullptr) {
+    throw "Not a zip archive";
+  }
+
+  CentralDirectory directory{zipRead32(record + 16), zipRead32(record + 12), zipRead16(record + 10)};
+  bool zip64 = directory.entryCount == 0xffff || directory.size == 0xffffffff || directory.offset == 0xffffffff;
+  uint64_t recordOffset = tailOffset + pos;
+  if (zip64 && recordOffset >= kZip64LocatorSize) {
+    uint8_t locator[kZip64LocatorSize];
+    preadExact(fd, locator, sizeof(locator), recordOffset - kZip64LocatorSize);
+    if (zipRead32(locator) == kZip64LocatorSignature) {
+      uint8_t record64[kZip64EndOfCentralDirSize];
+      uint64_t record64Offset = zipRead64(locator + 8);
+      if (record64Offset + kZip64EndOfCentralDirSize > fileSize) {
+        throw "Corrupt zip archive";
+      }
+      preadExact(fd, record64, sizeof(record64), record64Offset);
+      if (zipRead32(record64) != kZip64EndOfCentralDirSignature) {
+        throw "Corrupt zip archive";
+      }
+      directory = {zipRead64(record64 + 48), zipRead64(record64 + 40), zipRead64(record64 + 32)};
+    }
+  }
+  if (directory.offset + directory.size > fileSize) {
+    throw "Corrupt zip archive";
+  }
+  return directory;
+}
+
+// Backslashes are treated as separators (archives made on Windows), absolute paths
+// and ".." segments are rejected so nothing is written outside of the destination
+static bool normalizeEntryName(std::string_view rawName, std::string& name) {
+  name.clear();
+  if (rawName.empty() || rawName.front() == '/' || rawName.front() == '\\' || rawName.find('\0') != std::string_view::npos) {
+    return false;
+  }
+  size_t start = 0;
+  while (start <= rawName.size()) {
+    size_t end = rawName.find_first_of("/\\", start);
+    if (end == std::string_view::npos) {
+      end = rawName.size();
+    }
+    std::string_view segment = rawName.substr(start, end - start);
+    if (segment == "..") {
+      return false;
+    }
+    if (!segment.empty() && segment != ".") {
+      if (!name.empty()) {
+        name.push_back('/');
+      }
+      name.append(segment);
+    }
+    start = end + 1;
+  }
+  return true;
+}
+
+static std::vector<ZipEntry> readCentralDirectory(const uint8_t* data, const CentralDirectory& directory) {
+  std::vector<ZipEntry> entries;
+  entries.reserve(static_cast<size_t>(std::min<uint64_t>(directory.entryCount, directory.size / kZipCentralHeaderSize)));
+  size_t pos = 0;
+  for (uint64_t i = 0; i < directory.entryCount; i++) {
+    if (pos + kZipCentralHeaderSize > directory.size || zipRead32(data + pos) != kZipCentralHeaderSignature) {
+      throw "Corrupt zip archive";
+    }
+    const uint8_t* header = data + pos;
+    uint16_t nameLength = zipRead16(header + 28);
+    uint16_t extraLength = zipRead16(header + 30);
+    uint16_t commentLength = zipRead16(header + 32);
+    size_t recordSize = kZipCentralHeaderSize + nameLength + extraLength + commentLength;
+    if (pos + recordSize > directory.size) {
+      throw "Corrupt zip archive";
+    }
+
+    ZipEntry entry;
+    std::string_view rawName(reinterpret_cast<const char*>(header + kZipCentralHeaderSize), nameLength);
+    if (!normalizeEntryName(rawName, entry.name)) {
+      throw "Entry path is outside of the destination directory";
+    }
+    entry.isDirectory = rawName.back() == '/' || rawName.back() == '\\';
+    entry.flags = zipRead16(header + 8);
+    entry.method = zipRead16(header + 10);
+    entry.dosTime = zipRead16(header + 12);
+    entry.dosDate = zipRead16(header + 14);
+    entry.crc = zipRead32(header + 16);
+    entry.compressedSize = zipRead32(header + 20);
+    entry.size = zipRead32(header + 24);
+    entry.localHeaderOffset = zipRead32(header + 42);
+    uint32_t externalAttributes = zipRead32(header + 38);
+    mode_t unixMode = (externalAttributes >> 16) & 0777;
+    entry.mode = (header[5] == kZipHostUnix && unixMode != 0) ? unixMode : 0644;
+
+    // Sizes and offset that don't fit into 32 bits are in the zip64 extra field, in this order
+    const uint8_t* extra = header + kZipCentralHeaderSize + nameLength;
+    const uint8_t* extraEnd = extra + extraLength;
+    while (extra + 4 <= extraEnd) {
+      uint16_t fieldId = zipRead16(extra);
+      uint16_t fieldSize = zipRead16(extra + 2);
+      const uint8_t* field = extra + 4;
+      const uint8_t* fieldEnd = std::min(field + fieldSize, extraEnd);
+      if (fieldId == kZip64ExtraFieldId) {
+        for (uint64_t* value : {&entry.size, &entry.compressedSize, &entry.localHeaderOffset}) {
+          if (*value == 0xffffffff && field + 8 <= fieldEnd) {
+            *value = zipRead64(field);
+            field += 8;
+          }
+        }
+      }
+      extra += 4 + fieldSize;
+    }
+
+    if (!entry.name.empty()) {
+      entries.push_back(std::move(entry));
+    }
+    pos += recordSize;
+  }
+  return entries;
+}
+
+static void extractEntry(
+  int archiveFd,
+  uint64_t archiveSize,
+  const ZipEntry& entry,
+  const std::string& outPath,
+  bool overwrite,
+  std::vector<uint8_t>& chunk
+) {
+  if (entry.flags & kZipFlagEncrypted) {
+    throw "Encrypted entries are not supported";
+  }
+  if (entry.method != kZipMethodStored && entry.method != kZipMethodDeflated) {
+    throw "Unsupported compression method";
+  }
+  uint8_t localHeader[kZipLocalHeaderSize];
+  if (entry.localHeaderOffset + kZipLocalHeaderSize > archiveSize) {
+    throw "Corrupt zip archive";
+  }
+  preadExact(archiveFd, localHeader, sizeof(localHeader), entry.localHeaderOffset);
+  if (zipRead32(localHeader) != kZipLocalHeaderSignature) {
+    throw "Corrupt zip archive";
+  }
+  uint64_t dataOffset = entry.localHeaderOffset + kZipLocalHeaderSize + zipRead16(localHeader + 26) + zipRead16(localHeader + 28);
+  if (dataOffset + entry.compressedSize > archiveSize) {
+    throw "Corrupt zip archive";
+  }
+
+  UniqueFd fd(open(outPath.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | O_NOFOLLOW | (overwrite ? O_TRUNC : O_EXCL), entry.mode));
+  if (!fd.valid()) {
+    throw strerror(errno);
+  }
+  try {
+    allocateRange(fd.get(), 0, entry.size);
+
+    uint32_t crc = 0;
+    uint64_t written = 0;
+    ByteSink sink = [&](const uint8_t* data, size_t length) {
+      if (written + length > entry.size) {
+        throw "Entry size mismatch";
+      }
+      crc = crc32Update(crc, data, length);
+      writeExact(fd.get(), data, length);
+      written += length;
+    };
+    std::optional<ZlibInflater> inflater;
+    if (entry.method == kZipMethodDeflated) {
+      inflater.emplace(ZlibFormat::Raw);
+    }
+    for (uint64_t offset = 0; offset < entry.compressedSize;) {
+      size_t length = static_cast<size_t>(std::min<uint64_t>(chunk.size(), entry.compressedSize - offset));
+      preadExact(archiveFd, chunk.data(), length, dataOffset + offset);
+      if (inflater.has_value()) {
+        inflater->write(chunk.data(), length, sink);
+      } else {
+        sink(chunk.data(), length);
+      }
+      offset += length;
+    }
+    if (inflater.has_value()) {
+      inflater->finish();
+    }
+    if (written != entry.size) {
+      throw "Entry size mismatch";
+    }
+    if (crc != entry.crc) {
+      throw "CRC mismatch";
+    }
+
+    time_t mtime = zipDosTimeToUnix(entry.dosDate, entry.dosTime);
+    struct timespec times[2] = {{mtime, 0}, {mtime, 0}};
+    futimens(fd.get(), times);
+  } catch (...) {
+    fd.reset();
+    unlink(outPath.c_str());
+    throw;
+  }
+}
+
+static void makeDirectories(const std::string& path) {
+  if (mkdir(path.c_str(), 0755) == 0 || errno == EEXIST) {
+    return;
+  }
+  if (errno != ENOENT) {
+    throw strerror(errno);
+  }
+  size_t slash = path.rfind('/');
+  if (slash == std::string::npos || slash == 0) {
+    throw strerror(ENOENT);
+  }
+  makeDirectories(path.substr(0, slash));
+  if (mkdir(path.c_str(), 0755) != 0 && errno != EEXIST) {
+    throw strerror(errno);
+  }
+}
+
+UnzipResult unzipArchive(const std::string& archivePath, const std::string& destDir, const UnzipOptions& options) {
+  UniqueFd archiveFd(open(archivePath.c_str(), O_RDONLY | O_CLOEXEC));
+  if (!archiveFd.valid()) {
+    throw strerror(errno);
+  }
+  struct stat st;
+  if (fstat(archiveFd.get(), &st) != 0) {
+    throw strerror(errno);
+  }
+  uint64_t archiveSize = static_cast<uint64_t>(st.st_size);
+
+  CentralDirectory directory = findCentralDirectory(archiveFd.get(), archiveSize);
+  std::vector<ZipEntry> entries;
+  if (directory.size > 0) {
+    MappedRange centralDirectory(archiveFd.get(), directory.offset, static_cast<size_t>(directory.size));
+    entries = readCentralDirectory(centralDirectory.data(), directory);
+  }
+
+  // Directories are created upfront, so the workers only write files
+  std::set<std::string> dirs{destDir};
+  std::vector<size_t> files;
+  UnzipResult result;
+  for (size_t i = 0; i < entries.size(); i++) {
+    const ZipEntry& entry = entries[i];
+    size_t slash = entry.name.rfind('/');
+    std::string_view name = slash == std::string::npos ? std::string_view(entry.name) : std::string_view(entry.name).substr(slash + 1);
+    if (!options.filter.empty() && !options.filter.matches(entry.name, name)) {
+      continue;
+    }
+    if (entry.isDirectory) {
+      dirs.insert(destDir + "/" + entry.name);
+      continue;
+    }
+    if (slash != std::string::npos) {
+      dirs.insert(destDir + "/" + entry.name.substr(0, slash));
+    }
+    files.push_back(i);
+    result.files++;
+    result.size += entry.size;
+  }
+  for (const std::string& dir : dirs) {
+    makeDirectories(dir);
+  }
+
+  // Largest entries first, workers pick the next one dynamically
+  std::sort(files.begin(), files.end(), [&entries](size_t a, size_t b) {
+    return entries[a].compressedSize > entries[b].compressedSize;
+  });
+  std::atomic<size_t> nextFile{0};
+  std::atomic<bool> failed{false};
+  parallelFor(std::min(workerCount(), files.size()), 1, [&](size_t begin, size_t end) {
+    std::vector<uint8_t> chunk(kUnzipChunkSize);
+    size_t index;
+    while (!failed.load(std::memory_order_relaxed) && (index = nextFile.fetch_add(1, std::memory_order_relaxed)) < files.size()) {
+      const ZipEntry& entry = entries[files[index]];
+      try {
+        extractEntry(archiveFd.get(), archiveSize, entry, destDir + "/" + entry.name, options.overwrite, chunk);
+      } catch (...) {
+        failed = true;
+        throw;
+      }
+    }
+  });
+  return result;
+}
+
+}
@@ -0,0 +1,34 @@
+//
+//  unzip-utils.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include "glob-matcher.h"
+
+namespace cmpayc::rnfsturbo {
+
+struct UnzipOptions {
+  // Entries to extract, matched against the path inside the archive (empty = all)
+  GlobMatcher filter;
+  // Replace existing files, otherwise extraction fails on the first one
+  bool overwrite{true};
+};
+
+struct UnzipResult {
+  uint64_t files{0};
+  uint64_t size{0};
+};
+
+// Extracts a zip archive (zip64 included) into destDir, which is created if needed.
+// Only the central directory is mapped into memory, entries are streamed from the archive
+// and inflated on the worker threads, largest first. Output files are preallocated and the
+// CRC-32 of every entry is verified. Entries escaping destDir fail the whole extraction.
+UnzipResult unzipArchive(const std::string& archivePath, const std::string& destDir, const UnzipOptions& options);
+
+}
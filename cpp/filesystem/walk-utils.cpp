@@ -0,0 +1,179 @@
+//
+//  walk-utils.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <cstring>
+#include <errno.h>
+#include <fcntl.h>
+#include <mutex>
+#include <set>
+#include "dir-traversal.h"
+#include "glob-matcher.h"
+#include "stat-utils.h"
+#include "walk-utils.h"
+
+namespace cmpayc::rnfsturbo {
+
+std::optional<WalkType> parseWalkType(std::string_view type) {
+  if (type == "all") {
+    return WalkType::All;
+  }
+  if (type == "file") {
+    return WalkType::File;
+  }
+  if (type == "directory") {
+    return WalkType::Directory;
+  }
+  return std::nullopt;
+}
+
+namespace {
+
+class Walker : public DirTraversal {
+public:
+  Walker(const std::string& root, const WalkOptions& options, const WalkBatchCallback& onBatch)
+    : root(root), options(options), onBatch(onBatch), matcher(options.glob), batches(workers()) {
+    relativeOffset = root == "/" ? 1 : root.size() + 1;
+    needsStat = options.minSize >= 0 || options.maxSize >= 0 || options.modifiedAfter >= 0;
+  }
+
+  void walk() {
+    struct stat rootStat;
+    if (stat(root.c_str(), &rootStat) != 0) {
+      throw strerror(errno);
+    }
+    if (!S_ISDIR(rootStat.st_mode)) {
+      throw "Not a directory";
+    }
+    if (options.followSymlinks) {
+      markVisited(rootStat);
+    }
+    pushDirectory(0, {root, 0, 0});
+    run();
+  }
+
+protected:
+  void visitDirectory(size_t worker, const DirTask& dir) override {
+    int dirFd = open(dir.path.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (dirFd < 0) {
+      return;
+    }
+    std::vector<WalkEntry>& batch = batches[worker];
+    int childDepth = dir.depth + 1;
+    bool canDescend = options.maxDepth < 0 || childDepth < options.maxDepth;
+    std::string childPath = dir.path;
+    if (childPath.back() != '/') {
+      childPath.push_back('/');
+    }
+    size_t nameOffset = childPath.size();
+
+    readDirectoryEntries(dirFd, [&](const char* name, unsigned char type) {
+      struct stat st;
+      bool hasStat{false};
+      if (type == DT_UNKNOWN) {
+        if (fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) != 0) {
+          return;
+        }
+        hasStat = true;
+        type = S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : S_ISLNK(st.st_mode) ? DT_LNK : DT_UNKNOWN;
+      }
+      if (type == DT_LNK && options.followSymlinks) {
+        if (fstatat(dirFd, name, &st, 0) != 0) {
+          return;
+        }
+        hasStat = true;
+        type = S_ISDIR(st.st_mode) ? DT_DIR : S_ISREG(st.st_mode) ? DT_REG : DT_UNKNOWN;
+      }
+      bool isDirectory = type == DT_DIR;
+      bool isFile = type == DT_REG;
+
+      childPath.resize(nameOffset);
+      childPath.append(name);
+      std::string_view relativePath = std::string_view(childPath).substr(relativeOffset);
+
+      bool descend = isDirectory && canDescend && matcher.couldMatchBelow(relativePath);
+      if (descend && options.followSymlinks) {
+        if (!hasStat && fstatat(dirFd, name, &st, 0) != 0) {
+          return;
+        }
+        hasStat = true;
+        descend = markVisited(st);
+      }
+
+      bool typeMatches = options.type == WalkType::All ||
+        (options.type == WalkType::File && isFile) ||
+        (options.type == WalkType::Directory && isDirectory);
+      if (typeMatches && matcher.matches(relativePath, std::string_view(childPath).substr(nameOffset))) {
+        if (!hasStat && fstatat(dirFd, name, &st, AT_SYMLINK_NOFOLLOW) == 0) {
+          hasStat = true;
+        }
+        double size = hasStat ? static_cast<double>(st.st_size) : 0;
+        double mtime = hasStat ? mtimeSeconds(st) : 0;
+        bool passes = !needsStat || (
+          hasStat &&
+          (options.minSize < 0 || size >= options.minSize) &&
+          (options.maxSize < 0 || size <= options.maxSize) &&
+          (options.modifiedAfter < 0 || mtime > options.modifiedAfter)
+        );
+        if (passes) {
+          batch.push_back({childPath, nameOffset, size, mtime, isDirectory, isFile});
+          if (batch.size() >= options.batchSize) {
+            flush(batch);
+          }
+        }
+      }
+
+      if (descend) {
+        pushDirectory(worker, {childPath, childDepth, 0});
+      }
+    });
+    close(dirFd);
+  }
+
+  void finishWorker(size_t worker) override {
+    flush(batches[worker]);
+  }
+
+private:
+  // Guards against symlink loops when links are followed
+  bool markVisited(const struct stat& st) {
+    std::lock_guard<std::mutex> lock(visitedMutex);
+    return visited.emplace(st.st_dev, st.st_ino).second;
+  }
+
+  void flush(std::vector<WalkEntry>& batch) {
+    if (batch.empty()) {
+      return;
+    }
+    std::vector<WalkEntry> ready;
+    ready.reserve(options.batchSize);
+    ready.swap(batch);
+    std::lock_guard<std::mutex> lock(batchMutex);
+    onBatch(std::move(ready));
+  }
+
+private:
+  const std::string& root;
+  const WalkOptions& options;
+  const WalkBatchCallback& onBatch;
+  GlobMatcher matcher;
+  size_t relativeOffset;
+  bool needsStat;
+
+  std::vector<std::vector<WalkEntry>> batches;
+  std::mutex batchMutex;
+  std::mutex visitedMutex;
+  std::set<std::pair<dev_t, ino_t>> visited;
+};
+
+}
+
+void walk(const std::string& root, const WalkOptions& options, const WalkBatchCallback& onBatch) {
+  Walker walker(root, options, onBatch);
+  walker.walk();
+}
+
+}
@@ -0,0 +1,50 @@
+//
+//  walk-utils.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+enum class WalkType : uint8_t { All, File, Directory };
+
+std::optional<WalkType> parseWalkType(std::string_view type);
+
+struct WalkOptions {
+  int maxDepth{-1}; // -1 - unlimited, 1 - direct children only
+  std::string glob;
+  double minSize{-1};
+  double maxSize{-1};
+  double modifiedAfter{-1}; // unixtime, sec
+  WalkType type{WalkType::All};
+  bool followSymlinks{false};
+  size_t batchSize{256};
+};
+
+struct WalkEntry {
+  std::string path;
+  size_t nameOffset; // path.substr(nameOffset) is the item name
+  double size;
+  double mtime;
+  bool isDirectory;
+  bool isFile;
+};
+
+// Receives matches in batches of up to WalkOptions::batchSize, calls are serialized
+using WalkBatchCallback = std::function<void(std::vector<WalkEntry>&& batch)>;
+
+// Recursively lists `root` on the worker pool. Unreadable subdirectories are skipped,
+// an unreadable root throws.
+void walk(const std::string& root, const WalkOptions& options, const WalkBatchCallback& onBatch);
+
+}
@@ -0,0 +1,159 @@
+//
+//  worker-pool.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <system_error>
+#include <thread>
+#include "worker-pool.h"
+
+namespace cmpayc::rnfsturbo {
+
+// Mobile SoCs have few big cores, more threads mostly add contention on the storage queue.
+// CPU bound callers use computeWorkerCount() instead
+static constexpr size_t kMaxWorkers = 4;
+
+size_t workerCount() {
+  return std::min(computeWorkerCount(), kMaxWorkers);
+}
+
+size_t computeWorkerCount() {
+  return std::max<size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+namespace {
+
+struct ParallelJob {
+  const std::function<void(size_t begin, size_t end)>* body;
+  size_t count;
+  size_t rangeSize;
+  size_t ranges;
+  std::atomic<size_t> nextRange{0};
+  std::mutex mutex;
+  std::condition_variable finished;
+  size_t doneRanges{0};
+  std::exception_ptr error;
+
+  // Claims and runs the next range, false when all of them are taken.
+  // `body` is only touched for a claimed range, the caller waits for those before returning
+  bool runNext() {
+    size_t range = nextRange.fetch_add(1, std::memory_order_relaxed);
+    if (range >= ranges) {
+      return false;
+    }
+    std::exception_ptr rangeError;
+    try {
+      size_t begin = range * rangeSize;
+      (*body)(begin, std::min(begin + rangeSize, count));
+    } catch (...) {
+      rangeError = std::current_exception();
+    }
+    std::lock_guard<std::mutex> lock(mutex);
+    if (rangeError != nullptr && error == nullptr) {
+      error = rangeError;
+    }
+    if (++doneRanges == ranges) {
+      finished.notify_all();
+    }
+    return true;
+  }
+};
+
+// Threads are started once and live as long as the process
+class WorkerPool {
+public:
+  explicit WorkerPool(size_t threadCount) {
+    for (size_t i = 0; i < threadCount; i++) {
+      try {
+        std::thread(&WorkerPool::workerLoop, this).detach();
+        threads++;
+      } catch (const std::system_error&) {
+        // Fewer helpers, the callers run the ranges that aren't picked up
+        break;
+      }
+    }
+  }
+
+  void post(const std::shared_ptr<ParallelJob>& job, size_t helpers) {
+    helpers = std::min(helpers, threads);
+    if (helpers == 0) {
+      return;
+    }
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      for (size_t i = 0; i < helpers; i++) {
+        jobs.push_back(job);
+      }
+    }
+    if (helpers == 1) {
+      available.notify_one();
+    } else {
+      available.notify_all();
+    }
+  }
+
+  static WorkerPool& shared() {
+    // Never destroyed, detached jobs may still use it while the process exits
+    static WorkerPool* pool = new WorkerPool(computeWorkerCount() - 1);
+    return *pool;
+  }
+
+private:
+  void workerLoop() {
+    while (true) {
+      std::shared_ptr<ParallelJob> job;
+      {
+        std::unique_lock<std::mutex> lock(mutex);
+        available.wait(lock, [this] { return !jobs.empty(); });
+        job = std::move(jobs.front());
+        jobs.pop_front();
+      }
+      while (job->runNext()) {
+      }
+    }
+  }
+
+  size_t threads{0};
+  std::mutex mutex;
+  std::condition_variable available;
+  std::deque<std::shared_ptr<ParallelJob>> jobs;
+};
+
+}
+
+void parallelFor(size_t count, size_t minPerWorker, const std::function<void(size_t begin, size_t end)>& body, size_t maxWorkers) {
+  if (count == 0) {
+    return;
+  }
+  size_t workers = std::min(maxWorkers, count / std::max<size_t>(minPerWorker, 1));
+  if (workers <= 1) {
+    body(0, count);
+    return;
+  }
+
+  auto job = std::make_shared<ParallelJob>();
+  job->body = &body;
+  job->count = count;
+  job->rangeSize = (count + workers - 1) / workers;
+  job->ranges = (count + job->rangeSize - 1) / job->rangeSize;
+  WorkerPool::shared().post(job, job->ranges - 1);
+
+  while (job->runNext()) {
+  }
+  std::unique_lock<std::mutex> lock(job->mutex);
+  job->finished.wait(lock, [&job] { return job->doneRanges == job->ranges; });
+  if (job->error != nullptr) {
+    std::rethrow_exception(job->error);
+  }
+}
+
+}
@@ -0,0 +1,33 @@
+//
+//  worker-pool.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace cmpayc::rnfsturbo {
+
+// Number of workers used for parallel file operations, at most 4
+size_t workerCount();
+
+// Number of workers for CPU bound work on data already in memory (hashing), one per hardware thread
+size_t computeWorkerCount();
+
+// Splits [0, count) into at most `maxWorkers` contiguous ranges and runs `body` for each of them,
+// on the threads of a shared pool and on the calling thread. Ranges nobody has picked up yet are run by the caller,
+// so it is safe to call from inside `body`.
+// Runs inline when there are fewer than `minPerWorker` items per worker.
+// The first exception thrown by a range is rethrown on the calling thread.
+void parallelFor(
+  size_t count,
+  size_t minPerWorker,
+  const std::function<void(size_t begin, size_t end)>& body,
+  size_t maxWorkers = workerCount()
+);
+
+}
@@ -0,0 +1,110 @@
+//
+//  zip-format.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstdint>
+#include <ctime>
+#include <vector>
+
+namespace cmpayc::rnfsturbo {
+
+// Record layouts of the zip format (APPNOTE.TXT), all integers little-endian
+inline constexpr uint32_t kZipLocalHeaderSignature = 0x04034b50;
+inline constexpr uint32_t kZipCentralHeaderSignature = 0x02014b50;
+inline constexpr uint32_t kZipEndOfCentralDirSignature = 0x06054b50;
+inline constexpr uint32_t kZip64EndOfCentralDirSignature = 0x06064b50;
+inline constexpr uint32_t kZip64LocatorSignature = 0x07064b50;
+inline constexpr uint16_t kZip64ExtraFieldId = 0x0001;
+
+inline constexpr size_t kZipLocalHeaderSize = 30;
+inline constexpr size_t kZipCentralHeaderSize = 46;
+inline constexpr size_t kZipEndOfCentralDirSize = 22;
+inline constexpr size_t kZip64EndOfCentralDirSize = 56;
+inline constexpr size_t kZip64LocatorSize = 20;
+// End of central directory record plus the longest possible comment
+inline constexpr size_t kZipMaxEndOfCentralDirSearch = kZipEndOfCentralDirSize + 0xffff;
+
+inline constexpr uint16_t kZipMethodStored = 0;
+inline constexpr uint16_t kZipMethodDeflated = 8;
+inline constexpr uint16_t kZipFlagEncrypted = 0x0001;
+inline constexpr uint16_t kZipFlagDataDescriptor = 0x0008;
+inline constexpr uint16_t kZipFlagUtf8 = 0x0800;
+// "Version made by" host of entries with unix permissions in the external attributes
+inline constexpr uint8_t kZipHostUnix = 3;
+// "Version needed to extract": deflate and directories, zip64 extensions
+inline constexpr uint16_t kZipVersionDeflate = 20;
+inline constexpr uint16_t kZipVersionZip64 = 45;
+// Field value telling that the real one is in the zip64 extra field or record
+inline constexpr uint32_t kZip64Marker = 0xffffffff;
+inline constexpr uint16_t kZip64CountMarker = 0xffff;
+// MS-DOS directory attribute in the low byte of the external attributes
+inline constexpr uint32_t kZipDosDirectory = 0x10;
+
+inline uint16_t zipRead16(const uint8_t* p) {
+  return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t zipRead32(const uint8_t* p) {
+  return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8)
+    | (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline uint64_t zipRead64(const uint8_t* p) {
+  return static_cast<uint64_t>(zipRead32(p)) | (static_cast<uint64_t>(zipRead32(p + 4)) << 32);
+}
+
+inline void zipWrite16(std::vector<uint8_t>& out, uint16_t value) {
+  out.push_back(static_cast<uint8_t>(value));
+  out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+inline void zipWrite32(std::vector<uint8_t>& out, uint32_t value) {
+  zipWrite16(out, static_cast<uint16_t>(value));
+  zipWrite16(out, static_cast<uint16_t>(value >> 16));
+}
+
+inline void zipWrite64(std::vector<uint8_t>& out, uint64_t value) {
+  zipWrite32(out, static_cast<uint32_t>(value));
+  zipWrite32(out, static_cast<uint32_t>(value >> 32));
+}
+
+// MS-DOS date and time fields (local time, 2 second resolution)
+inline time_t zipDosTimeToUnix(uint16_t dosDate, uint16_t dosTime) {
+  struct tm tm {};
+  tm.tm_year = ((dosDate >> 9) & 0x7f) + 80;
+  tm.tm_mon = ((dosDate >> 5) & 0x0f) - 1;
+  tm.tm_mday = dosDate & 0x1f;
+  tm.tm_hour = (dosTime >> 11) & 0x1f;
+  tm.tm_min = (dosTime >> 5) & 0x3f;
+  tm.tm_sec = (dosTime & 0x1f) * 2;
+  tm.tm_isdst = -1;
+  return mktime(&tm);
+}
+
+// Dates before 1980 can't be represented and are clamped to its first day
+inline void zipUnixTimeToDos(time_t time, uint16_t& dosDate, uint16_t& dosTime) {
+  struct tm tm {};
+  localtime_r(&time, &tm);
+  if (tm.tm_year < 80) {
+    dosDate = (1 << 5) | 1;
+    dosTime = 0;
+    return;
+  }
+  if (tm.tm_year > 207) {
+    tm.tm_year = 207;
+    tm.tm_mon = 11;
+    tm.tm_mday = 31;
+    tm.tm_hour = 23;
+    tm.tm_min = 59;
+    tm.tm_sec = 58;
+  }
+  dosDate = static_cast<uint16_t>(((tm.tm_year - 80) << 9) | ((tm.tm_mon + 1) << 5) | tm.tm_mday);
+  dosTime = static_cast<uint16_t>((tm.tm_hour << 11) | (tm.tm_min << 5) | (tm.tm_sec / 2));
+}
+
+}
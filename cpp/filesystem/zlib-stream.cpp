@@ -0,0 +1,123 @@
+//
+//  zlib-stream.cpp
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#include <algorithm>
+#include <climits>
+#include "zlib-stream.h"
+
+namespace cmpayc::rnfsturbo {
+
+static constexpr size_t kZlibBufferSize = 256 * 1024;
+// 15 window bits, +32 detects gzip and zlib headers
+static constexpr int kInflateWindowBits = 15 + 32;
+// +16 writes a gzip header instead of the zlib one
+static constexpr int kGzipWindowBits = 15 + 16;
+static constexpr int kDeflateWindowBits = 15;
+// Negative window bits mean no header
+static constexpr int kRawWindowBits = -15;
+static constexpr int kDeflateMemLevel = 8;
+
+ZlibDeflater::ZlibDeflater(ZlibFormat format, int level) : buffer(kZlibBufferSize) {
+  int windowBits = format == ZlibFormat::Gzip
+    ? kGzipWindowBits
+    : (format == ZlibFormat::Raw ? kRawWindowBits : kDeflateWindowBits);
+  if (deflateInit2(&stream, level, Z_DEFLATED, windowBits, kDeflateMemLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw "Failed to initialize zlib";
+  }
+}
+
+ZlibDeflater::~ZlibDeflater() {
+  deflateEnd(&stream);
+}
+
+void ZlibDeflater::run(int flush, const ByteSink& sink) {
+  int res;
+  do {
+    stream.next_out = buffer.data();
+    stream.avail_out = static_cast<uInt>(buffer.size());
+    res = deflate(&stream, flush);
+    if (res == Z_STREAM_ERROR) {
+      throw "Compression failed";
+    }
+    size_t produced = buffer.size() - stream.avail_out;
+    if (produced > 0) {
+      sink(buffer.data(), produced);
+    }
+  } while (stream.avail_out == 0 || (flush == Z_FINISH && res != Z_STREAM_END));
+}
+
+void ZlibDeflater::write(const uint8_t* data, size_t length, const ByteSink& sink) {
+  while (length > 0) {
+    uInt chunk = static_cast<uInt>(std::min<size_t>(length, UINT_MAX));
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = chunk;
+    run(Z_NO_FLUSH, sink);
+    data += chunk;
+    length -= chunk;
+  }
+}
+
+void ZlibDeflater::finish(const ByteSink& sink) {
+  stream.next_in = nullptr;
+  stream.avail_in = 0;
+  run(Z_FINISH, sink);
+}
+
+ZlibInflater::ZlibInflater(ZlibFormat format) : buffer(kZlibBufferSize) {
+  if (inflateInit2(&stream, format == ZlibFormat::Raw ? kRawWindowBits : kInflateWindowBits) != Z_OK) {
+    throw "Failed to initialize zlib";
+  }
+}
+
+ZlibInflater::~ZlibInflater() {
+  inflateEnd(&stream);
+}
+
+void ZlibInflater::write(const uint8_t* data, size_t length, const ByteSink& sink) {
+  while (length > 0) {
+    uInt chunk = static_cast<uInt>(std::min<size_t>(length, UINT_MAX));
+    stream.next_in = const_cast<Bytef*>(data);
+    stream.avail_in = chunk;
+    while (stream.avail_in > 0) {
+      if (ended) {
+        // Next gzip member
+        if (inflateReset(&stream) != Z_OK) {
+          throw "Invalid compressed data";
+        }
+        ended = false;
+      }
+      do {
+        stream.next_out = buffer.data();
+        stream.avail_out = static_cast<uInt>(buffer.size());
+        int res = inflate(&stream, Z_NO_FLUSH);
+        if (res == Z_STREAM_END) {
+          ended = true;
+        } else if (res != Z_OK && res != Z_BUF_ERROR) {
+          throw "Invalid compressed data";
+        }
+        size_t produced = buffer.size() - stream.avail_out;
+        if (produced > 0) {
+          sink(buffer.data(), produced);
+        }
+        if (res == Z_BUF_ERROR) {
+          // Needs more input
+          break;
+        }
+      } while (stream.avail_out == 0 && !ended);
+    }
+    data += chunk;
+    length -= chunk;
+  }
+}
+
+void ZlibInflater::finish() {
+  if (!ended) {
+    throw "Unexpected end of compressed data";
+  }
+}
+
+}
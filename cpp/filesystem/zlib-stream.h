@@ -0,0 +1,71 @@
+//
+//  zlib-stream.h
+//  react-native-fs-turbo
+//
+//  Created by Sergei Kazakov on 19.10.26.
+//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <zlib.h>
+
+namespace cmpayc::rnfsturbo {
+
+// Receives output as it is produced, the pointer is only valid during the call
+using ByteSink = std::function<void(const uint8_t* data, size_t length)>;
+
+enum class ZlibFormat : uint8_t {
+  Gzip,
+  // zlib wrapper (RFC 1950), what "deflate" means for HTTP and most JS libraries
+  Deflate,
+  // Bare deflate data without header and checksum, as stored in zip archives
+  Raw,
+};
+
+// Streaming compression, output is passed to the sink as soon as a buffer fills up
+class ZlibDeflater {
+public:
+  ZlibDeflater(ZlibFormat format, int level = Z_DEFAULT_COMPRESSION);
+  ~ZlibDeflater();
+  ZlibDeflater(const ZlibDeflater&) = delete;
+  ZlibDeflater& operator=(const ZlibDeflater&) = delete;
+
+  void write(const uint8_t* data, size_t length, const ByteSink& sink);
+
+  // Flushes the rest and writes the trailer, the deflater can't be written to afterwards
+  void finish(const ByteSink& sink);
+
+private:
+  void run(int flush, const ByteSink& sink);
+
+  z_stream stream{};
+  std::vector<uint8_t> buffer;
+};
+
+// Streaming decompression of gzip or zlib ("deflate") data, the format is detected from the header.
+// Concatenated gzip members are decompressed one after another.
+class ZlibInflater {
+public:
+  // Gzip and Deflate both detect the format, Raw expects bare deflate data
+  explicit ZlibInflater(ZlibFormat format = ZlibFormat::Gzip);
+  ~ZlibInflater();
+  ZlibInflater(const ZlibInflater&) = delete;
+  ZlibInflater& operator=(const ZlibInflater&) = delete;
+
+  // Throws "Invalid compressed data" on corrupt input
+  void write(const uint8_t* data, size_t length, const ByteSink& sink);
+
+  // Throws when the input ended in the middle of a stream
+  void finish();
+
+private:
+  z_stream stream{};
+  bool ended{false};
+  std::vector<uint8_t> buffer;
+};
+
+}
@@ -3,6 +3,54 @@ import type { Configuration } from "./NativeRNFSTurboModule";
 import type {
   RNFSTurboInterface,
   OverloadedStatResult,
+  StatManyResult,
+  WalkOptions,
+  WalkBatchFunc,
+  WalkResultFunc,
+  WalkErrorFunc,
+  OverloadedWalkResult,
+  OpenDirOptions,
+  DirCursor,
+  WatchOptions,
+  WatchResultFunc,
+  StatCacheOptions,
+  StatCacheStats,
+  DuOptions,
+  DuResult,
+  AllocateOptions,
+  PrefetchOptions,
+  PipelineStage,
+  PipelineResultFunc,
+  PipelineErrorFunc,
+  OverloadedPipelineResult,
+  UnzipOptions,
+  UnzipResultFunc,
+  UnzipErrorFunc,
+  OverloadedUnzipResult,
+  ZipOptions,
+  ArchiveResultFunc,
+  ArchiveErrorFunc,
+  OverloadedArchiveResult,
+  KdfOptions,
+  KeyHandle,
+  DeriveKeyResultFunc,
+  DeriveKeyErrorFunc,
+  OverloadedDeriveKeyResult,
+  HashOptions,
+  ChunkManifestOptions,
+  ChunkManifestResultFunc,
+  ChunkManifestErrorFunc,
+  OverloadedChunkManifestResult,
+  VerifyHmacOptions,
+  DataEncryptionOptions,
+  DataDecryptionOptions,
+  HashDataResultFunc,
+  EncryptDataResultFunc,
+  DecryptDataResultFunc,
+  DataErrorFunc,
+  OverloadedHashDataResult,
+  OverloadedEncryptDataResult,
+  OverloadedDecryptDataResult,
   OverloadedReadDirItem,
   Algorithms,
   MkdirOptions,
@@ -283,9 +331,281 @@ class RNFSTurbo implements RNFSTurboInterface {
     return func(filepath);
   }
 
-  hash(filepath: string, algorithm: Algorithms): string {
+  statMany(filepaths: string[]): StatManyResult {
+    const func = this.getFunctionFromCache("statMany");
+    const result = func(filepaths) as unknown as Record<
+      keyof StatManyResult,
+      ArrayBuffer
+    >;
+    return {
+      size: new Float64Array(result.size),
+      mtime: new Float64Array(result.mtime),
+      mode: new Uint32Array(result.mode),
+      flags: new Uint8Array(result.flags),
+    };
+  }
+
+  existsMany(filepaths: string[]): Uint8Array {
+    const func = this.getFunctionFromCache("existsMany");
+    return new Uint8Array(func(filepaths) as unknown as ArrayBuffer);
+  }
+
+  walk<T extends WalkBatchFunc = undefined>(
+    dirpath: string,
+    options?: WalkOptions,
+    batchCallback?: T,
+    completeCallback?: WalkResultFunc,
+    errorCallback?: WalkErrorFunc,
+  ): OverloadedWalkResult<T> {
+    const func = this.getFunctionFromCache("walk");
+    const walkOptions =
+      options?.modifiedAfter instanceof Date
+        ? { ...options, modifiedAfter: options.modifiedAfter.getTime() / 1000 }
+        : options;
+    if (!batchCallback) {
+      const result: any = func(dirpath, walkOptions);
+      return result;
+    }
+    const jobId: any = func(
+      dirpath,
+      walkOptions,
+      batchCallback,
+      completeCallback,
+      errorCallback,
+    );
+    return { jobId } as OverloadedWalkResult<T>;
+  }
+
+  openDir(dirpath: string, options?: OpenDirOptions): DirCursor {
+    const func = this.getFunctionFromCache("openDir");
+    const cursor = func(dirpath, options);
+    // The native object creates its functions on every access, paging through it shouldn't
+    return { next: cursor.next, close: cursor.close };
+  }
+
+  watch(
+    dirpath: string,
+    options: WatchOptions | undefined,
+    callback: WatchResultFunc,
+  ): number {
+    const func = this.getFunctionFromCache("watch");
+    return func(dirpath, options, callback);
+  }
+
+  unwatch(watchId: number): void {
+    const func = this.getFunctionFromCache("unwatch");
+    func(watchId);
+  }
+
+  configureStatCache(options: StatCacheOptions): void {
+    const func = this.getFunctionFromCache("configureStatCache");
+    func(options);
+  }
+
+  getStatCacheStats(): StatCacheStats {
+    const func = this.getFunctionFromCache("getStatCacheStats");
+    return func();
+  }
+
+  du(path: string, options?: DuOptions): DuResult {
+    const func = this.getFunctionFromCache("du");
+    return func(path, options);
+  }
+
+  allocate(filepath: string, size: number, options?: AllocateOptions): void {
+    const func = this.getFunctionFromCache("allocate");
+    func(filepath, size, options);
+  }
+
+  prefetch(filepaths: string[], options?: PrefetchOptions): void {
+    const func = this.getFunctionFromCache("prefetch");
+    func(filepaths, options);
+  }
+
+  evict(filepath: string): void {
+    const func = this.getFunctionFromCache("evict");
+    func(filepath);
+  }
+
+  pipeline<T extends PipelineResultFunc = undefined>(
+    srcPath: string,
+    destPath: string,
+    stages: PipelineStage[],
+    completeCallback?: T,
+    errorCallback?: PipelineErrorFunc,
+  ): OverloadedPipelineResult<T> {
+    const func = this.getFunctionFromCache("pipeline");
+    if (!completeCallback) {
+      const result: any = func(srcPath, destPath, stages);
+      return result;
+    }
+    const jobId: any = func(
+      srcPath,
+      destPath,
+      stages,
+      completeCallback,
+      errorCallback,
+    );
+    return { jobId } as OverloadedPipelineResult<T>;
+  }
+
+  unzip<T extends UnzipResultFunc = undefined>(
+    archivePath: string,
+    destDir: string,
+    options?: UnzipOptions,
+    completeCallback?: T,
+    errorCallback?: UnzipErrorFunc,
+  ): OverloadedUnzipResult<T> {
+    const func = this.getFunctionFromCache("unzip");
+    if (!completeCallback) {
+      const result: any = func(archivePath, destDir, options);
+      return result;
+    }
+    const jobId: any = func(
+      archivePath,
+      destDir,
+      options,
+      completeCallback,
+      errorCallback,
+    );
+    return { jobId } as OverloadedUnzipResult<T>;
+  }
+
+  zip<T extends ArchiveResultFunc = undefined>(
+    srcDir: string,
+    archivePath: string,
+    options?: ZipOptions,
+    completeCallback?: T,
+    errorCallback?: ArchiveErrorFunc,
+  ): OverloadedArchiveResult<T> {
+    const func = this.getFunctionFromCache("zip");
+    if (!completeCallback) {
+      const result: any = func(srcDir, archivePath, options);
+      return result;
+    }
+    const jobId: any = func(
+      srcDir,
+      archivePath,
+      options,
+      completeCallback,
+      errorCallback,
+    );
+    return { jobId } as OverloadedArchiveResult<T>;
+  }
+
+  tar<T extends ArchiveResultFunc = undefined>(
+    srcDir: string,
+    archivePath: string,
+    completeCallback?: T,
+    errorCallback?: ArchiveErrorFunc,
+  ): OverloadedArchiveResult<T> {
+    const func = this.getFunctionFromCache("tar");
+    if (!completeCallback) {
+      const result: any = func(srcDir, archivePath);
+      return result;
+    }
+    const jobId: any = func(srcDir, archivePath, completeCallback, errorCallback);
+    return { jobId } as OverloadedArchiveResult<T>;
+  }
+
+  deriveKey<T extends DeriveKeyResultFunc = undefined>(
+    secret: string | number[] | KeyHandle,
+    options: KdfOptions,
+    completeCallback?: T,
+    errorCallback?: DeriveKeyErrorFunc,
+  ): OverloadedDeriveKeyResult<T> {
+    const func = this.getFunctionFromCache("deriveKey");
+    if (!completeCallback) {
+      const result: any = func(secret, options);
+      return result;
+    }
+    const jobId: any = func(secret, options, completeCallback, errorCallback);
+    return { jobId } as OverloadedDeriveKeyResult<T>;
+  }
+
+  hash(filepath: string, algorithm: Algorithms, options?: HashOptions): string {
     const func = this.getFunctionFromCache("hash");
-    return func(filepath, algorithm);
+    return func(filepath, algorithm, options);
+  }
+
+  hmac(
+    filepath: string,
+    key: string | number[] | KeyHandle,
+    algorithm: Algorithms,
+  ): string {
+    const func = this.getFunctionFromCache("hmac");
+    return func(filepath, key, algorithm);
+  }
+
+  verifyHmac(
+    filepath: string,
+    key: string | number[] | KeyHandle,
+    algorithm: Algorithms,
+    expected: string | number[],
+    options?: VerifyHmacOptions,
+  ): boolean {
+    const func = this.getFunctionFromCache("verifyHmac");
+    return func(filepath, key, algorithm, expected, options);
+  }
+
+  hashData<T extends HashDataResultFunc = undefined>(
+    data: string | ArrayBuffer,
+    algorithm: Algorithms,
+    completeCallback?: T,
+    errorCallback?: DataErrorFunc,
+  ): OverloadedHashDataResult<T> {
+    const func = this.getFunctionFromCache("hashData");
+    if (!completeCallback) {
+      const result: any = func(data, algorithm);
+      return result;
+    }
+    const jobId: any = func(data, algorithm, completeCallback, errorCallback);
+    return { jobId } as OverloadedHashDataResult<T>;
+  }
+
+  encryptData<T extends EncryptDataResultFunc = undefined>(
+    data: string | ArrayBuffer,
+    options: DataEncryptionOptions,
+    completeCallback?: T,
+    errorCallback?: DataErrorFunc,
+  ): OverloadedEncryptDataResult<T> {
+    const func = this.getFunctionFromCache("encryptData");
+    if (!completeCallback) {
+      const result: any = func(data, options);
+      return result;
+    }
+    const jobId: any = func(data, options, completeCallback, errorCallback);
+    return { jobId } as OverloadedEncryptDataResult<T>;
+  }
+
+  decryptData<T extends DecryptDataResultFunc = undefined>(
+    data: ArrayBuffer,
+    options: DataDecryptionOptions,
+    completeCallback?: T,
+    errorCallback?: DataErrorFunc,
+  ): OverloadedDecryptDataResult<T> {
+    const func = this.getFunctionFromCache("decryptData");
+    if (!completeCallback) {
+      const result: any = func(data, options);
+      return result;
+    }
+    const jobId: any = func(data, options, completeCallback, errorCallback);
+    return { jobId } as OverloadedDecryptDataResult<T>;
+  }
+
+  chunkManifest<T extends ChunkManifestResultFunc = undefined>(
+    filepath: string,
+    options: ChunkManifestOptions,
+    completeCallback?: T,
+    errorCallback?: ChunkManifestErrorFunc,
+  ): OverloadedChunkManifestResult<T> {
+    const func = this.getFunctionFromCache("chunkManifest");
+    if (!completeCallback) {
+      const result: any = func(filepath, options);
+      return result;
+    }
+    const jobId: any = func(filepath, options, completeCallback, errorCallback);
+    return { jobId } as OverloadedChunkManifestResult<T>;
   }
 
   touch(
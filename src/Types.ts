@@ -19,6 +19,259 @@ export type ReadDirItem<S, T extends Date | number> = {
   isDirectory: S; // Is the file a directory?
 };
 
+export type StatManyResult = {
+  size: Float64Array; // Size in bytes, one entry per path
+  mtime: Float64Array; // The last modified date (unixtime, sec, with fraction)
+  mode: Uint32Array; // UNIX file mode
+  flags: Uint8Array; // Bit mask: 1 - exists, 2 - is a file, 4 - is a directory
+};
+
+export type WalkOptions = {
+  maxDepth?: number; // How deep to descend, 1 - direct children only (default: unlimited)
+  glob?: string; // Glob pattern, matched against the item name or, if it contains "/", against the path relative to dirpath
+  minSize?: number; // Minimum size in bytes
+  maxSize?: number; // Maximum size in bytes
+  modifiedAfter?: Date | number; // Only items modified after this date (Date or unixtime, sec)
+  type?: "all" | "file" | "directory"; // Item type to return (default: "all")
+  followSymlinks?: boolean; // Descend into symlinked directories (default: false)
+  batchSize?: number; // Number of items per batch callback (default: 256)
+};
+
+export type WalkItem = {
+  name: string; // The name of the item
+  path: string; // The absolute path to the item
+  size: number; // Size in bytes
+  mtime: number; // The last modified date of the item (unixtime, sec)
+  isFile: boolean; // Is the item just a file?
+  isDirectory: boolean; // Is the item a directory?
+};
+
+export type WalkBatchResult = {
+  jobId: number;
+  items: WalkItem[];
+};
+
+export type WalkResult = {
+  jobId: number;
+  count: number; // Total number of matched items
+};
+
+export type WalkError = {
+  jobId: number;
+  errorMessage: string;
+};
+
+export type OpenDirOptions = {
+  sort?: "name" | "mtime" | "size"; // Sort items natively before returning them (default: directory order)
+  order?: "asc" | "desc"; // Sort order (default: "asc")
+  limit?: number; // Return at most this many items, with sort only the best ones are kept in memory
+};
+
+export type DirCursor = {
+  next(count?: number): WalkItem[]; // Returns up to count items (default: 100), an empty array at the end
+  close(): void; // Closes the directory, it is also closed when the cursor is garbage collected
+};
+
+export type WatchEvent = "create" | "modify" | "delete" | "move" | "overflow";
+
+export type WatchOptions = {
+  recursive?: boolean; // Also watch all subdirectories (default: false)
+  events?: WatchEvent[]; // Events to report (default: all)
+  debounceMs?: number; // Deliver a batch once the directory has been quiet for this long (default: 100)
+};
+
+export type WatchChange = {
+  path: string; // The absolute path to the changed item
+  events: WatchEvent[]; // All events of the item since the previous batch, "overflow" means events were lost
+  isDirectory: boolean; // Is the item a directory?
+};
+
+export type WatchResult = {
+  watchId: number;
+  changes: WatchChange[];
+};
+
+export type WatchResultFunc = (res: WatchResult) => void;
+
+export type StatCacheOptions = {
+  enabled?: boolean; // Enable or disable (and drop) the cache (default: true)
+  maxEntries?: number; // Number of cached paths, least recently used are evicted first (default: 1024)
+  watchPaths?: string[]; // (Android only) Directories watched recursively to drop entries changed outside of RNFSTurbo
+};
+
+export type StatCacheStats = {
+  enabled: boolean;
+  hits: number;
+  misses: number;
+  size: number; // Number of cached paths
+  maxEntries: number;
+};
+
+export type DuOptions = {
+  mode?: "apparent" | "allocated"; // Sum of file sizes or space actually taken on disk (default: "allocated")
+  perChild?: boolean; // Also return the usage of every direct child of path (default: false)
+};
+
+export type DuResult = {
+  size: number; // Total size in bytes, hardlinked files are counted once
+  files: number; // Number of files
+  children?: { name: string; size: number }[]; // Usage of every direct child, only with perChild
+};
+
+export type AllocateOptions = {
+  keepSize?: boolean; // Reserve the space without changing the file size (default: false)
+};
+
+export type PrefetchOptions = {
+  offset?: number; // First byte to read ahead (default: 0)
+  length?: number; // Number of bytes to read ahead, 0 means up to the end of file (default: 0)
+};
+
+export type PipelineStage =
+  | {
+      type: "decrypt"; // AES decryption (requires encryption to be enabled)
+      passphrase: string | number[] | KeyHandle;
+      kdf?: KdfOptions; // Derive the key from passphrase instead of using it as is
+      iv?: string | number[];
+      mode?: "ecb" | "cbc" | "cfb";
+      padding?: "ansi_x9.23" | "iso/iec_7816-4" | "pkcs5/pkcs7" | "zero" | "no";
+    }
+  | { type: "gunzip" } // Decompress gzip or zlib data, concatenated gzip members included
+  | { type: "base64decode" } // Decode base64, whitespace is skipped
+  | { type: "hash"; algorithm: Algorithms }; // Hash the data passing through this point, it is not changed
+
+export type PipelineResult = {
+  bytesRead: number; // Bytes read from the source file
+  bytesWritten: number; // Bytes written to the destination file
+  digests: string[]; // Digests of the hash stages, in stage order
+};
+
+export type PipelineJobResult = PipelineResult & {
+  jobId: number;
+};
+
+export type PipelineError = {
+  jobId: number;
+  errorMessage: string;
+};
+
+export type UnzipOptions = {
+  filter?: string; // Glob pattern of the entries to extract, matched against the path inside the archive (default: all)
+  overwrite?: boolean; // Replace existing files, otherwise extraction fails on the first one (default: true)
+};
+
+export type UnzipResult = {
+  files: number; // Number of extracted files
+  size: number; // Total uncompressed size in bytes
+};
+
+export type UnzipJobResult = UnzipResult & {
+  jobId: number;
+};
+
+export type UnzipError = {
+  jobId: number;
+  errorMessage: string;
+};
+
+export type ZipOptions = {
+  level?: number; // Compression level from 0 (store) to 9 (default: 6)
+  storeExtensions?: string[]; // Extensions of already compressed files that are stored as is (default: common image, video, audio and archive formats)
+};
+
+export type ArchiveResult = {
+  files: number; // Number of archived files
+  size: number; // Size of the archive in bytes
+};
+
+export type ArchiveJobResult = ArchiveResult & {
+  jobId: number;
+};
+
+export type ArchiveError = {
+  jobId: number;
+  errorMessage: string;
+};
+
+export type KdfOptions = {
+  algorithm: "pbkdf2" | "hkdf"; // PBKDF2-HMAC-SHA256 for passwords, HKDF-SHA256 for keys that are already random
+  salt?: string | number[]; // Required for pbkdf2, optional for hkdf
+  iterations?: number; // pbkdf2 only, required
+  info?: string | number[]; // hkdf only, context the key is bound to (default: empty)
+  keyLength?: 16 | 24 | 32; // Length of the derived key in bytes (default: 32)
+};
+
+export type KeyHandle = {
+  readonly length: number; // Key length in bytes, the key itself stays native
+};
+
+export type DeriveKeyJobResult = {
+  jobId: number;
+  key: KeyHandle;
+};
+
+export type DeriveKeyError = {
+  jobId: number;
+  errorMessage: string;
+};
+
+export type HashOptions = {
+  offset?: number; // First byte to hash (default: 0)
+  length?: number; // Number of bytes to hash, 0 means up to the end of file (default: 0)
+};
+
+export type ChunkManifestOptions = {
+  chunkSize: number; // Bytes per chunk, the last chunk may be shorter
+  algorithm: Algorithms;
+};
+
+export type ChunkManifestResult = {
+  size: number; // File size in bytes
+  chunkSize: number;
+  digest: string; // Hex digest of the whole file
+  digests: ArrayBuffer; // Raw digests of the chunks back to back, digest.length / 2 bytes each
+};
+
+export type ChunkManifestJobResult = ChunkManifestResult & {
+  jobId: number;
+};
+
+export type ChunkManifestError = {
+  jobId: number;
+  errorMessage: string;
+};
+
+export type VerifyHmacOptions = {
+  size?: number; // Expected file size in bytes, a different size fails without reading the file
+};
+
+export type DataEncryptionOptions = {
+  passphrase: string | number[] | KeyHandle;
+  kdf?: KdfOptions; // Derive the key from passphrase instead of using it as is
+  iv?: string | number[];
+  mode?: "ecb" | "cbc" | "cfb";
+  padding?: "ansi_x9.23" | "iso/iec_7816-4" | "pkcs5/pkcs7" | "zero" | "no";
+};
+
+export type DataDecryptionOptions = DataEncryptionOptions & {
+  encoding?: "utf8" | "base64"; // Return the decrypted data as a string in this encoding instead of an ArrayBuffer
+};
+
+export type HashDataJobResult = {
+  jobId: number;
+  digest: string;
+};
+
+export type DataJobResult<T> = {
+  jobId: number;
+  data: T;
+};
+
+export type DataError = {
+  jobId: number;
+  errorMessage: string;
+};
+
 export type DownloadFileOptions = {
   fromUrl: string; // URL to download file from
   toFile: string; // Local filesystem path to save the file to
@@ -124,7 +377,8 @@ export type Algorithms =
   | "sha224"
   | "sha256"
   | "sha384"
-  | "sha512";
+  | "sha512"
+  | "blake3";
 
 export type DownloadResultFunc = ((res: DownloadResult) => void) | undefined;
 export type DownloadErrorFunc = ((res: DownloadError) => void) | undefined;
@@ -134,6 +388,39 @@ export type UploadErrorFunc = ((res: UploadError) => void) | undefined;
 
 export type ScanResultFunc = ((res: ScanResult) => void) | undefined;
 
+export type WalkBatchFunc = ((res: WalkBatchResult) => void) | undefined;
+export type WalkResultFunc = ((res: WalkResult) => void) | undefined;
+export type WalkErrorFunc = ((res: WalkError) => void) | undefined;
+
+export type PipelineResultFunc = ((res: PipelineJobResult) => void) | undefined;
+export type PipelineErrorFunc = ((res: PipelineError) => void) | undefined;
+
+export type UnzipResultFunc = ((res: UnzipJobResult) => void) | undefined;
+export type UnzipErrorFunc = ((res: UnzipError) => void) | undefined;
+
+export type ArchiveResultFunc = ((res: ArchiveJobResult) => void) | undefined;
+export type ArchiveErrorFunc = ((res: ArchiveError) => void) | undefined;
+export type DeriveKeyResultFunc =
+  | ((res: DeriveKeyJobResult) => void)
+  | undefined;
+export type DeriveKeyErrorFunc = ((res: DeriveKeyError) => void) | undefined;
+export type HashDataResultFunc =
+  | ((res: HashDataJobResult) => void)
+  | undefined;
+export type EncryptDataResultFunc =
+  | ((res: DataJobResult<ArrayBuffer>) => void)
+  | undefined;
+export type DecryptDataResultFunc =
+  | ((res: DataJobResult<ArrayBuffer | string>) => void)
+  | undefined;
+export type DataErrorFunc = ((res: DataError) => void) | undefined;
+export type ChunkManifestResultFunc =
+  | ((res: ChunkManifestJobResult) => void)
+  | undefined;
+export type ChunkManifestErrorFunc =
+  | ((res: ChunkManifestError) => void)
+  | undefined;
+
 export type OverloadedStatResult<S extends boolean | undefined> = S extends
   | false
   | undefined
@@ -171,6 +458,34 @@ export type OverloadedScanResult<T extends ScanResultFunc> = T extends undefined
   ? Promise<ScanResult>
   : { jobId: number };
 
+export type OverloadedWalkResult<T extends WalkBatchFunc> = T extends undefined
+  ? WalkItem[]
+  : { jobId: number };
+
+export type OverloadedPipelineResult<T extends PipelineResultFunc> =
+  T extends undefined ? PipelineResult : { jobId: number };
+
+export type OverloadedUnzipResult<T extends UnzipResultFunc> =
+  T extends undefined ? UnzipResult : { jobId: number };
+
+export type OverloadedArchiveResult<T extends ArchiveResultFunc> =
+  T extends undefined ? ArchiveResult : { jobId: number };
+
+export type OverloadedDeriveKeyResult<T extends DeriveKeyResultFunc> =
+  T extends undefined ? KeyHandle : { jobId: number };
+
+export type OverloadedHashDataResult<T extends HashDataResultFunc> =
+  T extends undefined ? string : { jobId: number };
+
+export type OverloadedEncryptDataResult<T extends EncryptDataResultFunc> =
+  T extends undefined ? ArrayBuffer : { jobId: number };
+
+export type OverloadedDecryptDataResult<T extends DecryptDataResultFunc> =
+  T extends undefined ? ArrayBuffer | string : { jobId: number };
+
+export type OverloadedChunkManifestResult<T extends ChunkManifestResultFunc> =
+  T extends undefined ? ChunkManifestResult : { jobId: number };
+
 export type EncodingType =
   | "utf8"
   | "base64"
@@ -180,6 +495,8 @@ export type EncodingType =
   | "float32"
   | "ascii";
 
+export type CompressionType = "gzip" | "deflate" | "lz4";
+
 export type IOSProtectionTypes =
   | "NSFileProtectionNone"
   | "NSFileProtectionComplete"
@@ -192,10 +509,13 @@ export type ReadOptions =
   | {
       encoding?: EncodingType;
       encrypted?: boolean;
-      passphrase?: string | number[];
+      passphrase?: string | number[] | KeyHandle; // A KeyHandle from deriveKey keeps the key out of JS
+      kdf?: KdfOptions; // Derive the key from passphrase instead of using it as is
       iv?: string | number[];
-      mode?: "ecb" | "cbc" | "cfb";
+      mode?: "ecb" | "cbc" | "cfb" | "chunked"; // chunked files can be read partially (read) and appended to
       padding?: "ansi_x9.23" | "iso/iec_7816-4" | "pkcs5/pkcs7" | "zero" | "no";
+      uncached?: boolean; // Drop the file from the page cache after reading (Android only)
+      compression?: CompressionType; // Decompress the file while reading (readFile, lz4 also read)
     }
   | undefined;
 
@@ -205,17 +525,28 @@ export type WriteOptions =
       encoding?: EncodingType;
       NSFileProtectionKey?: IOSProtectionTypes;
       encrypted?: boolean;
-      passphrase?: string | number[];
+      passphrase?: string | number[] | KeyHandle; // A KeyHandle from deriveKey keeps the key out of JS
+      kdf?: KdfOptions; // Derive the key from passphrase instead of using it as is
       iv?: string | number[];
-      mode?: "ecb" | "cbc" | "cfb";
+      mode?: "ecb" | "cbc" | "cfb" | "chunked"; // chunked files can be read partially (read) and appended to
       padding?: "ansi_x9.23" | "iso/iec_7816-4" | "pkcs5/pkcs7" | "zero" | "no";
+      mac?: boolean; // Authenticate every chunk with HMAC-SHA256 (chunked mode only, default true)
+      preallocate?: boolean; // Reserve disk space for the contents before writing, fails early when the disk is full
+      compression?: CompressionType; // Compress the contents while writing (writeFile and appendFile only)
     }
   | undefined;
 
+export type MoveCopyProgress = {
+  bytesCopied: number;
+  totalBytes: number;
+};
+
 export type MoveCopyOptions =
   | {
       NSFileProtectionKey?: IOSProtectionTypes;
       NSURLIsExcludedFromBackupKey?: boolean;
+      progress?: (res: MoveCopyProgress) => void; // Called while data is copied (copyFile, copyFolder, moveFile between filesystems)
+      uncached?: boolean; // Copy around the page cache, for large one-off copies (default: false)
     }
   | undefined;
 
@@ -306,7 +637,98 @@ export interface RNFSTurboInterface {
   exists(filepath: string): boolean;
   existsAssets(filepath: string): boolean;
   existsRes(filepath: string): boolean;
-  hash(filepath: string, algorithm: Algorithms): string;
+  statMany(filepaths: string[]): StatManyResult;
+  existsMany(filepaths: string[]): Uint8Array;
+  walk<T extends WalkBatchFunc = undefined>(
+    dirpath: string,
+    options?: WalkOptions,
+    batchCallback?: T,
+    completeCallback?: WalkResultFunc,
+    errorCallback?: WalkErrorFunc,
+  ): OverloadedWalkResult<T>;
+  openDir(dirpath: string, options?: OpenDirOptions): DirCursor;
+  watch(
+    dirpath: string,
+    options: WatchOptions | undefined,
+    callback: WatchResultFunc,
+  ): number;
+  unwatch(watchId: number): void;
+  configureStatCache(options: StatCacheOptions): void;
+  getStatCacheStats(): StatCacheStats;
+  du(path: string, options?: DuOptions): DuResult;
+  allocate(filepath: string, size: number, options?: AllocateOptions): void;
+  prefetch(filepaths: string[], options?: PrefetchOptions): void;
+  evict(filepath: string): void;
+  pipeline<T extends PipelineResultFunc = undefined>(
+    srcPath: string,
+    destPath: string,
+    stages: PipelineStage[],
+    completeCallback?: T,
+    errorCallback?: PipelineErrorFunc,
+  ): OverloadedPipelineResult<T>;
+  unzip<T extends UnzipResultFunc = undefined>(
+    archivePath: string,
+    destDir: string,
+    options?: UnzipOptions,
+    completeCallback?: T,
+    errorCallback?: UnzipErrorFunc,
+  ): OverloadedUnzipResult<T>;
+  zip<T extends ArchiveResultFunc = undefined>(
+    srcDir: string,
+    archivePath: string,
+    options?: ZipOptions,
+    completeCallback?: T,
+    errorCallback?: ArchiveErrorFunc,
+  ): OverloadedArchiveResult<T>;
+  tar<T extends ArchiveResultFunc = undefined>(
+    srcDir: string,
+    archivePath: string,
+    completeCallback?: T,
+    errorCallback?: ArchiveErrorFunc,
+  ): OverloadedArchiveResult<T>;
+  deriveKey<T extends DeriveKeyResultFunc = undefined>(
+    secret: string | number[] | KeyHandle,
+    options: KdfOptions,
+    completeCallback?: T,
+    errorCallback?: DeriveKeyErrorFunc,
+  ): OverloadedDeriveKeyResult<T>;
+  hash(filepath: string, algorithm: Algorithms, options?: HashOptions): string;
+  hmac(
+    filepath: string,
+    key: string | number[] | KeyHandle,
+    algorithm: Algorithms,
+  ): string;
+  verifyHmac(
+    filepath: string,
+    key: string | number[] | KeyHandle,
+    algorithm: Algorithms,
+    expected: string | number[],
+    options?: VerifyHmacOptions,
+  ): boolean;
+  hashData<T extends HashDataResultFunc = undefined>(
+    data: string | ArrayBuffer,
+    algorithm: Algorithms,
+    completeCallback?: T,
+    errorCallback?: DataErrorFunc,
+  ): OverloadedHashDataResult<T>;
+  encryptData<T extends EncryptDataResultFunc = undefined>(
+    data: string | ArrayBuffer,
+    options: DataEncryptionOptions,
+    completeCallback?: T,
+    errorCallback?: DataErrorFunc,
+  ): OverloadedEncryptDataResult<T>;
+  decryptData<T extends DecryptDataResultFunc = undefined>(
+    data: ArrayBuffer,
+    options: DataDecryptionOptions,
+    completeCallback?: T,
+    errorCallback?: DataErrorFunc,
+  ): OverloadedDecryptDataResult<T>;
+  chunkManifest<T extends ChunkManifestResultFunc = undefined>(
+    filepath: string,
+    options: ChunkManifestOptions,
+    completeCallback?: T,
+    errorCallback?: ChunkManifestErrorFunc,
+  ): OverloadedChunkManifestResult<T>;
   touch(filepath: string, mtime?: Date | number, ctime?: Date | number): number;
   mkdir(filepath: string, options?: MkdirOptions): void;
   downloadFile<T extends DownloadResultFunc | undefined = undefined>(
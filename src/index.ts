@@ -5,6 +5,52 @@ export type { Configuration } from "./NativeRNFSTurboModule";
 export type {
   StatResult,
   ReadDirItem,
+  StatManyResult,
+  WalkOptions,
+  WalkItem,
+  WalkBatchResult,
+  WalkResult,
+  WalkError,
+  OpenDirOptions,
+  DirCursor,
+  WatchEvent,
+  WatchOptions,
+  WatchChange,
+  WatchResult,
+  WatchResultFunc,
+  StatCacheOptions,
+  StatCacheStats,
+  DuOptions,
+  DuResult,
+  AllocateOptions,
+  PrefetchOptions,
+  PipelineStage,
+  PipelineResult,
+  PipelineJobResult,
+  PipelineError,
+  UnzipOptions,
+  UnzipResult,
+  UnzipJobResult,
+  UnzipError,
+  ZipOptions,
+  ArchiveResult,
+  ArchiveJobResult,
+  ArchiveError,
+  KdfOptions,
+  KeyHandle,
+  DeriveKeyJobResult,
+  DeriveKeyError,
+  HashOptions,
+  ChunkManifestOptions,
+  ChunkManifestResult,
+  ChunkManifestJobResult,
+  ChunkManifestError,
+  VerifyHmacOptions,
+  DataEncryptionOptions,
+  DataDecryptionOptions,
+  HashDataJobResult,
+  DataJobResult,
+  DataError,
   DownloadFileOptions,
   DownloadResult,
   DownloadError,
@@ -21,17 +67,45 @@ export type {
   ScanError,
   Algorithms,
   MkdirOptions,
+  MoveCopyProgress,
   DownloadResultFunc,
   DownloadErrorFunc,
   UploadResultFunc,
   UploadErrorFunc,
   ScanResultFunc,
+  WalkBatchFunc,
+  WalkResultFunc,
+  WalkErrorFunc,
+  PipelineResultFunc,
+  PipelineErrorFunc,
+  UnzipResultFunc,
+  UnzipErrorFunc,
+  ArchiveResultFunc,
+  ArchiveErrorFunc,
+  DeriveKeyResultFunc,
+  DeriveKeyErrorFunc,
+  HashDataResultFunc,
+  EncryptDataResultFunc,
+  DecryptDataResultFunc,
+  DataErrorFunc,
+  ChunkManifestResultFunc,
+  ChunkManifestErrorFunc,
   OverloadedStatResult,
   OverloadedReadDirItem,
   OverloadedReadResult,
   OverloadedDownloadResult,
   OverloadedUploadResult,
   OverloadedScanResult,
+  OverloadedWalkResult,
+  OverloadedPipelineResult,
+  OverloadedUnzipResult,
+  OverloadedArchiveResult,
+  OverloadedDeriveKeyResult,
+  OverloadedHashDataResult,
+  OverloadedEncryptDataResult,
+  OverloadedDecryptDataResult,
+  OverloadedChunkManifestResult,
   EncodingType,
+  CompressionType,
   RNFSTurboInterface,
 } from "./Types";